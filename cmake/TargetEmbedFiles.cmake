@@ -32,7 +32,11 @@ set(_output_files)
 foreach(_input_file ${_FILES})
 
     get_filename_component(_input_file "${_input_file}" ABSOLUTE)
-    if(NOT EXISTS "${_input_file}")
+
+    # Files generated at build-time (e.g. by add_custom_command) do not exist at configure time
+    get_source_file_property(_input_generated "${_input_file}" GENERATED)
+
+    if(NOT EXISTS "${_input_file}" AND NOT _input_generated)
         message(FATAL_ERROR "target_embed_files: Input file does not exist: ${_input_file}")
     endif()
 
@@ -68,6 +72,7 @@ foreach(_input_file ${_FILES})
 #define ${_include_guard}
 
 #include <array>
+#include <cstdint>
 
 namespace ${_NAMESPACE}
 {
@@ -89,6 +94,7 @@ constexpr std::array<uint8_t, \${_length}> ${_name} = {
     set(_embed_script "
 file(READ \"${_input_file}\" _data HEX)
 string(LENGTH \"\${_data}\" _length)
+math(EXPR _length \"\${_length} / 2\")
 string(REGEX REPLACE \"([0-9A-Fa-f][0-9A-Fa-f])\" \"0x\\\\1,\" _bytes \"\${_data}\")
 
 set(_template \"${_embed_template}\")
@@ -118,19 +124,22 @@ file(WRITE  \"${_output_file}\" \"\${_template}\")
 
     ###########################################################################
     # 2. Invoke the embed script at configuration time to generate the first 
-    # version of the header (so target_sources can see it)
+    # version of the header (so target_sources can see it). Headers of 
+    # generated input files are only created at build-time.
     ###########################################################################
 
-    execute_process(
-        COMMAND ${CMAKE_COMMAND}
-            -DINPUT="${_input_file}"
-            -DOUTPUT="${_output_file}"
-            -P "${_script_file}"
-        RESULT_VARIABLE _res
-    )
-
-    if(NOT _res EQUAL 0)
-        message(FATAL_ERROR "target_embed_files: Failed to generate header at configure time.")
+    if(NOT _input_generated)
+        execute_process(
+            COMMAND ${CMAKE_COMMAND}
+                -DINPUT="${_input_file}"
+                -DOUTPUT="${_output_file}"
+                -P "${_script_file}"
+            RESULT_VARIABLE _res
+        )
+
+        if(NOT _res EQUAL 0)
+            message(FATAL_ERROR "target_embed_files: Failed to generate header at configure time.")
+        endif()
     endif()
 
     ###########################################################################
@@ -11,7 +11,7 @@ set(SLANG_ENABLE_OPTIC OFF CACHE BOOL "" FORCE)
 set(SLANG_ENABLE_RELEASE_DEBUG_INFO OFF CACHE BOOL "" FORCE)
 set(SLANG_ENABLE_RELEASE_LTO OFF CACHE BOOL "" FORCE)
 set(SLANG_ENABLE_REPLAYER OFF CACHE BOOL "" FORCE)
-set(SLANG_ENABLE_SLANGC OFF CACHE BOOL "" FORCE)
+set(SLANG_ENABLE_SLANGC ON CACHE BOOL "" FORCE)
 set(SLANG_ENABLE_SLANGD OFF CACHE BOOL "" FORCE)
 set(SLANG_ENABLE_SLANGI OFF CACHE BOOL "" FORCE)
 set(SLANG_ENABLE_SLANGRT OFF CACHE BOOL "" FORCE)
@@ -0,0 +1,14 @@
+set(ZSTD_BUILD_PROGRAMS OFF CACHE BOOL "" FORCE)
+set(ZSTD_BUILD_TESTS OFF CACHE BOOL "" FORCE)
+set(ZSTD_BUILD_SHARED OFF CACHE BOOL "" FORCE)
+set(ZSTD_BUILD_STATIC ON CACHE BOOL "" FORCE)
+set(ZSTD_LEGACY_SUPPORT OFF CACHE BOOL "" FORCE)
+
+CPMAddPackage(
+  NAME zstd
+  GIT_TAG v1.5.6
+  GITHUB_REPOSITORY facebook/zstd
+  SOURCE_SUBDIR build/cmake
+)
+
+target_include_directories(libzstd_static INTERFACE ${zstd_SOURCE_DIR}/lib)
@@ -4,29 +4,41 @@
 #include <Coral/Context.h>
 
 /*!
- * Enum specifying the type of the buffer
+ * Bitmask specifying the allowed usages of the buffer
+ *
+ * The values can be combined to use a single buffer allocation for multiple purposes, e.g. to store interleaved vertex
+ * and index data in one buffer or to write vertex data in a shader and read it as vertex input afterwards.
  */
 typedef enum
 {
     /*!
      * The buffer is used as a vertex buffer
      */
-    CO_BUFFER_TYPE_VERTEX  = 0,
+    CO_BUFFER_TYPE_VERTEX  = 0x00000001,
 
     /*!
      * The buffer is used as an index buffer
      */
-    CO_BUFFER_TYPE_INDEX   = 1,
+    CO_BUFFER_TYPE_INDEX   = 0x00000002,
     /*!
      * The buffer is used as uniform buffer
      */
-    CO_BUFFER_TYPE_UNIFORM = 2,
+    CO_BUFFER_TYPE_UNIFORM = 0x00000004,
     /*!
      * The buffer is used as storage buffer
      */
-    CO_BUFFER_TYPE_STORAGE = 3,
+    CO_BUFFER_TYPE_STORAGE = 0x00000008,
+    /*!
+     * The buffer contains the parameters of indirect dispatch or draw commands
+     */
+    CO_BUFFER_TYPE_INDIRECT = 0x00000010,
 } CoBufferType;
 
+/*!
+ * Combination of \ref CoBufferType values
+ */
+typedef uint32_t CoBufferTypeFlags;
+
 /*!
  * Structure specifying the parameters of a newly created buffer object
  */
@@ -38,14 +50,21 @@ typedef struct
     uint64_t size;
 
     /*!
-     * The type of the buffer
+     * Bitmask of \ref CoBufferType values specifying the allowed usages of the buffer. Every buffer can be used as
+     * source and destination of transfer operations, regardless of the type.
      */
-    CoBufferType type;
+    CoBufferTypeFlags type;
 
     /*!
      * Flag indicating if the buffer's memory is mapped to CPU memory
      */
     bool cpuVisible;
+
+    /*!
+     * Flag indicating if the buffer's memory can be exported via \ref coBufferExportMemory to share it with other
+     * contexts or processes.
+     */
+    bool exportable;
 } CoBufferCreateConfig;
 
 struct CoBuffer_T;
@@ -62,12 +81,39 @@ typedef CoBuffer_T* CoBuffer;
  */
 CORAL_API CoResult coContextCreateBuffer(CoContext context, const CoBufferCreateConfig* pConfig, CoBuffer* pBuffer);
 
+/*!
+ * \brief Create a new buffer object that is backed by memory exported from another buffer
+ * 
+ * The buffer must be created with the same parameters as the buffer the memory was exported from. On success, the
+ * buffer takes ownership of the file descriptor in \p pHandle, otherwise the caller remains responsible for closing it.
+ * 
+ * \param context Handle to a CoContext object that creates the buffer object.
+ * \param pConfig Pointer to a CoBufferCreateConfig instance containing parameters affecting the buffer creation.
+ * \param pHandle Pointer to the CoExternalMemoryHandle returned by \ref coBufferExportMemory.
+ * \param[out] pBuffer Pointer to a CoBuffer handle in which the resulting buffer object is returned.
+ */
+CORAL_API CoResult coContextImportBuffer(CoContext context, 
+                                         const CoBufferCreateConfig* pConfig, 
+                                         const CoExternalMemoryHandle* pHandle,
+                                         CoBuffer* pBuffer);
+
 /*!
  * \brief Destroy the buffer object
  * \param buffer Handle to a CoBuffer object to destroy
  */
 CORAL_API void coDestroyBuffer(CoBuffer buffer);
 
+/*!
+ * \brief Export the buffer's memory 
+ * 
+ * Each call returns a new file descriptor which is owned by the caller. The buffer must have been created with the 
+ * \p exportable flag.
+ * 
+ * \param buffer Handle to a CoBuffer object
+ * \param[out] pHandle Pointer to a CoExternalMemoryHandle in which the exported memory handle is returned.
+ */
+CORAL_API CoResult coBufferExportMemory(CoBuffer buffer, CoExternalMemoryHandle* pHandle);
+
 /*!
  * \brief Get the size of the buffer*
  * \param buffer Handle to a CoBuffer object
@@ -78,9 +124,9 @@ CORAL_API uint64_t coBufferGetSize(const CoBuffer buffer);
 /*!
  * \brief Get the type of the buffer
  * \param buffer Handle to a CoBuffer object
- * \return Return the type of the buffer
+ * \return Return the bitmask of \ref CoBufferType values the buffer was created with
  */
-CORAL_API CoBufferType coBufferGetType(const CoBuffer buffer);
+CORAL_API CoBufferTypeFlags coBufferGetType(const CoBuffer buffer);
 
 /*!
  * \brief Map the buffer memory to CPU-accessible memory
@@ -2,9 +2,11 @@
 #define CORAL_COMMANDBUFFER_H
 
 #include <Coral/CommandQueue.h>
+#include <Coral/CompletionToken.h>
 #include <Coral/Image.h>
 #include <Coral/Buffer.h>
 #include <Coral/PipelineState.h>
+#include <Coral/Readback.h>
 #include <Coral/Sampler.h>
 
 #include <Coral/Framebuffer.h>
@@ -78,6 +80,27 @@ typedef enum
     COLOR_AND_DEPTH
 } CoBlitAttachment;
 
+/*!
+ * Reduction applied to each 2x2 texel quad when generating the mip chain of an image
+ */
+typedef enum
+{
+    /*!
+     * Average the texels (box filter)
+     */
+    CO_MIP_REDUCTION_AVERAGE = 0,
+
+    /*!
+     * Keep the per-channel minimum of the texels, e.g. for hierarchical depth buffers with reversed depth
+     */
+    CO_MIP_REDUCTION_MIN,
+
+    /*!
+     * Keep the per-channel maximum of the texels, e.g. for hierarchical depth buffers
+     */
+    CO_MIP_REDUCTION_MAX,
+} CoMipReduction;
+
 /*!
  * Structure containing the clear color of a Framebuffer attachment
  */
@@ -98,6 +121,12 @@ typedef struct
      */
     float color[4];
 
+    /*!
+     * The operation applied to the attachment at the end of the render pass. For resolved attachments, the store op
+     * applies to the multisampled contents. Use CO_STORE_OP_DONT_CARE to discard them after the resolve.
+     */
+    CoStoreOp storeOp;
+
 } CoClearColor;
 
 
@@ -107,8 +136,27 @@ typedef struct
     CoClearOp clearOp;
     float depth;
     uint8_t stencil;
+    /// The operation applied to the attachment at the end of the render pass. If the attachment is resolved, the store
+    /// op applies to the multisampled contents.
+    CoStoreOp storeOp;
 } CoClearDepthStencil;
 
+/*!
+ * Structure describing the resolve target of a multisampled color attachment
+ */
+typedef struct
+{
+    /// The index of the multisampled color attachment in the framebuffer
+    uint32_t attachment;
+
+    /*!
+     * The single-sampled image receiving the resolved attachment. The image must have the same format and extent as
+     * the attachment and a single mip level.
+     */
+    CoImage image;
+
+} CoResolveAttachment;
+
 /*!
  * Structure containing the render pass begin information
  */
@@ -135,6 +183,24 @@ typedef struct
      */
     CoClearDepthStencil* clearDepthStencil;
 
+    /*!
+     * Pointer to an array of \ref CoResolveAttachment structures. The multisampled color attachments are resolved
+     * into the given images at the end of the render pass. The multisampled contents are stored or discarded
+     * according to the store op of the attachment (see \ref CoClearColor::storeOp). Only valid if the framebuffer is
+     * multisampled.
+     */
+    const CoResolveAttachment* pResolveAttachments;
+
+    /*!
+     * The number of elements in \ref pResolveAttachments
+     */
+    uint32_t resolveAttachmentCount;
+
+    /*!
+     * Optional single-sampled image receiving the first sample of the multisampled depth-stencil attachment
+     */
+    CoImage depthResolveImage;
+
 } CoBeginRenderPassInfo;
 
 /*!
@@ -168,11 +234,85 @@ typedef struct
     size_t size;
 } CoCopyBufferInfo;
 
+/*!
+ * Subresource of an image addressed by a copy command
+ */
+typedef struct
+{
+    /// The mip level
+    uint32_t mipLevel;
+    /// The first array layer
+    uint32_t baseArrayLayer;
+    /// The number of array layers. Zero is treated as one.
+    uint32_t layerCount;
+} CoImageSubresource;
+
+/*!
+ * Region of a buffer to image copy
+ */
+typedef struct
+{
+    /// Byte offset of the region's first texel in the source buffer
+    uint64_t bufferOffset;
+    /// Row length of the source data in texels. If zero, the rows are tightly packed according to imageExtent.
+    uint32_t bufferRowLength;
+    /// Height of a layer of the source data in texels. If zero, the layers are tightly packed according to 
+    /// imageExtent.
+    uint32_t bufferImageHeight;
+    /// The destination subresource
+    CoImageSubresource imageSubresource;
+    /// Offset of the region within the destination subresource in texels
+    CoOffset3D imageOffset;
+    /// Size of the region in texels. A depth of zero is treated as one.
+    CoExtent3D imageExtent;
+} CoBufferImageCopyRegion;
+
+/*!
+ * Parameters for the coCommandBufferCopyBufferToImage command
+ */
 typedef struct 
 {
+    /// The buffer to copy from
     CoBuffer source;
+    /// The image to copy to
+    CoImage dest;
+    /// Pointer to a list of regions to copy. If null, the start of the buffer is copied into the entire first mip
+    /// level of the image.
+    const CoBufferImageCopyRegion* pRegions;
+    /// Number of regions in pRegions
+    uint32_t regionCount;
+} CoCopyBufferToImageInfo;
+
+/*!
+ * Region of an image to image copy
+ */
+typedef struct
+{
+    /// The source subresource
+    CoImageSubresource srcSubresource;
+    /// Offset of the region within the source subresource in texels
+    CoOffset3D srcOffset;
+    /// The destination subresource
+    CoImageSubresource dstSubresource;
+    /// Offset of the region within the destination subresource in texels
+    CoOffset3D dstOffset;
+    /// Size of the region in texels. A depth of zero is treated as one.
+    CoExtent3D extent;
+} CoImageCopyRegion;
 
+/*!
+ * Parameters for the coCommandBufferCopyImage command
+ */
+typedef struct
+{
+    /// The image to copy from
+    CoImage source;
+    /// The image to copy to. Both images must have compatible formats.
     CoImage dest;
+    /// Pointer to a list of regions to copy
+    const CoImageCopyRegion* pRegions;
+    /// Number of regions in pRegions
+    uint32_t regionCount;
 } CoCopyImageInfo;
 
 /*!
@@ -192,6 +332,59 @@ typedef struct
 
 } CoDrawIndexedInfo;
 
+/*!
+ * Parameters of an indexed draw read from an indirect buffer. The layout matches VkDrawIndexedIndirectCommand.
+ */
+typedef struct
+{
+    /// The number of vertices to draw
+    uint32_t indexCount;
+    /// The number of instances to draw
+    uint32_t instanceCount;
+    /// The base index within the index buffer
+    uint32_t firstIndex;
+    /// The value added to the vertex index before indexing into the vertex buffer
+    int32_t vertexOffset;
+    /// The instance ID of the first instance to draw
+    uint32_t firstInstance;
+} CoDrawIndexedIndirectCommand;
+
+/*!
+ * Parameters for the coCommandBufferDrawIndexedIndirect command
+ */
+typedef struct
+{
+    /// Buffer created with CO_BUFFER_TYPE_INDIRECT containing the CoDrawIndexedIndirectCommand structures
+    CoBuffer buffer;
+    /// The byte offset of the first draw in the buffer. Must be a multiple of 4.
+    uint64_t offset;
+    /// The number of draws. Draw counts greater than one require the multiDrawIndirect feature.
+    uint32_t drawCount;
+    /// The byte stride between consecutive draws. Must be a multiple of 4 and at least the size of
+    /// CoDrawIndexedIndirectCommand. Zero is treated as tightly packed draws.
+    uint32_t stride;
+} CoDrawIndexedIndirectInfo;
+
+/*!
+ * Parameters for the coCommandBufferDrawIndexedIndirectCount command
+ */
+typedef struct
+{
+    /// Buffer created with CO_BUFFER_TYPE_INDIRECT containing the CoDrawIndexedIndirectCommand structures
+    CoBuffer buffer;
+    /// The byte offset of the first draw in the buffer. Must be a multiple of 4.
+    uint64_t offset;
+    /// Buffer created with CO_BUFFER_TYPE_INDIRECT containing the draw count as uint32_t
+    CoBuffer countBuffer;
+    /// The byte offset of the draw count in the count buffer. Must be a multiple of 4.
+    uint64_t countOffset;
+    /// The maximum number of draws. The draw count read from the count buffer is clamped to this value.
+    uint32_t maxDrawCount;
+    /// The byte stride between consecutive draws. Must be a multiple of 4 and at least the size of
+    /// CoDrawIndexedIndirectCommand. Zero is treated as tightly packed draws.
+    uint32_t stride;
+} CoDrawIndexedIndirectCountInfo;
+
 
 typedef struct
 {
@@ -222,18 +415,185 @@ typedef struct
     /// The data to be put into the image
     const CoByte* pData;
 
+    /// Number of bytes in pData
     uint32_t dataCount;
+
+    /// The mip level to update
+    uint32_t mipLevel;
+
+    /// Horizontal pixel offset of the updated region within the mip level
+    uint32_t offsetX;
+
+    /// Vertical pixel offset of the updated region within the mip level
+    uint32_t offsetY;
+
+    /// Size of the updated region in pixels. If the width or height is zero, the remainder of the mip level is updated.
+    CoExtent extent;
+
+    /// Number of bytes between the starts of two consecutive rows in pData. If zero, the rows are tightly packed.
+    /// For block-compressed formats, a row is a row of blocks and the region must be aligned to whole blocks.
+    /**
+     * Only the region's pixels are copied, so updating a small region of row-padded source data (e.g. a tile of a 
+     * larger frame) does not require repacking the data beforehand.
+     */
+    uint32_t rowPitch;
+
+    /// Number of consecutive mip levels starting at mipLevel that are contained in pData. Zero is treated as one.
+    /**
+     * If greater than one, pData contains the complete, tightly packed mip levels stored one after another (e.g. an
+     * offline-generated mip chain). All levels are uploaded with a single copy command. The region parameters offsetX,
+     * offsetY, extent and rowPitch must be zero in this case.
+     */
+    uint32_t mipLevelCount;
+
+    /// The first array layer to update. For 3D images, the first depth slice to update.
+    uint32_t arrayLayer;
+
+    /// Number of consecutive array layers (or depth slices of 3D images) contained in pData. Zero is treated as one.
+    /**
+     * The layers are stored one after another with the same row layout, i.e. rows of all layers are separated by
+     * rowPitch. For mip chains, each level contains all of its layers before the next level starts. Mip chains of 3D
+     * images always contain all depth slices of each level; arrayLayer must be zero and layerCount zero or one in
+     * this case.
+     */
+    uint32_t layerCount;
 } CoUpdateImageDataInfo;
 
 
 CORAL_API CoResult coCommandBufferUpdateBufferData(CoCommandBuffer commandBuffer, const CoUpdateBufferDataInfo* info);
 
+/*!
+ * \brief Update the buffer data by copying directly from caller-owned host memory
+ *
+ * In contrast to \ref coCommandBufferUpdateBufferData, the data is not copied into a staging buffer during recording.
+ * Instead, the host memory containing \p pData is imported into the device and the GPU reads straight from it. This
+ * avoids the CPU copy for large uploads, e.g. from memory-mapped files or decoder output. The memory pointed to by
+ * \p pData must remain valid and unmodified until the returned completion token is completed.
+ *
+ * If the device does not support importing host memory or the import fails, the data is copied into a staging buffer
+ * immediately and the returned token is already completed.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param info Pointer to a CoUpdateBufferDataInfo instance describing the update.
+ * \param[out] pToken Pointer to a CoCompletionToken handle in which the token tracking the use of the host memory is
+ *                    returned. The token must be destroyed with \ref coDestroyCompletionToken.
+ */
+CORAL_API CoResult coCommandBufferUpdateBufferDataFromHostMemory(CoCommandBuffer commandBuffer,
+                                                                 const CoUpdateBufferDataInfo* info,
+                                                                 CoCompletionToken* pToken);
+
 CORAL_API CoResult coCommandBufferUpdateImageData(CoCommandBuffer commandBuffer, const CoUpdateImageDataInfo* info);
 
+/*!
+ * \brief Copy a range of the buffer into CPU-visible memory
+ * 
+ * The data is copied into a pooled, host-cached buffer. The returned readback becomes ready once the command buffer
+ * finished execution. Hence, the data must only be accessed after the command buffer was submitted and the readback 
+ * is ready, see \ref coReadbackIsReady and \ref coReadbackWait.
+ * 
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param source The buffer to read from
+ * \param offset Byte offset of the range to read from the start of the buffer
+ * \param size Number of bytes to read
+ * \param[out] pReadback Pointer to a CoReadback handle in which the readback object is returned. The readback must be
+ *                       destroyed with \ref coDestroyReadback.
+ */
+CORAL_API CoResult coCommandBufferReadbackBuffer(CoCommandBuffer commandBuffer, 
+                                                 CoBuffer source, 
+                                                 uint64_t offset, 
+                                                 uint64_t size, 
+                                                 CoReadback* pReadback);
+
+/*!
+ * Structure describing the image region to read back into CPU-visible memory
+ */
+typedef struct
+{
+    /// The image to read from
+    CoImage image;
+    /// The mip level to read from
+    uint32_t mipLevel;
+    /// Horizontal pixel offset of the region within the mip level
+    uint32_t offsetX;
+    /// Vertical pixel offset of the region within the mip level
+    uint32_t offsetY;
+    /// Size of the region in pixels. If the width or height is zero, the remainder of the mip level is read.
+    CoExtent extent;
+    /// The array layer to read from. For 3D images, the depth slice to read from.
+    uint32_t arrayLayer;
+} CoReadbackImageInfo;
+
+/*!
+ * \brief Copy a region of an image into CPU-visible memory
+ *
+ * The pixels are copied into a pooled, host-cached buffer and tightly packed row by row, i.e. the row pitch is 
+ * \ref coPixelFormatGetRegionSizeInBytes of one row of the region. For block-compressed formats, the region must be
+ * aligned to whole blocks. For depth/stencil formats only the depth aspect is read. A single array layer (or depth
+ * slice of a 3D image) is read. The image is transitioned back to its preferred layout after the copy. As with 
+ * \ref coCommandBufferReadbackBuffer, the data must only be accessed once the returned readback is ready.
+ *
+ * Together with framebuffers that render into regular images, this allows rendering without any window or surface 
+ * (see the README for headless usage).
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param info Pointer to a CoReadbackImageInfo instance describing the region to read
+ * \param[out] pReadback Pointer to a CoReadback handle in which the readback object is returned. The readback must be
+ *                       destroyed with \ref coDestroyReadback.
+ */
+CORAL_API CoResult coCommandBufferReadbackImage(CoCommandBuffer commandBuffer, 
+                                                const CoReadbackImageInfo* info,
+                                                CoReadback* pReadback);
+
+/*!
+ * \brief Copy regions of a buffer into an image
+ *
+ * All regions are recorded with a single copy command. The mip levels written by the copy are transitioned back to
+ * the image's preferred layout afterwards.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param pInfo Pointer to a CoCopyBufferToImageInfo instance describing the copy
+ */
+CORAL_API CoResult coCommandBufferCopyBufferToImage(CoCommandBuffer commandBuffer, const CoCopyBufferToImageInfo* pInfo);
+
+/*!
+ * \brief Copy regions of an image into another image
+ *
+ * All regions are recorded with a single copy command. Unlike \ref coCommandBufferBlitImage, the texels are copied 
+ * without scaling or format conversion. Source and destination may be the same image if the regions do not overlap.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param pInfo Pointer to a CoCopyImageInfo instance describing the copy
+ */
+CORAL_API CoResult coCommandBufferCopyImage(CoCommandBuffer commandBuffer, const CoCopyImageInfo* pInfo);
+
 CORAL_API CoResult coCommandBufferBlitImage(CoCommandBuffer commandBuffer, CoImage source, CoImage dest);
 
+/*!
+ * \brief Generate the mip levels of an image by averaging the first mip level
+ *
+ * Equivalent to \ref coCommandBufferGenerateMipMapsWithReduction with CO_MIP_REDUCTION_AVERAGE.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param image Handle to the image whose mip levels are generated
+ */
 CORAL_API CoResult coCommandBufferGenerateMipMaps(CoCommandBuffer commandBuffer, CoImage image);
 
+/*!
+ * \brief Generate the mip levels of an image from its first mip level
+ *
+ * If the image format supports storage access, all mip levels are generated by a single compute dispatch. Otherwise,
+ * the mip levels are downsampled one after another with blits, which only support CO_MIP_REDUCTION_AVERAGE. Mip
+ * generation fails for block-compressed images and for min/max reductions of images without storage support (e.g. 
+ * depth images, which must be copied into a R32_F image first).
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param image Handle to the image whose mip levels are generated
+ * \param reduction The reduction applied to each 2x2 texel quad
+ */
+CORAL_API CoResult coCommandBufferGenerateMipMapsWithReduction(CoCommandBuffer commandBuffer, 
+                                                               CoImage image, 
+                                                               CoMipReduction reduction);
+
 /// Bind the vertex buffer
 /**
  * \param buffer The buffer containing the vertex attribute data
@@ -258,12 +618,37 @@ CORAL_API CoResult coCommandBufferBindPipeline(CoCommandBuffer commandBuffer, Co
 ///
 CORAL_API CoResult coCommandBufferSetViewport(CoCommandBuffer commandBuffer, const CoViewportInfo* info);
 
-///
+/// Bind a uniform buffer at the given binding
+/**
+ * The buffer must have been created with CO_BUFFER_TYPE_UNIFORM. Draws and dispatches fail if the pipeline declares a
+ * storage buffer at the binding of a buffer without CO_BUFFER_TYPE_STORAGE.
+ */
 CORAL_API CoResult coCommandBufferBindUniformBuffer(CoCommandBuffer commandBuffer, CoBuffer buffer, uint32_t binding);
 
-///
+/// Bind a storage buffer at the given binding
+/**
+ * Storage buffers are not limited in size like uniform buffers and can be written by shaders. Writes are made visible
+ * to all subsequent commands outside the current render pass. The buffer must have been created with
+ * CO_BUFFER_TYPE_STORAGE.
+ */
+CORAL_API CoResult coCommandBufferBindStorageBuffer(CoCommandBuffer commandBuffer, CoBuffer buffer, uint32_t binding);
+
+/// Bind the image at the given binding
+/**
+ * Images created with CO_IMAGE_USAGE_HINT_STORAGE can be bound to storage image descriptors as well, which shaders can
+ * read and write. Writes are made visible to all subsequent commands outside the current render pass. Draws and
+ * dispatches fail if the pipeline declares a storage image at the binding of an image without this usage hint.
+ * Transient images cannot be bound.
+ */
 CORAL_API CoResult coCommandBufferBindImage(CoCommandBuffer commandBuffer, CoImage image, uint32_t binding);
 
+/// Bind a view of a range of mip levels and array layers of an image at the given binding
+/**
+ * Like images bound with coCommandBufferBindImage, the viewed mip levels are expected in the preferred layout of the
+ * image. Other mip levels of the same image can be used as framebuffer attachments at the same time.
+ */
+CORAL_API CoResult coCommandBufferBindImageView(CoCommandBuffer commandBuffer, CoImageView view, uint32_t binding);
+
 ///
 CORAL_API CoResult coCommandBufferBindSampler(CoCommandBuffer commandBuffer, CoSampler sampler, uint32_t binding);
 
@@ -275,6 +660,124 @@ CORAL_API CoResult coCommandBufferBindSampler(CoCommandBuffer commandBuffer, CoS
  */
 CORAL_API CoResult coCommandBufferDrawIndexed(CoCommandBuffer commandBuffer, const CoDrawIndexedInfo* info);
 
+/*!
+ * \brief Draw primitives with indexed vertices and parameters read from a buffer
+ *
+ * The draw parameters are read when the draw executes. Hence, a previous compute dispatch can cull objects and write
+ * their draws on the GPU. Writes of dispatches recorded before the render pass are visible to the draws.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param info Pointer to a CoDrawIndexedIndirectInfo instance describing the draws
+ * \return CO_FAILED if no graphics pipeline is bound, no render pass is active, the buffer parameters are invalid or
+ *         multiple draws are requested without multiDrawIndirect support
+ */
+CORAL_API CoResult coCommandBufferDrawIndexedIndirect(CoCommandBuffer commandBuffer,
+                                                      const CoDrawIndexedIndirectInfo* info);
+
+/*!
+ * \brief Draw primitives with indexed vertices, parameters and draw count read from buffers
+ *
+ * Like coCommandBufferDrawIndexedIndirect, but the number of draws is read from the count buffer when the draws
+ * execute, e.g. the number of objects that passed GPU culling. Requires the drawIndirectCount feature.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param info Pointer to a CoDrawIndexedIndirectCountInfo instance describing the draws
+ * \return CO_FAILED if no graphics pipeline is bound, no render pass is active, the buffer parameters are invalid or
+ *         the device does not support the drawIndirectCount feature
+ */
+CORAL_API CoResult coCommandBufferDrawIndexedIndirectCount(CoCommandBuffer commandBuffer,
+                                                           const CoDrawIndexedIndirectCountInfo* info);
+
+/*!
+ * \brief Dispatch compute work with the bound compute pipeline
+ *
+ * Dispatches must be recorded outside of render passes. Prior writes to the images and buffers used by the compute
+ * shader are made visible before the dispatch. Writes of the compute shader through storage descriptors are made
+ * visible to all subsequent commands, including following dispatches.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param groupCountX The number of local workgroups to dispatch in the X dimension
+ * \param groupCountY The number of local workgroups to dispatch in the Y dimension
+ * \param groupCountZ The number of local workgroups to dispatch in the Z dimension
+ * \return CO_FAILED if no compute pipeline is bound or a render pass is active
+ */
+CORAL_API CoResult coCommandBufferDispatch(CoCommandBuffer commandBuffer,
+                                           uint32_t groupCountX,
+                                           uint32_t groupCountY,
+                                           uint32_t groupCountZ);
+
+/*!
+ * \brief Dispatch compute work with the workgroup counts read from a buffer
+ *
+ * Like coCommandBufferDispatch, but the workgroup counts are read from three consecutive uint32_t values (X, Y, Z) in
+ * the buffer when the dispatch executes. This allows a previous dispatch to determine the amount of work on the GPU,
+ * e.g. the number of particles alive after a simulation step.
+ *
+ * \param commandBuffer Handle to the CoCommandBuffer object
+ * \param buffer Handle to a buffer created with CO_BUFFER_TYPE_INDIRECT
+ * \param offset The byte offset of the workgroup counts in the buffer. Must be a multiple of 4.
+ * \return CO_FAILED if no compute pipeline is bound, a render pass is active or the buffer parameters are invalid
+ */
+CORAL_API CoResult coCommandBufferDispatchIndirect(CoCommandBuffer commandBuffer, CoBuffer buffer, size_t offset);
+
+/*!
+ * Bitmask specifying pipeline stages
+ *
+ * Submissions wait for semaphores only with the specified stages. Commands of earlier stages start executing right
+ * away, which allows work of different queues to overlap, e.g. graphics work waiting for a compute queue submission
+ * only at the fragment shader stage.
+ */
+typedef enum
+{
+    /*!
+     * The stage reading the parameters of indirect commands
+     */
+    CO_PIPELINE_STAGE_DRAW_INDIRECT            = 0x00000001,
+    /*!
+     * The stage consuming vertex and index buffers
+     */
+    CO_PIPELINE_STAGE_VERTEX_INPUT             = 0x00000002,
+    /*!
+     * The vertex shader stage
+     */
+    CO_PIPELINE_STAGE_VERTEX_SHADER            = 0x00000004,
+    /*!
+     * The fragment shader stage
+     */
+    CO_PIPELINE_STAGE_FRAGMENT_SHADER          = 0x00000008,
+    /*!
+     * The stages of depth and stencil tests and depth attachment writes
+     */
+    CO_PIPELINE_STAGE_DEPTH_STENCIL_ATTACHMENT = 0x00000010,
+    /*!
+     * The stage of color attachment writes and resolves
+     */
+    CO_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT  = 0x00000020,
+    /*!
+     * The compute shader stage
+     */
+    CO_PIPELINE_STAGE_COMPUTE_SHADER           = 0x00000040,
+    /*!
+     * The stage of copy commands
+     */
+    CO_PIPELINE_STAGE_TRANSFER                 = 0x00000080,
+    /*!
+     * All stages of all commands
+     */
+    CO_PIPELINE_STAGE_ALL_COMMANDS             = 0x00000100,
+} CoPipelineStage;
+
+/*!
+ * Combination of \ref CoPipelineStage values
+ */
+typedef uint32_t CoPipelineStageFlags;
+
+/*!
+ * Token identifying uploads enqueued to the upload queue of the context (see \ref CoUploadQueue). The value 0 does not
+ * identify any upload.
+ */
+typedef uint64_t CoUploadToken;
+
 /*!
  * Structure containing the CommandBuffer submit information
  */
@@ -307,6 +810,16 @@ typedef struct
      */
     uint32_t waitSemaphoreCount;
 
+    /*!
+     * Optional pointer to an array of \ref CoPipelineStage bitmasks with \ref waitSemaphoreCount elements. Each
+     * bitmask specifies the stages of the submitted commands that wait for the corresponding semaphore. If nullptr,
+     * all commands wait for all semaphores.
+     *
+     * Writes of the commands executed before a semaphore is signaled are visible to the waiting stages, regardless of
+     * the queue the commands were submitted to. Images are handed over between queues in their preferred layout.
+     */
+    const CoPipelineStageFlags* pWaitStageMasks;
+
     /*!
      * Pointer to an array of \ref CoSemaphore objects to signal once execution of the command buffer has finished.
      */
@@ -317,6 +830,12 @@ typedef struct
      */
     uint32_t signalSemaphoreCount;
 
+    /*!
+     * Optional token of the upload queue. Execution of the command buffers waits until all uploads enqueued up to the
+     * token have finished. Uploads that were not submitted yet are submitted before the command buffers.
+     */
+    CoUploadToken waitUploadToken;
+
 } CoCommandBufferSubmitInfo;
 
 /*!
@@ -14,8 +14,28 @@ typedef CoCommandQueue_T* CoCommandQueue;
 
 CORAL_API CoResult coContextGetGraphicsQueue(const CoContext context, CoCommandQueue* pQueue);
 
+/*!
+ * \brief Get the queue for compute work
+ *
+ * If the device provides enough queues, the compute queue is separate from the graphics queue and compute work
+ * submitted to it (e.g. light culling or simulations) executes concurrently with graphics work. Otherwise, the graphics
+ * queue is returned. The compute queue supports the same commands as the graphics queue.
+ *
+ * Dependencies between submissions to different queues are expressed with semaphores (see
+ * \ref CoCommandBufferSubmitInfo::pWaitStageMasks). Resources need no explicit hand-off between the queues.
+ */
 CORAL_API CoResult coContextGetComputeQueue(const CoContext context, CoCommandQueue* pQueue);
 
+/*!
+ * \brief Get the queue for transfer work
+ *
+ * If the device provides a dedicated transfer queue family (the DMA engines of discrete GPUs), the transfer queue is
+ * created from it and uploads submitted to it execute without competing with rendering. Command buffers of such a
+ * queue only support copy, update and readback commands. Other commands fail with CO_FAILED.
+ *
+ * Images used on queues of different queue families are transferred between the families automatically when a
+ * command buffer using them is submitted. As for all queues, the submissions must be ordered with semaphores.
+ */
 CORAL_API CoResult coContextGetTransferQueue(const CoContext context, CoCommandQueue* pQueue);
 
 typedef struct
@@ -0,0 +1,46 @@
+#ifndef CORAL_COMPLETIONTOKEN_H
+#define CORAL_COMPLETIONTOKEN_H
+
+#include <Coral/Export.h>
+#include <Coral/Core.h>
+
+#include <cstdint>
+
+/*!
+ * A completion token tracks the GPU execution of a single command recorded into a command buffer. The token is 
+ * completed once the command buffer containing the command finished execution. It is also completed if the command was
+ * never executed, i.e. if the submission of the command buffer failed or the command buffer was destroyed or recorded
+ * again without being submitted. Waiting for such a token returns CO_FAILED. Tokens are returned by commands that keep
+ * accessing caller-owned memory after recording.
+ */
+struct CoCompletionToken_T;
+
+typedef CoCompletionToken_T* CoCompletionToken;
+
+/*!
+ * \brief Destroy the completion token
+ * 
+ * Destroying a token does not affect the execution of the tracked command.
+ * 
+ * \param token Handle to a CoCompletionToken object to destroy
+ */
+CORAL_API void coDestroyCompletionToken(CoCompletionToken token);
+
+/*!
+ * \brief Check if the tracked command has finished execution without blocking
+ * \param token Handle to a CoCompletionToken object
+ * \return Returns true if the token is completed, false otherwise. Tokens of commands that were never executed are
+ *         completed as well.
+ */
+CORAL_API bool coCompletionTokenIsComplete(CoCompletionToken token);
+
+/*!
+ * \brief Wait for the tracked command to finish execution
+ * \param token Handle to a CoCompletionToken object
+ * \param timeout The maximum time to wait for the token to complete in nanoseconds.
+ * \return Returns CO_SUCCESS if the token was completed within the specified timeout, CO_FAILED if the token was
+ *         completed without the command being executed or CO_ERROR_TIMEOUT if the timeout was reached before.
+ */
+CORAL_API CoResult coCompletionTokenWait(CoCompletionToken token, uint64_t timeout);
+
+#endif // !CORAL_COMPLETIONTOKEN_H
@@ -18,6 +18,10 @@ typedef struct
     // 
     CoGraphicsAPI graphicsAPI;
     const char* pApplicationName;
+    /// Create the context without window surface support, e.g. for rendering in CI or on render farms. Contexts are
+    /// also created headless if the platform does not provide the surface extensions. Headless contexts cannot 
+    /// create swapchains.
+    bool headless;
 } CoContextCreateConfig;
 
 
@@ -31,4 +35,23 @@ CORAL_API CoGraphicsAPI coContextGetGraphicsAPI(const CoContext context);
 
 CORAL_API void coDestroyContext(CoContext context);
 
+/*!
+ * Device-local memory usage and budget of a context
+ */
+typedef struct
+{
+    /// Number of bytes of device-local memory allocated by the context
+    uint64_t usage;
+    /// Estimated number of bytes of device-local memory the context can allocate without degrading performance. The
+    /// budget is shared with other processes and changes over time.
+    uint64_t budget;
+} CoMemoryBudget;
+
+/*!
+ * \brief Get the current device-local memory usage and budget of the context
+ * \param context Handle to a CoContext object
+ * \param[out] pBudget Pointer to a CoMemoryBudget instance in which the usage and budget are returned.
+ */
+CORAL_API CoResult coContextGetMemoryBudget(CoContext context, CoMemoryBudget* pBudget);
+
 #endif // !CORAL_CONTEXT_H
@@ -4,14 +4,19 @@
 #include <Coral/Buffer.h>
 #include <Coral/CommandBuffer.h>
 #include <Coral/CommandQueue.h>
+#include <Coral/CompletionToken.h>
 #include <Coral/Context.h>
 #include <Coral/Fence.h>
+#include <Coral/FrameCapture.h>
 #include <Coral/Framebuffer.h>
 #include <Coral/Image.h>
 #include <Coral/PipelineState.h>
+#include <Coral/Readback.h>
 #include <Coral/Sampler.h>
 #include <Coral/Semaphore.h>
 #include <Coral/ShaderModule.h>
+#include <Coral/StreamingScheduler.h>
 #include <Coral/Swapchain.h>
+#include <Coral/UploadQueue.h>
 
 #endif // !CORAL_CORAL_H
@@ -25,7 +25,11 @@ typedef enum
     // An internal error occurred
     CO_ERROR_INTERNAL,
     // A timeout occurred
-    CO_ERROR_TIMEOUT
+    CO_ERROR_TIMEOUT,
+    // The pixel format is not supported by the device for the requested usage
+    CO_ERROR_UNSUPPORTED_FORMAT,
+    // The operation requires a device feature that is not supported
+    CO_ERROR_UNSUPPORTED_FEATURE
 
 } CoResult;
 
@@ -44,6 +48,48 @@ typedef struct
     CoExtent extent;
 } CoRectangle;
 
+typedef struct
+{
+    int32_t x;
+    int32_t y;
+    int32_t z;
+} CoOffset3D;
+
+typedef struct
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t depth;
+} CoExtent3D;
+
+/*!
+ * Handle to device memory that is shared between Coral contexts or with other Vulkan processes on the same device
+ */
+typedef struct
+{
+    /*!
+     * Opaque POSIX file descriptor referring to the memory. The receiver of the handle takes ownership of the
+     * descriptor.
+     */
+    int fd;
+
+    /*!
+     * The size of the memory allocation in bytes
+     */
+    uint64_t size;
+
+    /*!
+     * UUID of the device that allocated the memory. Memory can only be imported on a device with matching UUID.
+     */
+    uint8_t deviceUUID[16];
+
+    /*!
+     * UUID of the driver that allocated the memory. Memory can only be imported with a driver with matching UUID.
+     */
+    uint8_t driverUUID[16];
+
+} CoExternalMemoryHandle;
+
 typedef enum
 {
     CO_PIXEL_FORMAT_R8_SRGB,
@@ -95,6 +141,29 @@ typedef enum
     CO_PIXEL_FORMAT_DEPTH24_STENCIL8,
     CO_PIXEL_FORMAT_DEPTH32_F,
 
+    // Block-compressed formats. Each block encodes 4x4 pixels (ASTC: the block size in the name).
+    // Compressed formats can only be used for sampled images, see coContextIsImageFormatSupported.
+    CO_PIXEL_FORMAT_BC1_RGBA_UNORM,
+    CO_PIXEL_FORMAT_BC1_RGBA_SRGB,
+    CO_PIXEL_FORMAT_BC3_UNORM,
+    CO_PIXEL_FORMAT_BC3_SRGB,
+    CO_PIXEL_FORMAT_BC4_UNORM,
+    CO_PIXEL_FORMAT_BC4_SNORM,
+    CO_PIXEL_FORMAT_BC5_UNORM,
+    CO_PIXEL_FORMAT_BC5_SNORM,
+    CO_PIXEL_FORMAT_BC7_UNORM,
+    CO_PIXEL_FORMAT_BC7_SRGB,
+
+    CO_PIXEL_FORMAT_ETC2_RGB8_UNORM,
+    CO_PIXEL_FORMAT_ETC2_RGB8_SRGB,
+    CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM,
+    CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB,
+
+    CO_PIXEL_FORMAT_ASTC_4x4_UNORM,
+    CO_PIXEL_FORMAT_ASTC_4x4_SRGB,
+    CO_PIXEL_FORMAT_ASTC_8x8_UNORM,
+    CO_PIXEL_FORMAT_ASTC_8x8_SRGB,
+
 } CoPixelFormat;
 
 
@@ -133,8 +202,26 @@ typedef enum
 
 
 /// Get the size in bytes of the pixel format
+/**
+ * For block-compressed formats, the size of one block is returned.
+ */
 uint32_t coPixelFormatGetSizeInBytes(CoPixelFormat format);
 
+/// Check if the pixel format is block-compressed
+bool coPixelFormatIsCompressed(CoPixelFormat format);
+
+/// Get the number of pixels encoded by one block of the pixel format
+/**
+ * Returns an extent of 1x1 for uncompressed formats.
+ */
+CoExtent coPixelFormatGetBlockExtent(CoPixelFormat format);
+
+/// Get the size in bytes of a tightly packed region of width x height pixels
+/**
+ * For block-compressed formats, the region is rounded up to whole blocks.
+ */
+uint64_t coPixelFormatGetRegionSizeInBytes(CoPixelFormat format, uint32_t width, uint32_t height);
+
 /// Get the size in bytes of the attribute format
 uint32_t coAttributeFormatGetSizeInBytes(CoAttributeFormat format);
 
@@ -154,4 +241,15 @@ typedef enum
     CO_CLEAR_OP_DONT_CARE = 2,
 } CoClearOp;
 
+/// Operation applied to the contents of a framebuffer attachment at the end of a render pass
+typedef enum
+{
+    /// Write the rendered contents to memory
+    CO_STORE_OP_STORE     = 0,
+    /// The contents are not needed after the render pass and may be discarded without writing them to memory
+    CO_STORE_OP_DONT_CARE = 1,
+    /// The contents are not written to memory, but previous contents are preserved if the attachment was not written
+    CO_STORE_OP_NONE      = 2,
+} CoStoreOp;
+
 #endif // !CORAL_TYPES_H
@@ -0,0 +1,146 @@
+#ifndef CORAL_FRAMECAPTURE_H
+#define CORAL_FRAMECAPTURE_H
+
+#include <Coral/Export.h>
+#include <Coral/CommandBuffer.h>
+#include <Coral/Core.h>
+#include <Coral/Framebuffer.h>
+#include <Coral/Image.h>
+
+#include <cstdint>
+
+/*!
+ * A frame capture continuously copies rendered frames into CPU memory, e.g. to feed a video encoder or a network
+ * stream. Each captured frame is read back into one of a fixed number of rotating readback buffers and handed to a
+ * consumer callback on a dedicated worker thread once the GPU finished the copy.
+ *
+ * The renderer never waits for the consumer: if all buffers of the ring are still in flight or being consumed when a
+ * new frame is recorded, the new frame is dropped. This bounds both the memory usage and the delay between rendering
+ * and consuming a frame.
+ */
+struct CoFrameCapture_T;
+
+typedef CoFrameCapture_T* CoFrameCapture;
+
+/*!
+ * A frame delivered to the consumer callback
+ */
+typedef struct
+{
+    /// Sequential index of the frame. Dropped frames leave gaps in the sequence.
+    uint64_t frameIndex;
+    /// Tightly packed pixels of the frame. The pointer is only valid for the duration of the callback.
+    const CoByte* pData;
+    /// Number of bytes in pData
+    uint64_t size;
+    /// Size of the frame in pixels
+    CoExtent extent;
+    /// Pixel format of the frame
+    CoPixelFormat format;
+    /// Time in nanoseconds between recording the capture and delivering the frame to the callback
+    uint64_t latency;
+} CoCapturedFrame;
+
+/*!
+ * Consumer callback invoked on the worker thread of the frame capture for every completed frame
+ */
+typedef void (*CoFrameCaptureCallback)(const CoCapturedFrame* pFrame, void* pUserData);
+
+/*!
+ * Structure specifying the parameters of a newly created frame capture
+ */
+typedef struct
+{
+    /// Number of frames that can be in flight between recording and consumption. Must be greater than zero.
+    uint32_t ringSize;
+    /// The callback consuming the captured frames
+    CoFrameCaptureCallback callback;
+    /// User-defined pointer passed to the callback
+    void* pUserData;
+} CoFrameCaptureCreateConfig;
+
+/*!
+ * Statistics of a frame capture
+ */
+typedef struct
+{
+    /// Number of frames passed to the frame capture, including dropped frames
+    uint64_t frameCount;
+    /// Number of frames delivered to the consumer callback
+    uint64_t deliveredFrameCount;
+    /// Number of frames dropped because the ring was full or the command buffer containing the capture was never
+    /// executed
+    uint64_t droppedFrameCount;
+    /// Latency of the most recently delivered frame in nanoseconds
+    uint64_t lastLatency;
+    /// Average latency of all delivered frames in nanoseconds
+    uint64_t averageLatency;
+    /// Maximum latency of all delivered frames in nanoseconds
+    uint64_t maxLatency;
+} CoFrameCaptureStatistics;
+
+/*!
+ * \brief Create a new frame capture
+ * \param pConfig Pointer to a CoFrameCaptureCreateConfig instance describing the frame capture
+ * \param[out] pFrameCapture Pointer to a CoFrameCapture handle in which the created frame capture is returned.
+ */
+CORAL_API CoResult coCreateFrameCapture(const CoFrameCaptureCreateConfig* pConfig, CoFrameCapture* pFrameCapture);
+
+/*!
+ * \brief Destroy the frame capture
+ *
+ * Frames that were not delivered yet are discarded. Use \ref coFrameCaptureFlush to deliver all pending frames
+ * first.
+ */
+CORAL_API void coDestroyFrameCapture(CoFrameCapture frameCapture);
+
+/*!
+ * \brief Record the capture of an image into the command buffer
+ *
+ * The image is read back once the command buffer is executed. If the ring is full, no command is recorded and the
+ * frame is counted as dropped. Frames whose command buffer is never executed (the submission failed or the command
+ * buffer was destroyed or recorded again without being submitted) are dropped as well.
+ *
+ * Frames are delivered in recording order. Hence, a frame recorded into a command buffer that is not submitted holds
+ * up the delivery of all later frames until the command buffer is destroyed or recorded again.
+ *
+ * \param frameCapture Handle to the CoFrameCapture object
+ * \param commandBuffer The command buffer to record the capture into
+ * \param image The image to capture
+ * \return Returns CO_SUCCESS if the frame was captured or dropped, CO_FAILED if recording the readback failed.
+ */
+CORAL_API CoResult coFrameCaptureRecordImage(CoFrameCapture frameCapture, CoCommandBuffer commandBuffer, CoImage image);
+
+/*!
+ * \brief Record the capture of a framebuffer color attachment into the command buffer
+ *
+ * This allows capturing swapchain frames via the framebuffer returned by \ref coSwapchainAcquireNextImage. The
+ * capture must be recorded after the render pass and before the swapchain image is presented. See
+ * \ref coFrameCaptureRecordImage for details.
+ *
+ * \param frameCapture Handle to the CoFrameCapture object
+ * \param commandBuffer The command buffer to record the capture into
+ * \param framebuffer The framebuffer to capture
+ * \param binding The binding index of the color attachment to capture
+ */
+CORAL_API CoResult coFrameCaptureRecordFramebuffer(CoFrameCapture frameCapture,
+                                                   CoCommandBuffer commandBuffer,
+                                                   CoFramebuffer framebuffer,
+                                                   uint32_t binding);
+
+/*!
+ * \brief Wait until all recorded frames have been delivered to the consumer callback
+ * \param frameCapture Handle to the CoFrameCapture object
+ * \param timeout The maximum time to wait in nanoseconds.
+ * \return Returns CO_SUCCESS if all frames were delivered within the timeout or CO_ERROR_TIMEOUT otherwise.
+ */
+CORAL_API CoResult coFrameCaptureFlush(CoFrameCapture frameCapture, uint64_t timeout);
+
+/*!
+ * \brief Get the statistics of the frame capture
+ * \param frameCapture Handle to the CoFrameCapture object
+ * \param[out] pStatistics Pointer to a CoFrameCaptureStatistics instance in which the statistics are returned.
+ */
+CORAL_API void coFrameCaptureGetStatistics(CoFrameCapture frameCapture, CoFrameCaptureStatistics* pStatistics);
+
+#endif // !CORAL_FRAMECAPTURE_H
@@ -23,9 +23,20 @@ typedef struct
     // Binding index of the color attachment
     uint32_t binding;
 
+    // Optional view of a single mip level and array layer to render into
+    /**
+     * If not null, the attachment renders into the view and image is ignored. Otherwise, the attachment renders into
+     * the first mip level of image.
+     */
+    CoImageView view;
+
 } CoColorAttachment;
 
 // Structure specifying the parameters of a newly created framebuffer object
+/**
+ * All attachments must have the same sample count. Multisampled attachments are usually resolved into single-sampled
+ * images at the end of the render pass (see CoBeginRenderPassInfo::pResolveAttachments).
+ */
 typedef struct  
 {
     // Pointer to a list of color attachments
@@ -40,6 +51,12 @@ typedef struct
      */
     CoImage depthAttachment;
 
+    // Optional view of a single mip level and array layer of a depth-stencil image
+    /**
+     * If not null, the depth-stencil attachment renders into the view and depthAttachment is ignored.
+     */
+    CoImageView depthAttachmentView;
+
 } CoFramebufferCreateConfig;
 
 
@@ -77,6 +94,12 @@ typedef struct
      */
     const CoDepthStencilAttachmentInfo* depthStencilAttachment;
 
+    // Number of samples per pixel of all attachments
+    /**
+     * Zero is treated as one. Pipelines are created with the sample count of the framebuffer layout.
+     */
+    uint32_t sampleCount;
+
 } CoFramebufferLayout;
 
 /// \brief Create a new framebuffer
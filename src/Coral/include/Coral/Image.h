@@ -10,10 +10,29 @@ typedef enum
     CO_IMAGE_USAGE_HINT_SHADER_READ_ONLY       = 0,
     // The image is primarily used as frame buffer attachment
     CO_IMAGE_USAGE_HINT_FRAMEBUFFER_ATTACHMENT = 1,
+    // The image is primarily read and written by shaders through storage image descriptors
+    CO_IMAGE_USAGE_HINT_STORAGE                = 2,
 
 } CoImageUsageHint;
 
 
+/// Dimensionality and layer arrangement of an image
+typedef enum
+{
+    /// A single two-dimensional image
+    CO_IMAGE_TYPE_2D         = 0,
+    /// An array of two-dimensional images of equal size, sampled with an array index
+    CO_IMAGE_TYPE_2D_ARRAY   = 1,
+    /// Six square two-dimensional faces in the order +X, -X, +Y, -Y, +Z, -Z, sampled with a direction vector
+    CO_IMAGE_TYPE_CUBE       = 2,
+    /// An array of cube maps. Each cube occupies six consecutive array layers.
+    CO_IMAGE_TYPE_CUBE_ARRAY = 3,
+    /// A three-dimensional image
+    CO_IMAGE_TYPE_3D         = 4,
+
+} CoImageType;
+
+
 /// Configuration to create an image
 typedef struct
 {
@@ -33,6 +52,51 @@ typedef struct
      * versa.
      */
     CoImageUsageHint usageHint;
+
+    /// Flag indicating if the image's memory can be exported via coImageExportMemory
+    /**
+     * Exported memory can be imported by other Coral contexts or Vulkan processes on the same device to share the 
+     * image content without copies.
+     *
+     * Exported and imported images are handed over between processes in the layout preferred by their usage hint
+     * (VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL for CO_IMAGE_USAGE_HINT_SHADER_READ_ONLY, the color or depth attachment
+     * optimal layout for CO_IMAGE_USAGE_HINT_FRAMEBUFFER_ATTACHMENT and VK_IMAGE_LAYOUT_GENERAL for
+     * CO_IMAGE_USAGE_HINT_STORAGE), owned by VK_QUEUE_FAMILY_EXTERNAL. Every command buffer using the image acquires
+     * the used mip levels from the external queue family before it starts and releases them back when it ends. Other
+     * Vulkan processes must acquire and release the image the same way, without changing the layout in the ownership
+     * transfer barriers. Access to the image must be synchronized with a shared semaphore (see coSemaphoreExportFd).
+     */
+    bool exportable;
+
+    /// The dimensionality and layer arrangement of the image
+    CoImageType type;
+
+    /// The depth of 3D images. Zero is treated as one. Must be zero or one for all other image types.
+    uint32_t depth;
+
+    /// The number of array layers
+    /**
+     * Zero is treated as one, or as six for cube maps. Must be one for 2D and 3D images, six for cube maps and a
+     * multiple of six for cube map arrays. Each face of a cube map is an array layer.
+     */
+    uint32_t arrayLayerCount;
+
+    /// The number of samples per texel. Zero is treated as one.
+    /**
+     * Must be a power of two that is supported for the format (see coContextGetMaxSampleCount). Multisampled images
+     * are always transient (see transient). Their content is typically resolved into a single-sampled image at the end
+     * of the render pass.
+     */
+    uint32_t sampleCount;
+
+    /// Flag indicating if the image is a transient framebuffer attachment
+    /**
+     * Transient images hold intermediate results that never leave a render pass, e.g. depth buffers or G-buffer
+     * targets that are not stored (see CoStoreOp). They must be 2D images without mip levels and cannot be exported,
+     * sampled or used in transfer commands. They are backed by lazily allocated memory if the device supports it, which
+     * tile-based GPUs never commit as long as the attachment is not stored.
+     */
+    bool transient;
 } CoImageCreateConfig;
 
 
@@ -40,18 +104,126 @@ struct CoImage_T;
 
 typedef CoImage_T* CoImage;
 
+struct CoImageView_T;
+
+/// View of a range of mip levels and array layers of an image
+typedef CoImageView_T* CoImageView;
+
 
 CORAL_API CoResult coContextCreateImage(CoContext context, const CoImageCreateConfig* pConfig, CoImage* pImage);
 
+/// Create a new image object backed by memory exported from another image
+/**
+ * The image must be created with the same parameters as the image the memory was exported from, including the usage
+ * hint, which determines the layout the image is handed over in (see CoImageCreateConfig::exportable). The imported
+ * image is expected to be released to VK_QUEUE_FAMILY_EXTERNAL in that layout, i.e. the exporting side must have
+ * submitted a command buffer using the image before the imported image is used. On success, the image takes ownership
+ * of the file descriptor in pHandle, otherwise the caller remains responsible for closing it.
+ */
+CORAL_API CoResult coContextImportImage(CoContext context, 
+                                        const CoImageCreateConfig* pConfig, 
+                                        const CoExternalMemoryHandle* pHandle,
+                                        CoImage* pImage);
+
+/// Request an image for an intermediate render target from the context's render target pool
+/**
+ * The pool hands out an image matching the configuration and creates one if no unused image exists. Destroying the
+ * image handle with coDestroyImage returns the image to the pool. It is reused once command buffers using it finished
+ * execution, provided they were created with retainReferences. Otherwise, the handle must only be destroyed after the
+ * execution finished. The memory of unused images may be reused for images with a different configuration.
+ *
+ * The content of the image is undefined. Render targets cannot be exportable.
+ */
+CORAL_API CoResult coContextRequestRenderTarget(CoContext context, const CoImageCreateConfig* pConfig, CoImage* pImage);
+
 CORAL_API void coDestroyImage(CoImage image);
 
+/*!
+ * \brief Check if the device supports images of the pixel format for the given usage
+ *
+ * Support for block-compressed formats depends on the device. Applications shipping compressed textures should query
+ * the supported formats once and pick the matching asset variant (e.g. BC on desktop, ETC2 or ASTC on mobile).
+ * Compressed formats never support CO_IMAGE_USAGE_HINT_FRAMEBUFFER_ATTACHMENT.
+ *
+ * \param context Handle to the CoContext object
+ * \param format The pixel format to check
+ * \param usageHint The intended usage of the image
+ * \return Returns true if images with the format can be created for the usage, false otherwise.
+ */
+CORAL_API bool coContextIsImageFormatSupported(CoContext context, CoPixelFormat format, CoImageUsageHint usageHint);
+
+/*!
+ * \brief Get the maximum number of samples per texel of multisampled images with the pixel format
+ * \param context Handle to the CoContext object
+ * \param format The pixel format of the framebuffer attachment
+ * \return The highest supported sample count, or one if the format does not support multisampling
+ */
+CORAL_API uint32_t coContextGetMaxSampleCount(CoContext context, CoPixelFormat format);
+
+/// Export the image's memory
+/**
+ * Each call returns a new file descriptor which is owned by the caller. The image must have been created with the
+ * exportable flag.
+ */
+CORAL_API CoResult coImageExportMemory(CoImage image, CoExternalMemoryHandle* pHandle);
+
 /// Get the width and height of the image
 CORAL_API void coImageGetExtent(const CoImage image, CoExtent* pExtent);
 
+/// Get the depth of the image. Returns one for all image types except 3D images.
+CORAL_API uint32_t coImageGetDepth(const CoImage image);
+
+/// Get the number of array layers of the image
+CORAL_API uint32_t coImageGetArrayLayerCount(const CoImage image);
+
+/// Get the type of the image
+CORAL_API CoImageType coImageGetType(const CoImage image);
+
 /// Get the pixel format of the Image
 CORAL_API CoPixelFormat coImageGetPixelFormat(const CoImage image);
 
 /// Get the number of mipmap levels
 CORAL_API uint32_t coImageGetMipLevelCount(const CoImage image);
 
+/// Get the number of samples per texel
+CORAL_API uint32_t coImageGetSampleCount(const CoImage image);
+
+/// Check if the image is a transient framebuffer attachment. Multisampled images are always transient.
+CORAL_API bool coImageIsTransient(const CoImage image);
+
+/*!
+ * \brief Create a view of a range of mip levels and array layers of the image
+ *
+ * Views bind individual mip levels or array layers as shader resource (see coCommandBufferBindImageView) or as
+ * framebuffer attachment, so that multi-pass algorithms like depth pyramid generation can work in place on a single
+ * image. The underlying views are cached by the image, hence creating the same view repeatedly is cheap. The view keeps
+ * the image alive.
+ *
+ * Views of a single array layer are 2D views. Views of six layers of a cube map or cube map array are cube views and
+ * views of a multiple of six layers of a cube map array are cube map array views. All other views of multiple layers
+ * are 2D array views. Views of 3D images are 3D views and must include the single array layer.
+ *
+ * \param image Handle to the CoImage object
+ * \param baseMipLevel The first mip level of the view
+ * \param mipLevelCount The number of mip levels of the view
+ * \param baseArrayLayer The first array layer of the view
+ * \param arrayLayerCount The number of array layers of the view
+ * \param format The format of the view. Must be the image format or, for 8-bit and block-compressed color formats,
+ *        its counterpart with the opposite color encoding (e.g. CO_PIXEL_FORMAT_RGBA8_UI for an
+ *        CO_PIXEL_FORMAT_RGBA8_SRGB image). Transient images can only be viewed with their own format.
+ * \param pView Pointer to the CoImageView handle receiving the view
+ * \return CO_ERROR_INVALID_SIZE if the range exceeds the image, CO_ERROR_UNSUPPORTED_FORMAT if the format is not
+ *         compatible with the image format
+ */
+CORAL_API CoResult coImageCreateView(CoImage image,
+                                     uint32_t baseMipLevel,
+                                     uint32_t mipLevelCount,
+                                     uint32_t baseArrayLayer,
+                                     uint32_t arrayLayerCount,
+                                     CoPixelFormat format,
+                                     CoImageView* pView);
+
+/// Destroy the image view handle. The underlying view stays cached until the image is destroyed.
+CORAL_API void coDestroyImageView(CoImageView view);
+
 #endif // !CORAL_IMAGE_HPP
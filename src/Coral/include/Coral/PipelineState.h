@@ -204,12 +204,45 @@ typedef struct
     CoTopology topology;
 } CoPipelineStateCreateConfig;
 
+/// Configuration to create a compute pipeline state object
+typedef struct
+{
+    /// The shader module of stage CO_SHADER_STAGE_COMPUTE
+    CoShaderModule computeShaderModule;
+
+} CoComputePipelineStateCreateConfig;
+
+
 struct CoPipelineState_T;
 
 typedef CoPipelineState_T* CoPipelineState;
 
+/*!
+ * \brief Create a graphics pipeline state object
+ *
+ * \param context Handle to the CoContext object
+ * \param pConfig Pointer to the configuration of the pipeline
+ * \param pPipelineState Pointer to the CoPipelineState handle receiving the pipeline
+ * \return CO_FAILED if a vertex or fragment shader writes storage buffers or storage images and the device does not
+ *         support shader stores in that stage (vertexPipelineStoresAndAtomics and fragmentStoresAndAtomics)
+ */
 CORAL_API CoResult coContextCreatePipelineState(CoContext context, const CoPipelineStateCreateConfig* pConfig, CoPipelineState* pPipelineState);
 
+/*!
+ * \brief Create a compute pipeline state object
+ *
+ * Compute pipelines are bound with coCommandBufferBindPipeline like graphics pipelines and run by dispatch commands
+ * outside of render passes. Binding a compute pipeline does not affect the bound graphics pipeline.
+ *
+ * \param context Handle to the CoContext object
+ * \param pConfig Pointer to the configuration of the pipeline
+ * \param pPipelineState Pointer to the CoPipelineState handle receiving the pipeline
+ * \return CO_FAILED if the shader module is not a compute shader
+ */
+CORAL_API CoResult coContextCreateComputePipelineState(CoContext context,
+                                                       const CoComputePipelineStateCreateConfig* pConfig,
+                                                       CoPipelineState* pPipelineState);
+
 CORAL_API void coDestroyPipelineState(CoPipelineState pipelineState);
 
 #endif // !CORAL_PIPELINESTATE_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef CORAL_READBACK_H
+#define CORAL_READBACK_H
+
+#include <Coral/Export.h>
+#include <Coral/Core.h>
+
+#include <cstdint>
+
+/*!
+ * A readback holds GPU data that was copied into CPU-visible memory by a readback command (e.g. 
+ * \ref coCommandBufferReadbackBuffer). The data becomes available once the command buffer containing the readback 
+ * command finished execution. Readbacks never stall the command queue: use \ref coReadbackIsReady to poll for the 
+ * result or \ref coReadbackWait to block until it is available.
+ */
+struct CoReadback_T;
+
+typedef CoReadback_T* CoReadback;
+
+/*!
+ * \brief Destroy the readback object and return its memory to the readback pool
+ * \param readback Handle to a CoReadback object to destroy
+ */
+CORAL_API void coDestroyReadback(CoReadback readback);
+
+/*!
+ * \brief Check without blocking if the readback data is available
+ * \param readback Handle to a CoReadback object
+ * \return Returns true if the data is available, false otherwise. Readbacks whose command was never executed never
+ *         become ready (see \ref coReadbackWait).
+ */
+CORAL_API bool coReadbackIsReady(CoReadback readback);
+
+/*!
+ * \brief Wait for the readback data to become available
+ * \param readback Handle to a CoReadback object
+ * \param timeout The maximum time to wait in nanoseconds.
+ * \return Returns CO_SUCCESS if the data became available within the specified timeout, CO_FAILED if the readback
+ *         command was never executed (i.e. the submission of the command buffer failed or the command buffer was
+ *         destroyed or recorded again without being submitted) or CO_ERROR_TIMEOUT if the timeout was reached before.
+ */
+CORAL_API CoResult coReadbackWait(CoReadback readback, uint64_t timeout);
+
+/*!
+ * \brief Get the readback data
+ * 
+ * The returned pointer remains valid until the readback object is destroyed.
+ * 
+ * \param readback Handle to a CoReadback object
+ * \param[out] ppData Pointer in which the address of the data is returned.
+ * \param[out] pSize Pointer in which the size of the data in bytes is returned.
+ * \return Returns CO_SUCCESS if the data is available, CO_FAILED if the readback is not ready yet or its command was
+ *         never executed.
+ */
+CORAL_API CoResult coReadbackGetData(CoReadback readback, const CoByte** ppData, uint64_t* pSize);
+
+#endif // !CORAL_READBACK_H
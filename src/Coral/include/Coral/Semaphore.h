@@ -6,7 +6,11 @@
 
 typedef struct
 {
-
+    /*!
+     * Flag indicating if the semaphore can be exported via \ref coSemaphoreExportFd to synchronize with other
+     * contexts or processes.
+     */
+    bool exportable;
 } CoSemaphoreCreateConfig;
 
 struct CoSemaphore_T;
@@ -15,6 +19,21 @@ typedef CoSemaphore_T* CoSemaphore;
 
 CORAL_API CoResult coContextCreateSemaphore(CoContext context, const CoSemaphoreCreateConfig* pConfig, CoSemaphore* pSemaphore);
 
+/*!
+ * \brief Create a semaphore object that shares its payload with a semaphore exported via \ref coSemaphoreExportFd
+ * 
+ * On success, the semaphore takes ownership of \p fd, otherwise the caller remains responsible for closing it.
+ */
+CORAL_API CoResult coContextImportSemaphore(CoContext context, int fd, CoSemaphore* pSemaphore);
+
 CORAL_API  void coDestroySemaphore(CoSemaphore Semaphore);
 
+/*!
+ * \brief Export the semaphore as opaque POSIX file descriptor
+ * 
+ * Each call returns a new file descriptor which is owned by the caller. The semaphore must have been created with the
+ * \p exportable flag.
+ */
+CORAL_API CoResult coSemaphoreExportFd(CoSemaphore semaphore, int* pFd);
+
 #endif // !CORAL_SEMAPHORE_H
@@ -7,6 +7,7 @@ typedef enum
 {
     CO_SHADER_STAGE_VERTEX   = 0,
     CO_SHADER_STAGE_FRAGMENT = 1,
+    CO_SHADER_STAGE_COMPUTE  = 2,
 } CoShaderStage;
 
 /// Configuration to create a shader module object
@@ -99,12 +100,32 @@ typedef struct
 } CoCombinedTextureSamplerDefinition;
 
 
+/// Defines a storage buffer descriptor
+typedef struct
+{
+    /// Flag indicating if the shader only reads from the buffer (declared `readonly`)
+    bool readOnly;
+
+} CoStorageBufferDefinition;
+
+
+/// Defines a storage image descriptor
+typedef struct
+{
+    /// Flag indicating if the shader only reads from the image (declared `readonly`)
+    bool readOnly;
+
+} CoStorageImageDefinition;
+
+
 typedef enum
 {
     CO_DESCRIPTOR_TYPE_UNIFORM_BUFFER           = 0,
     CO_DESCRIPTOR_TYPE_TEXTURE                  = 1,
     CO_DESCRIPTOR_TYPE_SAMPLER                  = 2,
     CO_DESCRIPTOR_TYPE_COMBINED_TEXTURE_SAMPLER = 3,
+    CO_DESCRIPTOR_TYPE_STORAGE_BUFFER           = 4,
+    CO_DESCRIPTOR_TYPE_STORAGE_IMAGE            = 5,
 } CoDescriptorType;
 
 
@@ -126,6 +147,8 @@ typedef struct
         CoTextureDefinition texture;
         CoSamplerDefinition sampler;
         CoCombinedTextureSamplerDefinition combinedTextureSampler;
+        CoStorageBufferDefinition storageBuffer;
+        CoStorageImageDefinition storageImage;
     };
 
 } CoDescriptorBindingInfo;
@@ -144,6 +167,13 @@ typedef struct
 
     uint32_t outputAttributeBindingInfoCount;
 
+    /// The local workgroup size of compute shaders
+    /**
+     * Zero for shaders of other stages and for compute shaders whose workgroup size is set by specialization constants.
+     * The number of workgroups to dispatch for a domain of N invocations is (N + size - 1) / size per dimension.
+     */
+    CoExtent3D workgroupSize;
+
 } CoShaderModuleLayout;
 
 
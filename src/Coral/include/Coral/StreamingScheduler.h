@@ -0,0 +1,211 @@
+#ifndef CORAL_STREAMINGSCHEDULER_H
+#define CORAL_STREAMINGSCHEDULER_H
+
+#include <Coral/Export.h>
+#include <Coral/Buffer.h>
+#include <Coral/CommandBuffer.h>
+#include <Coral/Context.h>
+#include <Coral/Core.h>
+#include <Coral/Image.h>
+
+#include <cstdint>
+
+/*!
+ * A streaming scheduler keeps textures and meshes resident in device memory based on their priority while limiting the
+ * number of bytes uploaded per frame.
+ *
+ * Resources are registered with their source data, which is not uploaded until the resource is requested. Each frame,
+ * the application requests the resources it is about to render with a priority (e.g. their screen-space size) and
+ * calls \ref coStreamingSchedulerUpdate, which enqueues uploads of the requested resources to the upload queue of the
+ * context (see \ref CoUploadQueue) in order of priority until the per-frame byte budget is exhausted.
+ *
+ * Images are streamed one mip level per upload, starting at the smallest mip level. First, the next level of every
+ * requested image is uploaded, then the next but one level and so on. Hence, all requested textures quickly become
+ * usable at a low resolution and sharpen while higher mip levels arrive. \ref coStreamingResourceGetImageView returns a
+ * view of the resident mip levels only, which clamps the sampled level of detail to the data already uploaded.
+ *
+ * If the memory budget is exceeded, the least recently requested resources are evicted. Evicted resources are
+ * streamed in again once they are requested.
+ */
+struct CoStreamingScheduler_T;
+
+typedef CoStreamingScheduler_T* CoStreamingScheduler;
+
+struct CoStreamingResource_T;
+
+/// Handle to a resource registered with a streaming scheduler
+typedef CoStreamingResource_T* CoStreamingResource;
+
+/*!
+ * Structure specifying the parameters of a newly created streaming scheduler
+ */
+typedef struct
+{
+    /// Maximum number of bytes uploaded per call of \ref coStreamingSchedulerUpdate. Single uploads exceeding the
+    /// limit are uploaded alone. Must be greater than zero.
+    uint64_t bytesPerFrame;
+
+    /// Maximum number of bytes of all resident resources of the scheduler. If zero, resources are evicted once the
+    /// device-local memory usage of the context exceeds its budget (see \ref coContextGetMemoryBudget).
+    uint64_t memoryBudget;
+
+    /// Number of frames a resource must not have been requested before it can be evicted. This must cover the frames
+    /// in flight, since command buffers that do not retain references might still use the resource.
+    uint32_t evictionDelay;
+} CoStreamingSchedulerCreateConfig;
+
+/*!
+ * Structure describing a streamed image
+ */
+typedef struct
+{
+    /// The configuration of the image created when the image is streamed in
+    CoImageCreateConfig imageConfig;
+
+    /// Pointer to an array of mipLevelCount pointers to the tightly packed data of each mip level, starting at the
+    /// first mip level. Each level contains all of its array layers (or depth slices of 3D images). The data must stay
+    /// valid until the resource is removed, since evicted images are uploaded again.
+    const CoByte* const* ppMipLevelData;
+
+    /// Pointer to an array of mipLevelCount sizes of the data of each mip level in bytes
+    const uint32_t* pMipLevelDataSizes;
+
+    /// Number of elements in ppMipLevelData and pMipLevelDataSizes. Must be the mip level count of the image.
+    uint32_t mipLevelCount;
+} CoStreamingImageInfo;
+
+/*!
+ * Structure describing a streamed buffer, e.g. the vertex or index data of a mesh
+ */
+typedef struct
+{
+    /// The configuration of the buffer created when the buffer is streamed in. The buffer must not be CPU visible.
+    CoBufferCreateConfig bufferConfig;
+
+    /// Pointer to the data of the buffer with bufferConfig.size bytes. The data must stay valid until the resource is
+    /// removed, since evicted buffers are uploaded again.
+    const CoByte* pData;
+} CoStreamingBufferInfo;
+
+/*!
+ * Statistics of a streaming scheduler
+ */
+typedef struct
+{
+    /// Number of bytes uploaded by the last update
+    uint64_t uploadedBytes;
+    /// Number of bytes of all resident resources (including uploads in flight)
+    uint64_t residentBytes;
+    /// Number of requested resources that are not completely resident
+    uint32_t pendingResourceCount;
+    /// Total number of evictions
+    uint64_t evictionCount;
+} CoStreamingSchedulerStatistics;
+
+/*!
+ * \brief Create a new streaming scheduler
+ * \param context Handle to the CoContext object whose upload queue is used
+ * \param pConfig Pointer to a CoStreamingSchedulerCreateConfig instance describing the scheduler
+ * \param[out] pScheduler Pointer to a CoStreamingScheduler handle in which the created scheduler is returned.
+ */
+CORAL_API CoResult coContextCreateStreamingScheduler(CoContext context,
+                                                     const CoStreamingSchedulerCreateConfig* pConfig,
+                                                     CoStreamingScheduler* pScheduler);
+
+/*!
+ * \brief Destroy the streaming scheduler
+ *
+ * Images and buffers of the scheduler that are still referenced by views or handles stay alive until they are
+ * destroyed.
+ */
+CORAL_API void coDestroyStreamingScheduler(CoStreamingScheduler scheduler);
+
+/*!
+ * \brief Register a streamed image
+ * \param scheduler Handle to the CoStreamingScheduler object
+ * \param pInfo Pointer to a CoStreamingImageInfo instance describing the image
+ * \param[out] pResource Pointer to a CoStreamingResource handle in which the resource is returned.
+ * \return CO_ERROR_INVALID_SIZE if the mip level count or a mip level data size does not match the image
+ */
+CORAL_API CoResult coStreamingSchedulerAddImage(CoStreamingScheduler scheduler,
+                                                const CoStreamingImageInfo* pInfo,
+                                                CoStreamingResource* pResource);
+
+/*!
+ * \brief Register a streamed buffer
+ * \param scheduler Handle to the CoStreamingScheduler object
+ * \param pInfo Pointer to a CoStreamingBufferInfo instance describing the buffer
+ * \param[out] pResource Pointer to a CoStreamingResource handle in which the resource is returned.
+ */
+CORAL_API CoResult coStreamingSchedulerAddBuffer(CoStreamingScheduler scheduler,
+                                                 const CoStreamingBufferInfo* pInfo,
+                                                 CoStreamingResource* pResource);
+
+/*!
+ * \brief Remove the resource from the scheduler and destroy the resource handle
+ */
+CORAL_API void coStreamingSchedulerRemove(CoStreamingScheduler scheduler, CoStreamingResource resource);
+
+/*!
+ * \brief Request the residency of the resource for the current frame
+ *
+ * Requesting a resource marks it as used, which protects it from eviction, and updates its priority. Resources
+ * requested repeatedly within a frame keep the highest priority.
+ *
+ * \param scheduler Handle to the CoStreamingScheduler object
+ * \param resource The requested resource
+ * \param priority The priority of the resource. Resources of higher priority are uploaded first.
+ */
+CORAL_API void coStreamingSchedulerRequest(CoStreamingScheduler scheduler,
+                                           CoStreamingResource resource,
+                                           float priority);
+
+/*!
+ * \brief Enqueue the uploads of the current frame and start a new frame
+ *
+ * Must be called once per frame. The uploads are enqueued to the upload queue of the context and submitted right away.
+ * Resources are evicted before uploading if the memory budget is exceeded.
+ *
+ * \param scheduler Handle to the CoStreamingScheduler object
+ * \param[out] pToken Optional pointer in which the upload token of the enqueued uploads is returned. The token is 0 if
+ *                    nothing was uploaded.
+ */
+CORAL_API CoResult coStreamingSchedulerUpdate(CoStreamingScheduler scheduler, CoUploadToken* pToken);
+
+/*!
+ * \brief Get the statistics of the streaming scheduler
+ */
+CORAL_API void coStreamingSchedulerGetStatistics(CoStreamingScheduler scheduler,
+                                                 CoStreamingSchedulerStatistics* pStatistics);
+
+/*!
+ * \brief Get the first mip level of a streamed image whose upload finished
+ *
+ * All higher levels finished uploading as well. Returns the mip level count of the image if no level is resident and
+ * 0 for resident buffers.
+ */
+CORAL_API uint32_t coStreamingResourceGetResidentMipLevel(CoStreamingResource resource);
+
+/*!
+ * \brief Get a view of the resident mip levels of a streamed image
+ *
+ * The view covers all array layers of the image. Since the view must not be used once the image was evicted, the
+ * view should be requested again every frame.
+ *
+ * \param resource The streamed image resource
+ * \param[out] pView Pointer to a CoImageView handle receiving the view. The view must be destroyed with
+ *                   \ref coDestroyImageView.
+ * \return CO_FAILED if no mip level of the image is resident
+ */
+CORAL_API CoResult coStreamingResourceGetImageView(CoStreamingResource resource, CoImageView* pView);
+
+/*!
+ * \brief Get a streamed buffer
+ * \param resource The streamed buffer resource
+ * \param[out] pBuffer Pointer to a CoBuffer handle receiving the buffer. The handle must be destroyed with
+ *                     \ref coDestroyBuffer.
+ * \return CO_FAILED if the upload of the buffer did not finish yet
+ */
+CORAL_API CoResult coStreamingResourceGetBuffer(CoStreamingResource resource, CoBuffer* pBuffer);
+
+#endif // !CORAL_STREAMINGSCHEDULER_H
@@ -0,0 +1,105 @@
+#ifndef CORAL_UPLOADQUEUE_H
+#define CORAL_UPLOADQUEUE_H
+
+#include <Coral/CommandBuffer.h>
+#include <Coral/Context.h>
+
+#include <cstdint>
+
+/*!
+ * The upload queue copies data into buffers and images independently of the command buffers recorded by the caller.
+ *
+ * Uploads can be enqueued from any thread. The data is copied into staging memory right away, the copies into the
+ * destination resources are batched and submitted to the transfer queue. Each upload returns a \ref CoUploadToken
+ * identifying its batch. Command buffer submissions wait for the uploads by passing the token as
+ * \ref CoCommandBufferSubmitInfo::waitUploadToken, which also submits the batch if it was not submitted yet.
+ *
+ * Hence, asset streaming does not serialize with the rendering work recorded into the same command buffer and uploads
+ * of multiple threads share a single submission.
+ */
+struct CoUploadQueue_T;
+
+typedef CoUploadQueue_T* CoUploadQueue;
+
+/*!
+ * \brief Get the upload queue of the context
+ * \param context Handle to a CoContext object
+ * \param[out] pQueue Pointer to a CoUploadQueue handle in which the upload queue is returned. The upload queue is owned
+ *                    by the context.
+ */
+CORAL_API CoResult coContextGetUploadQueue(CoContext context, CoUploadQueue* pQueue);
+
+/*!
+ * \brief Enqueue an update of the buffer data
+ *
+ * The parameters are the same as for \ref coCommandBufferUpdateBufferData. The buffer is kept alive until the upload
+ * finished.
+ *
+ * \param queue Handle to the CoUploadQueue object
+ * \param pInfo Pointer to a CoUpdateBufferDataInfo instance describing the update.
+ * \param[out] pToken Pointer in which the token of the upload is returned.
+ * \return CO_FAILED if the update parameters are invalid
+ */
+CORAL_API CoResult coUploadQueueUpdateBufferData(CoUploadQueue queue,
+                                                 const CoUpdateBufferDataInfo* pInfo,
+                                                 CoUploadToken* pToken);
+
+/*!
+ * \brief Enqueue an update of the image data
+ *
+ * The parameters are the same as for \ref coCommandBufferUpdateImageData. The image is kept alive until the upload
+ * finished.
+ *
+ * \param queue Handle to the CoUploadQueue object
+ * \param pInfo Pointer to a CoUpdateImageDataInfo instance describing the update.
+ * \param[out] pToken Pointer in which the token of the upload is returned.
+ * \return CO_FAILED if the update parameters are invalid
+ */
+CORAL_API CoResult coUploadQueueUpdateImageData(CoUploadQueue queue,
+                                                const CoUpdateImageDataInfo* pInfo,
+                                                CoUploadToken* pToken);
+
+/*!
+ * \brief Submit all enqueued uploads
+ *
+ * Batches are submitted automatically when a submission waits for them or the staged data of the batch exceeds an
+ * internal limit. Flushing explicitly starts uploads early, e.g. at the end of a loading step.
+ *
+ * \param queue Handle to the CoUploadQueue object
+ */
+CORAL_API CoResult coUploadQueueFlush(CoUploadQueue queue);
+
+/*!
+ * \brief Check without blocking if the upload identified by the token has finished
+ * \param queue Handle to the CoUploadQueue object
+ * \param token The token returned when the upload was enqueued
+ * \return Returns true if the upload finished, false otherwise. Uploads whose batch failed to be submitted never
+ *         finish (see \ref coUploadQueueIsFailed).
+ */
+CORAL_API bool coUploadQueueIsComplete(CoUploadQueue queue, CoUploadToken token);
+
+/*!
+ * \brief Check without blocking if the batch of the upload identified by the token failed to be submitted
+ *
+ * The destination resources of failed uploads keep their previous content. The uploads must be enqueued again.
+ *
+ * \param queue Handle to the CoUploadQueue object
+ * \param token The token returned when the upload was enqueued
+ * \return Returns true if the upload was never executed, false otherwise.
+ */
+CORAL_API bool coUploadQueueIsFailed(CoUploadQueue queue, CoUploadToken token);
+
+/*!
+ * \brief Wait for the upload identified by the token to finish
+ *
+ * The batch containing the upload is submitted if it was not submitted yet.
+ *
+ * \param queue Handle to the CoUploadQueue object
+ * \param token The token returned when the upload was enqueued
+ * \param timeout The maximum time to wait in nanoseconds.
+ * \return Returns CO_SUCCESS if the upload finished within the specified timeout, CO_FAILED if the batch containing the
+ *         upload failed to be submitted or CO_ERROR_TIMEOUT if the timeout was reached before.
+ */
+CORAL_API CoResult coUploadQueueWait(CoUploadQueue queue, CoUploadToken token, uint64_t timeout);
+
+#endif // !CORAL_UPLOADQUEUE_H
@@ -22,6 +22,24 @@ coContextCreateBuffer(CoContext context, const CoBufferCreateConfig* pConfig, Co
 }
 
 
+CoResult
+coContextImportBuffer(CoContext context, 
+                      const CoBufferCreateConfig* pConfig, 
+                      const CoExternalMemoryHandle* pHandle, 
+                      CoBuffer* pBuffer)
+{
+    if (auto impl = context->impl->importBuffer(*pConfig, *pHandle))
+    {
+        *pBuffer = new CoBuffer_T{ impl.value() };
+        return CO_SUCCESS;
+    }
+    else
+    {
+        return static_cast<CoResult>(impl.error());
+    }
+}
+
+
 void
 coDestroyBuffer(CoBuffer buffer)
 {
@@ -29,6 +47,18 @@ coDestroyBuffer(CoBuffer buffer)
 }
 
 
+CoResult
+coBufferExportMemory(CoBuffer buffer, CoExternalMemoryHandle* pHandle)
+{
+    if (auto handle = buffer->impl->exportMemory())
+    {
+        *pHandle = *handle;
+        return CO_SUCCESS;
+    }
+    return CO_FAILED;
+}
+
+
 uint64_t
 coBufferGetSize(const CoBuffer buffer)
 {
@@ -36,7 +66,7 @@ coBufferGetSize(const CoBuffer buffer)
 }
 
 
-CoBufferType
+CoBufferTypeFlags
 coBufferGetType(const CoBuffer buffer)
 {
     return buffer->impl->type();
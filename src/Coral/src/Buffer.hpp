@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 
 namespace Coral
 {
@@ -33,9 +34,9 @@ public:
     virtual size_t size() const = 0;
 
     /*! 
-     * \brief Get the type of the buffer
+     * \brief Get the bitmask of \ref CoBufferType values the buffer was created with
      */ 
-    virtual CoBufferType type() const = 0;
+    virtual CoBufferTypeFlags type() const = 0;
 
     /*! 
      * \brief Map the buffer memory to CPU-accessible memory. 
@@ -57,6 +58,13 @@ public:
      */
     virtual bool unmap() = 0;
 
+    /*!
+     * \brief Export the buffer memory as external memory handle
+     * 
+     * \return The memory handle, or an empty optional if the buffer is not exportable or the export failed.
+     */
+    virtual std::optional<CoExternalMemoryHandle> exportMemory() = 0;
+
 }; // class Buffer
 
 } // namespace Coral
@@ -6,10 +6,10 @@
 using namespace Coral;
 
 
-BufferPool::BufferPool(Context& context, CoBufferType bufferType, bool cpuVisible)
+BufferPool::BufferPool(Context& context, CoBufferTypeFlags bufferType, bool cpuVisible)
     : mContext(context)
     , mBufferType(bufferType)
-    , mCpuVisible(mCpuVisible)
+    , mCpuVisible(cpuVisible)
 {
 }
 
@@ -26,6 +26,7 @@ BufferPool::requestBuffer(size_t bufferSize)
         if (iter->first >= bufferSize && iter->second.use_count() == 1)
         {
             buffer = iter;
+            break;
         }
     }
 
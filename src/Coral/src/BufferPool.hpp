@@ -20,7 +20,7 @@ class BufferPool
 {
 public:
 
-    BufferPool(Coral::Context& context, CoBufferType bufferType, bool cpuVisible);
+    BufferPool(Coral::Context& context, CoBufferTypeFlags bufferType, bool cpuVisible);
 
     /*!
      * \brief Request a buffer from the pool
@@ -40,7 +40,7 @@ private:
 
     std::mutex mBufferPoolProtection;
 
-    CoBufferType mBufferType{ CO_BUFFER_TYPE_STORAGE };
+    CoBufferTypeFlags mBufferType{ CO_BUFFER_TYPE_STORAGE };
 
     bool mCpuVisible{ false };
 
@@ -1,9 +1,11 @@
 #include "Buffer.hpp"
 #include "CommandBuffer.hpp"
 #include "CommandQueue.hpp"
+#include "CompletionToken.hpp"
 #include "Fence.hpp"
 #include "Image.hpp"
 #include "PipelineState.hpp"
+#include "Readback.hpp"
 #include "Sampler.hpp"
 #include "Semaphore.hpp"
 
@@ -57,7 +59,8 @@ coCommandBufferBeginRenderPass(CoCommandBuffer commandBuffer, const CoBeginRende
         ClearColor clearColor
         {
             attachment.clearOp,
-            { attachment.color[0], attachment.color[1], attachment.color[2], attachment.color[3] }
+            { attachment.color[0], attachment.color[1], attachment.color[2], attachment.color[3] },
+            attachment.storeOp
         };
         
         if (!info.clearColor.emplace(attachment.attachment, clearColor).second)
@@ -69,6 +72,17 @@ coCommandBufferBeginRenderPass(CoCommandBuffer commandBuffer, const CoBeginRende
     {
         info.clearDepth = *beginInfo->clearDepthStencil;
     }
+    for (const auto& resolve : std::span(beginInfo->pResolveAttachments, beginInfo->resolveAttachmentCount))
+    {
+        if (!resolve.image || !info.resolveImages.emplace(resolve.attachment, resolve.image->impl).second)
+        {
+            return CO_FAILED;
+        }
+    }
+    if (beginInfo->depthResolveImage)
+    {
+        info.depthResolveImage = beginInfo->depthResolveImage->impl;
+    }
     return commandBuffer->impl->cmdBeginRenderPass(info) ? CO_SUCCESS : CO_FAILED;
 }
 
@@ -91,27 +105,142 @@ coCommandBufferUpdateBufferData(CoCommandBuffer commandBuffer, const CoUpdateBuf
 }
 
 
+CoResult 
+coCommandBufferUpdateBufferDataFromHostMemory(CoCommandBuffer commandBuffer, 
+                                              const CoUpdateBufferDataInfo* updateInfo, 
+                                              CoCompletionToken* pToken)
+{
+    Coral::UpdateBufferDataInfo info{};
+    info.buffer = updateInfo->buffer->impl;
+    info.data   = std::as_bytes(std::span(updateInfo->pData, updateInfo->dataCount));
+    info.offset = updateInfo->offset;
+
+    auto token = std::make_shared<Coral::CompletionToken>();
+    if (!commandBuffer->impl->cmdUpdateBufferDataFromHostMemory(info, token))
+    {
+        return CO_FAILED;
+    }
+
+    *pToken = new CoCompletionToken_T{ token };
+    return CO_SUCCESS;
+}
+
+
 CoResult 
 coCommandBufferUpdateImageData(CoCommandBuffer commandBuffer, const CoUpdateImageDataInfo* updateInfo)
 {
     Coral::UpdateImageDataInfo info{};
-    info.image = updateInfo->image->impl;
-    info.data  = std::as_bytes(std::span(updateInfo->pData, updateInfo->dataCount));
+    info.image         = updateInfo->image->impl;
+    info.data          = std::as_bytes(std::span(updateInfo->pData, updateInfo->dataCount));
+    info.mipLevel      = updateInfo->mipLevel;
+    info.offsetX       = updateInfo->offsetX;
+    info.offsetY       = updateInfo->offsetY;
+    info.extent        = updateInfo->extent;
+    info.rowPitch      = updateInfo->rowPitch;
+    info.mipLevelCount = updateInfo->mipLevelCount;
+    info.arrayLayer    = updateInfo->arrayLayer;
+    info.layerCount    = updateInfo->layerCount;
     return commandBuffer->impl->cmdUpdateImageData(info) ? CO_SUCCESS : CO_FAILED;
 }
 
 
+CoResult
+coCommandBufferReadbackBuffer(CoCommandBuffer commandBuffer, 
+                              CoBuffer source, 
+                              uint64_t offset, 
+                              uint64_t size, 
+                              CoReadback* pReadback)
+{
+    if (auto readback = commandBuffer->impl->cmdReadbackBuffer(source->impl, offset, size))
+    {
+        *pReadback = new CoReadback_T{ readback };
+        return CO_SUCCESS;
+    }
+    return CO_FAILED;
+}
+
+
+CoResult
+coCommandBufferReadbackImage(CoCommandBuffer commandBuffer, const CoReadbackImageInfo* info, CoReadback* pReadback)
+{
+    if (info == nullptr || info->image == nullptr)
+    {
+        return CO_FAILED;
+    }
+
+    Coral::ReadbackImageInfo readbackInfo{};
+    readbackInfo.image      = info->image->impl;
+    readbackInfo.mipLevel   = info->mipLevel;
+    readbackInfo.offsetX    = info->offsetX;
+    readbackInfo.offsetY    = info->offsetY;
+    readbackInfo.extent     = info->extent;
+    readbackInfo.arrayLayer = info->arrayLayer;
+
+    if (auto readback = commandBuffer->impl->cmdReadbackImage(readbackInfo))
+    {
+        *pReadback = new CoReadback_T{ readback };
+        return CO_SUCCESS;
+    }
+    return CO_FAILED;
+}
+
+
 CoResult 
 coCommandBufferGenerateMipMaps(CoCommandBuffer commandBuffer, CoImage image)
 {
-    return commandBuffer->impl->cmdGenerateMipMaps(image->impl) ? CO_SUCCESS : CO_FAILED;
+    return coCommandBufferGenerateMipMapsWithReduction(commandBuffer, image, CO_MIP_REDUCTION_AVERAGE);
+}
+
+
+CoResult 
+coCommandBufferGenerateMipMapsWithReduction(CoCommandBuffer commandBuffer, CoImage image, CoMipReduction reduction)
+{
+    return commandBuffer->impl->cmdGenerateMipMaps(image->impl, reduction) ? CO_SUCCESS : CO_FAILED;
 }
 
 
 CoResult
 coCommandBufferBlitImage(CoCommandBuffer commandBuffer, CoImage source, CoImage dest)
 {
-    return CO_FAILED;
+    return commandBuffer->impl->cmdBlitImage(source->impl, dest->impl) ? CO_SUCCESS : CO_FAILED;
+}
+
+
+CoResult
+coCommandBufferCopyBufferToImage(CoCommandBuffer commandBuffer, const CoCopyBufferToImageInfo* pInfo)
+{
+    if (pInfo == nullptr || pInfo->source == nullptr || pInfo->dest == nullptr)
+    {
+        return CO_FAILED;
+    }
+
+    Coral::CopyBufferToImageInfo info{};
+    info.source = pInfo->source->impl;
+    info.dest   = pInfo->dest->impl;
+
+    if (pInfo->pRegions)
+    {
+        info.regions = { pInfo->pRegions, pInfo->regionCount };
+    }
+
+    return commandBuffer->impl->cmdCopyBufferToImage(info) ? CO_SUCCESS : CO_FAILED;
+}
+
+
+CoResult
+coCommandBufferCopyImage(CoCommandBuffer commandBuffer, const CoCopyImageInfo* pInfo)
+{
+    if (pInfo == nullptr || pInfo->source == nullptr || pInfo->dest == nullptr || pInfo->pRegions == nullptr)
+    {
+        return CO_FAILED;
+    }
+
+    Coral::CopyImageInfo info{};
+    info.source  = pInfo->source->impl;
+    info.dest    = pInfo->dest->impl;
+    info.regions = { pInfo->pRegions, pInfo->regionCount };
+
+    return commandBuffer->impl->cmdCopyImage(info) ? CO_SUCCESS : CO_FAILED;
 }
 
 
@@ -146,6 +275,24 @@ coCommandBufferSetViewport(CoCommandBuffer commandBuffer, const CoViewportInfo*
 CoResult
 coCommandBufferBindUniformBuffer(CoCommandBuffer commandBuffer, CoBuffer buffer, uint32_t binding)
 {
+    if ((buffer->impl->type() & CO_BUFFER_TYPE_UNIFORM) == 0)
+    {
+        return CO_FAILED;
+    }
+
+    commandBuffer->impl->cmdBindDescriptor(buffer->impl, binding);
+    return CO_SUCCESS;
+}
+
+
+CoResult
+coCommandBufferBindStorageBuffer(CoCommandBuffer commandBuffer, CoBuffer buffer, uint32_t binding)
+{
+    if ((buffer->impl->type() & CO_BUFFER_TYPE_STORAGE) == 0)
+    {
+        return CO_FAILED;
+    }
+
     commandBuffer->impl->cmdBindDescriptor(buffer->impl, binding);
     return CO_SUCCESS;
 }
@@ -154,11 +301,30 @@ coCommandBufferBindUniformBuffer(CoCommandBuffer commandBuffer, CoBuffer buffer,
 CoResult
 coCommandBufferBindImage(CoCommandBuffer commandBuffer, CoImage image, uint32_t binding)
 {
+    // Transient images are created without sampled and storage usage
+    if (image->impl->isTransient())
+    {
+        return CO_FAILED;
+    }
+
     commandBuffer->impl->cmdBindDescriptor(image->impl, binding);
     return CO_SUCCESS;
 }
 
 
+CoResult
+coCommandBufferBindImageView(CoCommandBuffer commandBuffer, CoImageView view, uint32_t binding)
+{
+    if (view->image->isTransient())
+    {
+        return CO_FAILED;
+    }
+
+    commandBuffer->impl->cmdBindDescriptor(view->image, view->config, binding);
+    return CO_SUCCESS;
+}
+
+
 CoResult
 coCommandBufferBindSampler(CoCommandBuffer commandBuffer, CoSampler sampler, uint32_t binding)
 {
@@ -174,6 +340,58 @@ coCommandBufferDrawIndexed(CoCommandBuffer commandBuffer, const CoDrawIndexedInf
 }
 
 
+CoResult
+coCommandBufferDrawIndexedIndirect(CoCommandBuffer commandBuffer, const CoDrawIndexedIndirectInfo* info)
+{
+    if (info == nullptr || info->buffer == nullptr)
+    {
+        return CO_FAILED;
+    }
+
+    Coral::DrawIndexedIndirectInfo drawInfo{};
+    drawInfo.buffer    = info->buffer->impl;
+    drawInfo.offset    = info->offset;
+    drawInfo.drawCount = info->drawCount;
+    drawInfo.stride    = info->stride;
+
+    return commandBuffer->impl->cmdDrawIndexedIndirect(drawInfo) ? CO_SUCCESS : CO_FAILED;
+}
+
+
+CoResult
+coCommandBufferDrawIndexedIndirectCount(CoCommandBuffer commandBuffer, const CoDrawIndexedIndirectCountInfo* info)
+{
+    if (info == nullptr || info->buffer == nullptr || info->countBuffer == nullptr)
+    {
+        return CO_FAILED;
+    }
+
+    Coral::DrawIndexedIndirectInfo drawInfo{};
+    drawInfo.buffer      = info->buffer->impl;
+    drawInfo.offset      = info->offset;
+    drawInfo.drawCount   = info->maxDrawCount;
+    drawInfo.stride      = info->stride;
+    drawInfo.countBuffer = info->countBuffer->impl;
+    drawInfo.countOffset = info->countOffset;
+
+    return commandBuffer->impl->cmdDrawIndexedIndirect(drawInfo) ? CO_SUCCESS : CO_FAILED;
+}
+
+
+CoResult
+coCommandBufferDispatch(CoCommandBuffer commandBuffer, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    return commandBuffer->impl->cmdDispatch(groupCountX, groupCountY, groupCountZ) ? CO_SUCCESS : CO_FAILED;
+}
+
+
+CoResult
+coCommandBufferDispatchIndirect(CoCommandBuffer commandBuffer, CoBuffer buffer, size_t offset)
+{
+    return commandBuffer->impl->cmdDispatchIndirect(buffer->impl, offset) ? CO_SUCCESS : CO_FAILED;
+}
+
+
 CoResult 
 coCommandQueueSubmit(CoCommandQueue queue, const CoCommandBufferSubmitInfo* submitInfo, CoFence fence)
 {
@@ -194,6 +412,13 @@ coCommandQueueSubmit(CoCommandQueue queue, const CoCommandBufferSubmitInfo* subm
     info.commandBuffers   = commandBuffers;
     info.waitSemaphores   = waitSemaphores;
     info.signalSemaphores = signalSemaphores;
+    info.waitUploadToken  = submitInfo->waitUploadToken;
+
+    if (submitInfo->pWaitStageMasks)
+    {
+        info.waitStageMasks.assign(submitInfo->pWaitStageMasks,
+                                   submitInfo->pWaitStageMasks + submitInfo->waitSemaphoreCount);
+    }
 
     return queue->impl->submit(info, fence ? fence->impl : nullptr) ? CO_SUCCESS : CO_FAILED;
 }
\ No newline at end of file
@@ -17,6 +17,7 @@ struct ClearColor
 {
     CoClearOp clearOp;
     float color[4];
+    CoStoreOp storeOp;
 };
 
 
@@ -26,6 +27,9 @@ struct BeginRenderPassInfo
 
     std::map<uint32_t, ClearColor> clearColor;
     std::optional<CoClearDepthStencil> clearDepth;
+
+    std::map<uint32_t, ImagePtr> resolveImages;
+    ImagePtr depthResolveImage;
 };
 
 
@@ -47,11 +51,28 @@ struct CopyBufferInfo
     size_t size{ 0 };
 };
 
-struct CopyImageInfo
+struct CopyBufferToImageInfo
 {
+    /// Source buffer to copy data from
     BufferPtr source{ nullptr };
 
+    /// Destination image to copy data to
+    ImagePtr dest{ nullptr };
+
+    /// The regions to copy. If empty, the start of the buffer is copied into the entire first mip level.
+    std::span<const CoBufferImageCopyRegion> regions;
+};
+
+struct CopyImageInfo
+{
+    /// Source image to copy data from
+    ImagePtr source{ nullptr };
+
+    /// Destination image to copy data to
     ImagePtr dest{ nullptr };
+
+    /// The regions to copy
+    std::span<const CoImageCopyRegion> regions;
 };
 
 
@@ -72,6 +93,28 @@ struct UpdateBufferDataInfo
 };
 
 
+struct DrawIndexedIndirectInfo
+{
+    /// The buffer containing the draw parameters
+    Coral::BufferPtr buffer{ nullptr };
+
+    /// Byte offset of the first draw in the buffer
+    size_t offset{ 0 };
+
+    /// Number of draws. If countBuffer is set, the maximum number of draws.
+    uint32_t drawCount{ 0 };
+
+    /// Byte stride between consecutive draws. Zero means tightly packed draws.
+    uint32_t stride{ 0 };
+
+    /// Optional buffer containing the number of draws
+    Coral::BufferPtr countBuffer{ nullptr };
+
+    /// Byte offset of the number of draws in the count buffer
+    size_t countOffset{ 0 };
+};
+
+
 struct UpdateImageDataInfo
 {
     /// The image to update
@@ -79,6 +122,47 @@ struct UpdateImageDataInfo
     
     /// The data to be put into the image
     std::span<const std::byte> data;
+
+    /// The mip level to update
+    uint32_t mipLevel{ 0 };
+
+    /// Pixel offset of the updated region within the mip level
+    uint32_t offsetX{ 0 };
+    uint32_t offsetY{ 0 };
+
+    /// Size of the updated region in pixels. A zero width or height updates the remainder of the mip level.
+    CoExtent extent{ 0, 0 };
+
+    /// Number of bytes between the starts of two consecutive rows in data. Zero means tightly packed rows.
+    uint32_t rowPitch{ 0 };
+
+    /// Number of consecutive, complete mip levels starting at mipLevel that are contained in data
+    uint32_t mipLevelCount{ 1 };
+
+    /// The first array layer (or depth slice of 3D images) to update
+    uint32_t arrayLayer{ 0 };
+
+    /// Number of consecutive array layers (or depth slices of 3D images) contained in data
+    uint32_t layerCount{ 1 };
+};
+
+struct ReadbackImageInfo
+{
+    /// The image to read from
+    Coral::ImagePtr image{ nullptr };
+
+    /// The mip level to read from
+    uint32_t mipLevel{ 0 };
+
+    /// Pixel offset of the region within the mip level
+    uint32_t offsetX{ 0 };
+    uint32_t offsetY{ 0 };
+
+    /// Size of the region in pixels. A zero width or height reads the remainder of the mip level.
+    CoExtent extent{ 0, 0 };
+
+    /// The array layer (or depth slice of 3D images) to read from
+    uint32_t arrayLayer{ 0 };
 };
 
 /*!
@@ -125,13 +209,43 @@ public:
 
     virtual bool cmdUpdateBufferData(const UpdateBufferDataInfo& info) = 0;
 
+    /*!
+     * \brief Update the buffer data by letting the GPU read directly from the host memory referenced in \p info
+     * \param info The update info. The referenced memory must stay valid until \p token is completed.
+     * \param token The token to complete once the host memory is no longer accessed
+     */
+    virtual bool cmdUpdateBufferDataFromHostMemory(const UpdateBufferDataInfo& info, CompletionTokenPtr token) = 0;
+
     virtual bool cmdUpdateImageData(const UpdateImageDataInfo& info) = 0;
 
+    /*!
+     * \brief Copy a range of the buffer into CPU-visible memory
+     * \param source The buffer to read from
+     * \param offset Byte offset of the range to read
+     * \param size Number of bytes to read
+     * \return The readback object that becomes ready once the command buffer finished execution, or nullptr if the
+     *         command failed.
+     */
+    virtual ReadbackPtr cmdReadbackBuffer(BufferPtr source, size_t offset, size_t size) = 0;
+
+    /*!
+     * \brief Copy a region of an image into CPU-visible memory
+     * \return The readback object containing the tightly packed pixels of the region, or nullptr if the command 
+     *         failed.
+     */
+    virtual ReadbackPtr cmdReadbackImage(const ReadbackImageInfo& info) = 0;
+
+    virtual bool cmdCopyBufferToImage(const CopyBufferToImageInfo& info) = 0;
+
     virtual bool cmdCopyImage(const CopyImageInfo& info) = 0;
 
     virtual bool cmdCopyBuffer(const CopyBufferInfo& info) = 0;
 
-    virtual bool cmdGenerateMipMaps(ImagePtr image) = 0;
+    /*!
+     * \brief Generate the mip levels of the image from its first mip level
+     * \return false if the image has no mip levels to generate or the reduction is not supported for the image
+     */
+    virtual bool cmdGenerateMipMaps(ImagePtr image, CoMipReduction reduction) = 0;
 
     /*!
      * \brief Bind the vertex buffer
@@ -164,6 +278,28 @@ public:
      */
     virtual bool cmdDrawIndexed(const CoDrawIndexedInfo& info) = 0;
 
+    /*!
+     * \brief Draw the primitives with indexed vertices and parameters read from the buffer
+     *
+     * If the info contains a count buffer, the number of draws is read from the count buffer as well.
+     */
+    virtual bool cmdDrawIndexedIndirect(const DrawIndexedIndirectInfo& info) = 0;
+
+    /*!
+     * \brief Dispatch compute work with the bound compute pipeline
+     * \param groupCountX The number of local workgroups in the X dimension
+     * \param groupCountY The number of local workgroups in the Y dimension
+     * \param groupCountZ The number of local workgroups in the Z dimension
+     */
+    virtual bool cmdDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) = 0;
+
+    /*!
+     * \brief Dispatch compute work with the workgroup counts read from the buffer
+     * \param buffer The buffer containing the three workgroup counts
+     * \param offset The byte offset of the workgroup counts in the buffer
+     */
+    virtual bool cmdDispatchIndirect(Coral::BufferPtr buffer, size_t offset) = 0;
+
     /*!
      * \brief Set the viewport
      * \param info Structure containing the viewport
@@ -171,7 +307,11 @@ public:
     virtual bool cmdSetViewport(const CoViewportInfo& info) = 0;
     
     /*!
-     * \brief Bind the image at the given binding
+     * \brief Bind the buffer at the given binding
+     *
+     * The buffer is bound as uniform buffer or storage buffer, depending on the descriptor declared by the shaders of
+     * the bound pipeline.
+     *
      * \param buffer The Buffer to bind
      * \param binding The binding index
      */
@@ -191,6 +331,14 @@ public:
      */
     virtual void cmdBindDescriptor(Coral::ImagePtr image, uint32_t binding) = 0;
 
+    /*!
+     * \brief Bind a view of the image at the given binding
+     * \param image The image to bind
+     * \param view The range of mip levels and array layers to bind. Must have been created with Image::createView.
+     * \param binding The binding index
+     */
+    virtual void cmdBindDescriptor(Coral::ImagePtr image, const Coral::ImageViewConfig& view, uint32_t binding) = 0;
+
     /*!
      * \brief Blit the content of \p source to \p dest
      * \param source The source image
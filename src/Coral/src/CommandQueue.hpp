@@ -27,8 +27,14 @@ struct CommandBufferSubmitInfo
     /// List of semaphores to wait for before execution of the command buffer can start.
     std::vector<SemaphorePtr> waitSemaphores;
 
+    /// Bitmasks of the stages waiting for the corresponding wait semaphore. If empty, all stages wait.
+    std::vector<CoPipelineStageFlags> waitStageMasks;
+
     /// List of semaphores to signal once execution of the command buffer has finished.
     std::vector<SemaphorePtr> signalSemaphores;
+
+    /// Token of the upload queue to wait for before execution of the command buffers can start. 0 if none.
+    CoUploadToken waitUploadToken{ 0 };
 };
 
 
@@ -0,0 +1,74 @@
+#include <Coral/CompletionToken.h>
+
+#include "CompletionToken.hpp"
+
+#include <chrono>
+
+using namespace Coral;
+
+
+void
+CompletionToken::complete(bool success)
+{
+    {
+        std::lock_guard lock(mProtection);
+        mComplete = true;
+        mFailed   = !success;
+    }
+    mCondition.notify_all();
+}
+
+
+bool
+CompletionToken::isComplete() const
+{
+    std::lock_guard lock(mProtection);
+    return mComplete;
+}
+
+
+bool
+CompletionToken::isFailed() const
+{
+    std::lock_guard lock(mProtection);
+    return mFailed;
+}
+
+
+CompletionToken::WaitResult
+CompletionToken::wait(uint64_t timeout) const
+{
+    std::unique_lock lock(mProtection);
+
+    if (timeout == UINT64_MAX)
+    {
+        mCondition.wait(lock, [this] { return mComplete; });
+    }
+    else if (!mCondition.wait_for(lock, std::chrono::nanoseconds(timeout), [this] { return mComplete; }))
+    {
+        return WaitResult::TIMEOUT;
+    }
+
+    return mFailed ? WaitResult::FAILED : WaitResult::SUCCESS;
+}
+
+
+void
+coDestroyCompletionToken(CoCompletionToken token)
+{
+    delete token;
+}
+
+
+bool
+coCompletionTokenIsComplete(CoCompletionToken token)
+{
+    return token->impl->isComplete();
+}
+
+
+CoResult
+coCompletionTokenWait(CoCompletionToken token, uint64_t timeout)
+{
+    return static_cast<CoResult>(token->impl->wait(timeout));
+}
@@ -0,0 +1,73 @@
+#ifndef CORAL_COMPLETIONTOKEN_HPP
+#define CORAL_COMPLETIONTOKEN_HPP
+
+#include <Coral/CompletionToken.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace Coral
+{
+
+/*!
+ * CPU-side synchronization primitive that is completed by the backend once the tracked GPU work has finished.
+ * 
+ * Unlike a Fence, a CompletionToken is not bound to a queue submission. The backend hands the token over to the
+ * command queue at submit time, which completes it after the submission's fence was signaled.
+ */
+class CORAL_API CompletionToken
+{
+public:
+
+    enum class WaitResult
+    {
+        SUCCESS = CO_SUCCESS,
+        FAILED  = CO_FAILED,
+        TIMEOUT = CO_ERROR_TIMEOUT,
+    };
+
+    /*!
+     * \brief Mark the token as completed and wake up all waiting threads
+     * \param success False if the tracked command was not executed, e.g. because the submission failed or the command
+     *                buffer was destroyed or re-recorded without being submitted.
+     */
+    void complete(bool success);
+
+    /*!
+     * \brief Check if the token is completed, regardless of whether the tracked command was executed
+     */
+    bool isComplete() const;
+
+    /*!
+     * \brief Check if the token is completed without the tracked command being executed
+     */
+    bool isFailed() const;
+
+    /*!
+     * \brief Block until the token is completed or the timeout (in nanoseconds) is reached
+     * \return FAILED if the token was completed without the tracked command being executed
+     */
+    WaitResult wait(uint64_t timeout) const;
+
+private:
+
+    mutable std::mutex mProtection;
+
+    mutable std::condition_variable mCondition;
+
+    bool mComplete{ false };
+
+    bool mFailed{ false };
+
+}; // class CompletionToken
+
+} // namespace Coral
+
+struct CoCompletionToken_T
+{
+    std::shared_ptr<Coral::CompletionToken> impl;
+};
+
+#endif // !CORAL_COMPLETIONTOKEN_HPP
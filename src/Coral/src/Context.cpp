@@ -34,6 +34,14 @@ coContextGetGraphicsAPI(const CoContext context)
 }
 
 
+CoResult
+coContextGetMemoryBudget(CoContext context, CoMemoryBudget* pBudget)
+{
+    *pBudget = context->impl->getMemoryBudget();
+    return CO_SUCCESS;
+}
+
+
 CoResult
 coContextGetTransferQueue(const CoContext context, CoCommandQueue* pQueue)
 {
@@ -13,6 +13,7 @@
 #include "Semaphore.hpp"
 #include "ShaderModule.hpp"
 #include "Swapchain.hpp"
+#include "UploadQueue.hpp"
 
 #include <expected>
 #include <string_view>
@@ -78,6 +79,9 @@ public:
     /// Get the preferred CommandQueue for transfer commands
     virtual Coral::CommandQueue* getTransferQueue() = 0;
 
+    /// Get the queue batching uploads into submissions of the transfer queue
+    virtual Coral::UploadQueue* getUploadQueue() = 0;
+
     /// Create a new Buffer object
     virtual std::expected<Coral::BufferPtr, Coral::Buffer::CreateError> createBuffer(const Coral::Buffer::CreateConfig& config) = 0;
 
@@ -93,6 +97,9 @@ public:
     /// Create a new PipelineState object
     virtual std::expected<Coral::PipelineStatePtr, Coral::PipelineState::CreateError> createPipelineState(const Coral::PipelineState::CreateConfig& config) = 0;
 
+    /// Create a new compute PipelineState object
+    virtual std::expected<Coral::PipelineStatePtr, Coral::PipelineState::CreateError> createComputePipelineState(const Coral::PipelineState::ComputeCreateConfig& config) = 0;
+
     /// Create a new Sampler object
     virtual std::expected<Coral::SamplerPtr, Coral::Sampler::CreateError> createSampler(const Coral::Sampler::CreateConfig& config) = 0;
 
@@ -104,6 +111,27 @@ public:
 
     /// Create a new Swapchain object
     virtual std::expected<Coral::SwapchainPtr, Coral::Swapchain::CreateError> createSwapchain(const Coral::Swapchain::CreateConfig& config) = 0;
+
+    /// Create a new Buffer object backed by imported memory
+    virtual std::expected<Coral::BufferPtr, Coral::Buffer::CreateError> importBuffer(const Coral::Buffer::CreateConfig& config, const CoExternalMemoryHandle& handle) = 0;
+
+    /// Create a new Image object backed by imported memory
+    virtual std::expected<Coral::ImagePtr, Coral::Image::CreateError> importImage(const Coral::Image::CreateConfig& config, const CoExternalMemoryHandle& handle) = 0;
+
+    /// Request an Image object for an intermediate render target from the context's render target pool
+    virtual std::expected<Coral::ImagePtr, Coral::Image::CreateError> requestRenderTarget(const Coral::Image::CreateConfig& config) = 0;
+
+    /// Create a new Semaphore object from an exported semaphore file descriptor
+    virtual std::expected<Coral::SemaphorePtr, Coral::Semaphore::CreateError> importSemaphore(int fd) = 0;
+
+    /// Check if images of the pixel format can be created for the usage
+    virtual bool isImageFormatSupported(CoPixelFormat format, CoImageUsageHint usageHint) = 0;
+
+    /// Get the highest number of samples per texel supported for framebuffer attachments with the pixel format
+    virtual uint32_t maxSampleCount(CoPixelFormat format) = 0;
+
+    /// Get the current device-local memory usage and budget
+    virtual CoMemoryBudget getMemoryBudget() = 0;
 };
 
 } // namespace Coral
@@ -113,6 +141,8 @@ struct CoContext_T
     Coral::ContextPtr impl;
 
     std::unordered_map<Coral::CommandQueue*, std::unique_ptr<CoCommandQueue_T>> m_commandQueues;
+
+    std::unique_ptr<CoUploadQueue_T> m_uploadQueue;
 };
 
 #endif // !CORAL_CONTEXT_HPP
\ No newline at end of file
@@ -9,23 +9,30 @@ namespace Coral
 class Buffer;
 class CommandBuffer;
 class CommandQueue;
+class CompletionToken;
 class Context;
 class Fence;
 class Framebuffer;
 class Image;
 class PipelineState;
+class Readback;
 class Sampler;
 class Semaphore;
 class ShaderModule;
 class Swapchain;
+class UploadQueue;
+
+struct ImageViewConfig;
 
 using BufferPtr        = std::shared_ptr<Buffer>;
 using CommandBufferPtr = std::shared_ptr<CommandBuffer>;
+using CompletionTokenPtr = std::shared_ptr<CompletionToken>;
 using ContextPtr       = std::shared_ptr<Context>;
 using FencePtr         = std::shared_ptr<Fence>;
 using FramebufferPtr   = std::shared_ptr<Framebuffer>;
 using ImagePtr         = std::shared_ptr<Image>;
 using PipelineStatePtr = std::shared_ptr<PipelineState>;
+using ReadbackPtr      = std::shared_ptr<Readback>;
 using SamplerPtr       = std::shared_ptr<Sampler>;
 using SemaphorePtr     = std::shared_ptr<Semaphore>;
 using ShaderModulePtr  = std::shared_ptr<ShaderModule>;
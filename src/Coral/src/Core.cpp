@@ -50,10 +50,31 @@ coPixelFormatGetSizeInBytes(CoPixelFormat format)
         case CO_PIXEL_FORMAT_RGB16_F:          return 6;
         case CO_PIXEL_FORMAT_RGBA16_F:         return 8;
 
-        case CO_PIXEL_FORMAT_R8_SRGB:          return 2;
-        case CO_PIXEL_FORMAT_RG8_SRGB:         return 4;
-        case CO_PIXEL_FORMAT_RGB8_SRGB:        return 6;
-        case CO_PIXEL_FORMAT_RGBA8_SRGB:       return 8;
+        case CO_PIXEL_FORMAT_R8_SRGB:          return 1;
+        case CO_PIXEL_FORMAT_RG8_SRGB:         return 2;
+        case CO_PIXEL_FORMAT_RGB8_SRGB:        return 3;
+        case CO_PIXEL_FORMAT_RGBA8_SRGB:       return 4;
+
+        case CO_PIXEL_FORMAT_BC1_RGBA_UNORM:   return 8;
+        case CO_PIXEL_FORMAT_BC1_RGBA_SRGB:    return 8;
+        case CO_PIXEL_FORMAT_BC3_UNORM:        return 16;
+        case CO_PIXEL_FORMAT_BC3_SRGB:         return 16;
+        case CO_PIXEL_FORMAT_BC4_UNORM:        return 8;
+        case CO_PIXEL_FORMAT_BC4_SNORM:        return 8;
+        case CO_PIXEL_FORMAT_BC5_UNORM:        return 16;
+        case CO_PIXEL_FORMAT_BC5_SNORM:        return 16;
+        case CO_PIXEL_FORMAT_BC7_UNORM:        return 16;
+        case CO_PIXEL_FORMAT_BC7_SRGB:         return 16;
+
+        case CO_PIXEL_FORMAT_ETC2_RGB8_UNORM:  return 8;
+        case CO_PIXEL_FORMAT_ETC2_RGB8_SRGB:   return 8;
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM: return 16;
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB:  return 16;
+
+        case CO_PIXEL_FORMAT_ASTC_4x4_UNORM:   return 16;
+        case CO_PIXEL_FORMAT_ASTC_4x4_SRGB:    return 16;
+        case CO_PIXEL_FORMAT_ASTC_8x8_UNORM:   return 16;
+        case CO_PIXEL_FORMAT_ASTC_8x8_SRGB:    return 16;
     }
 
     assert(false);
@@ -61,6 +82,59 @@ coPixelFormatGetSizeInBytes(CoPixelFormat format)
 }
 
 
+bool
+coPixelFormatIsCompressed(CoPixelFormat format)
+{
+    auto blockExtent = coPixelFormatGetBlockExtent(format);
+    return blockExtent.width > 1 || blockExtent.height > 1;
+}
+
+
+CoExtent
+coPixelFormatGetBlockExtent(CoPixelFormat format)
+{
+    switch (format)
+    {
+        case CO_PIXEL_FORMAT_BC1_RGBA_UNORM:
+        case CO_PIXEL_FORMAT_BC1_RGBA_SRGB:
+        case CO_PIXEL_FORMAT_BC3_UNORM:
+        case CO_PIXEL_FORMAT_BC3_SRGB:
+        case CO_PIXEL_FORMAT_BC4_UNORM:
+        case CO_PIXEL_FORMAT_BC4_SNORM:
+        case CO_PIXEL_FORMAT_BC5_UNORM:
+        case CO_PIXEL_FORMAT_BC5_SNORM:
+        case CO_PIXEL_FORMAT_BC7_UNORM:
+        case CO_PIXEL_FORMAT_BC7_SRGB:
+        case CO_PIXEL_FORMAT_ETC2_RGB8_UNORM:
+        case CO_PIXEL_FORMAT_ETC2_RGB8_SRGB:
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM:
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB:
+        case CO_PIXEL_FORMAT_ASTC_4x4_UNORM:
+        case CO_PIXEL_FORMAT_ASTC_4x4_SRGB:
+            return { 4, 4 };
+
+        case CO_PIXEL_FORMAT_ASTC_8x8_UNORM:
+        case CO_PIXEL_FORMAT_ASTC_8x8_SRGB:
+            return { 8, 8 };
+
+        default:
+            return { 1, 1 };
+    }
+}
+
+
+uint64_t
+coPixelFormatGetRegionSizeInBytes(CoPixelFormat format, uint32_t width, uint32_t height)
+{
+    auto blockExtent = coPixelFormatGetBlockExtent(format);
+
+    uint64_t blocksX = (uint64_t(width) + blockExtent.width - 1) / blockExtent.width;
+    uint64_t blocksY = (uint64_t(height) + blockExtent.height - 1) / blockExtent.height;
+
+    return blocksX * blocksY * coPixelFormatGetSizeInBytes(format);
+}
+
+
 uint32_t
 coAttributeFormatGetSizeInBytes(CoAttributeFormat format)
 {
@@ -0,0 +1,244 @@
+#include <Coral/FrameCapture.h>
+
+#include "CommandBuffer.hpp"
+#include "FrameCapture.hpp"
+#include "Framebuffer.hpp"
+#include "Image.hpp"
+#include "Readback.hpp"
+
+#include <algorithm>
+
+using namespace Coral;
+
+namespace
+{
+
+// Interval in which the worker thread checks for shutdown while waiting for a readback. Frames that were recorded but
+// never submitted would otherwise block the destruction of the frame capture.
+constexpr uint64_t WorkerPollInterval = 10'000'000; // 10ms
+
+} // namespace
+
+
+FrameCapture::FrameCapture(const CreateConfig& config)
+    : mRingSize(config.ringSize)
+    , mCallback(config.callback)
+    , mUserData(config.pUserData)
+{
+    mWorker = std::thread([this] { run(); });
+}
+
+
+FrameCapture::~FrameCapture()
+{
+    {
+        std::lock_guard lock(mProtection);
+        mStop = true;
+    }
+    mCondition.notify_all();
+
+    mWorker.join();
+}
+
+
+bool
+FrameCapture::record(CommandBuffer& commandBuffer, ImagePtr image)
+{
+    // Transient images cannot be read back
+    if (image->isTransient())
+    {
+        return false;
+    }
+
+    std::lock_guard lock(mProtection);
+
+    // Never wait for the consumer. If all buffers of the ring are in use, drop the frame.
+    if (mPendingFrames.size() >= mRingSize)
+    {
+        mStatistics.frameCount++;
+        mStatistics.droppedFrameCount++;
+        return true;
+    }
+
+    ReadbackImageInfo info{};
+    info.image = image;
+
+    auto readback = commandBuffer.cmdReadbackImage(info);
+    if (!readback)
+    {
+        return false;
+    }
+
+    auto& frame      = mPendingFrames.emplace_back();
+    frame.frameIndex = mStatistics.frameCount++;
+    frame.readback   = readback;
+    frame.extent     = { image->width(), image->height() };
+    frame.format     = image->format();
+    frame.recordTime = std::chrono::steady_clock::now();
+
+    mCondition.notify_all();
+
+    return true;
+}
+
+
+FrameCapture::FlushResult
+FrameCapture::flush(uint64_t timeout)
+{
+    std::unique_lock lock(mProtection);
+
+    auto isFlushed = [this] { return mPendingFrames.empty(); };
+
+    // std::chrono::nanoseconds is signed and the deadline must not overflow the clock. Timeouts beyond the range of
+    // the clock (including UINT64_MAX) wait forever.
+    auto now        = std::chrono::steady_clock::now();
+    auto maxTimeout = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::time_point::max() - now);
+    if (timeout >= static_cast<uint64_t>(maxTimeout.count()))
+    {
+        mCondition.wait(lock, isFlushed);
+        return FlushResult::SUCCESS;
+    }
+
+    auto delivered = mCondition.wait_until(lock, now + std::chrono::nanoseconds(timeout), isFlushed);
+    return delivered ? FlushResult::SUCCESS : FlushResult::TIMEOUT;
+}
+
+
+CoFrameCaptureStatistics
+FrameCapture::statistics() const
+{
+    std::lock_guard lock(mProtection);
+    return mStatistics;
+}
+
+
+void
+FrameCapture::run()
+{
+    std::unique_lock lock(mProtection);
+
+    while (true)
+    {
+        mCondition.wait(lock, [this] { return mStop || !mPendingFrames.empty(); });
+
+        if (mStop)
+        {
+            break;
+        }
+
+        // Frames complete in submission order, so only the oldest frame needs to be watched. The frame stays in the
+        // ring until it was consumed to keep its buffer from being reused.
+        auto frame = mPendingFrames.front();
+
+        lock.unlock();
+
+        auto result = frame.readback->wait(WorkerPollInterval);
+        bool ready  = result == CompletionToken::WaitResult::SUCCESS;
+
+        // Frames whose command buffer was never executed hold no data and are dropped
+        bool failed = result == CompletionToken::WaitResult::FAILED;
+
+        uint64_t latency{ 0 };
+        if (ready)
+        {
+            auto data = frame.readback->data();
+
+            latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - frame.recordTime).count();
+
+            CoCapturedFrame capturedFrame{};
+            capturedFrame.frameIndex = frame.frameIndex;
+            capturedFrame.pData      = reinterpret_cast<const CoByte*>(data.data());
+            capturedFrame.size       = data.size();
+            capturedFrame.extent     = frame.extent;
+            capturedFrame.format     = frame.format;
+            capturedFrame.latency    = latency;
+
+            mCallback(&capturedFrame, mUserData);
+        }
+
+        lock.lock();
+
+        if (ready)
+        {
+            mTotalLatency += latency;
+            mStatistics.deliveredFrameCount++;
+            mStatistics.lastLatency    = latency;
+            mStatistics.maxLatency     = std::max(mStatistics.maxLatency, latency);
+            mStatistics.averageLatency = mTotalLatency / mStatistics.deliveredFrameCount;
+        }
+        else if (failed)
+        {
+            mStatistics.droppedFrameCount++;
+        }
+
+        if (ready || failed)
+        {
+            mPendingFrames.pop_front();
+
+            // Wake up threads waiting in flush()
+            mCondition.notify_all();
+        }
+    }
+
+    // Release the readbacks of frames that were not delivered
+    mPendingFrames.clear();
+}
+
+
+CoResult
+coCreateFrameCapture(const CoFrameCaptureCreateConfig* pConfig, CoFrameCapture* pFrameCapture)
+{
+    if (pConfig == nullptr || pConfig->ringSize == 0 || pConfig->callback == nullptr)
+    {
+        return CO_FAILED;
+    }
+
+    *pFrameCapture = new CoFrameCapture_T{ std::make_unique<Coral::FrameCapture>(*pConfig) };
+    return CO_SUCCESS;
+}
+
+
+void
+coDestroyFrameCapture(CoFrameCapture frameCapture)
+{
+    delete frameCapture;
+}
+
+
+CoResult
+coFrameCaptureRecordImage(CoFrameCapture frameCapture, CoCommandBuffer commandBuffer, CoImage image)
+{
+    return frameCapture->impl->record(*commandBuffer->impl, image->impl) ? CO_SUCCESS : CO_FAILED;
+}
+
+
+CoResult
+coFrameCaptureRecordFramebuffer(CoFrameCapture frameCapture,
+                                CoCommandBuffer commandBuffer,
+                                CoFramebuffer framebuffer,
+                                uint32_t binding)
+{
+    auto image = framebuffer->impl->colorAttachment(binding);
+    if (!image)
+    {
+        return CO_FAILED;
+    }
+
+    return frameCapture->impl->record(*commandBuffer->impl, image) ? CO_SUCCESS : CO_FAILED;
+}
+
+
+CoResult
+coFrameCaptureFlush(CoFrameCapture frameCapture, uint64_t timeout)
+{
+    return static_cast<CoResult>(frameCapture->impl->flush(timeout));
+}
+
+
+void
+coFrameCaptureGetStatistics(CoFrameCapture frameCapture, CoFrameCaptureStatistics* pStatistics)
+{
+    *pStatistics = frameCapture->impl->statistics();
+}
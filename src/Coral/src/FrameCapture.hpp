@@ -0,0 +1,103 @@
+#ifndef CORAL_FRAMECAPTURE_HPP
+#define CORAL_FRAMECAPTURE_HPP
+
+#include <Coral/FrameCapture.h>
+
+#include "CoralFwd.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Coral
+{
+
+/*!
+ * Ring of in-flight image readbacks that delivers completed frames to a consumer callback on a worker thread
+ * 
+ * The ring rotates through at most 'ringSize' pooled readback buffers. Recording never blocks: frames that do not fit 
+ * into the ring are dropped.
+ */
+class CORAL_API FrameCapture
+{
+public:
+
+    using CreateConfig = CoFrameCaptureCreateConfig;
+
+    enum class FlushResult
+    {
+        SUCCESS = CO_SUCCESS,
+        TIMEOUT = CO_ERROR_TIMEOUT,
+    };
+
+    FrameCapture(const CreateConfig& config);
+
+    ~FrameCapture();
+
+    /*!
+     * \brief Record the readback of the image into the command buffer
+     * \return False if recording the readback failed, true if the frame was captured or dropped.
+     */
+    bool record(CommandBuffer& commandBuffer, ImagePtr image);
+
+    /*!
+     * \brief Block until all recorded frames were delivered or the timeout (in nanoseconds) is reached
+     */
+    FlushResult flush(uint64_t timeout);
+
+    /*!
+     * \brief Get the current statistics
+     */
+    CoFrameCaptureStatistics statistics() const;
+
+private:
+
+    struct PendingFrame
+    {
+        uint64_t frameIndex{ 0 };
+
+        ReadbackPtr readback;
+
+        CoExtent extent{};
+
+        CoPixelFormat format{};
+
+        std::chrono::steady_clock::time_point recordTime;
+    };
+
+    void run();
+
+    uint32_t mRingSize{ 0 };
+
+    CoFrameCaptureCallback mCallback{ nullptr };
+
+    void* mUserData{ nullptr };
+
+    mutable std::mutex mProtection;
+
+    std::condition_variable mCondition;
+
+    std::deque<PendingFrame> mPendingFrames;
+
+    CoFrameCaptureStatistics mStatistics{};
+
+    uint64_t mTotalLatency{ 0 };
+
+    bool mStop{ false };
+
+    std::thread mWorker;
+
+}; // class FrameCapture
+
+} // namespace Coral
+
+struct CoFrameCapture_T
+{
+    std::unique_ptr<Coral::FrameCapture> impl;
+};
+
+#endif // !CORAL_FRAMECAPTURE_HPP
@@ -25,9 +25,22 @@ coContextCreateFramebuffer(CoContext context, const CoFramebufferCreateConfig* c
     Framebuffer::CreateConfig configImpl{};
     configImpl.depthAttachment  = config->depthAttachment ? config->depthAttachment->impl : nullptr;
     configImpl.colorAttachments = std::span(config->pColorAttachments, config->colorAttachmentCount)
-        | std::views::transform([](const auto& attachment){ return Coral::ColorAttachment{ attachment.image->impl, attachment.binding }; })
+        | std::views::transform([](const auto& attachment)
+        {
+            if (attachment.view)
+            {
+                return Coral::ColorAttachment{ attachment.view->image, attachment.binding, attachment.view->config };
+            }
+            return Coral::ColorAttachment{ attachment.image->impl, attachment.binding, std::nullopt };
+        })
         | std::ranges::to<std::vector>();
 
+    if (config->depthAttachmentView)
+    {
+        configImpl.depthAttachment     = config->depthAttachmentView->image;
+        configImpl.depthAttachmentView = config->depthAttachmentView->config;
+    }
+
     if (auto impl = context->impl->createFramebuffer(configImpl))
     {
         *framebuffer = new CoFramebuffer_T(impl.value());
@@ -53,4 +66,5 @@ coFramebufferGetLayout(const CoFramebuffer framebuffer, CoFramebufferLayout* lay
     layout->pColorAttachments      = framebuffer->layout.colorAttachments.data();
     layout->colorAttachmentCount   = static_cast<uint32_t>(framebuffer->layout.colorAttachments.size());
     layout->depthStencilAttachment = framebuffer->layout.depthStencilAttachment ? &framebuffer->layout.depthStencilAttachment.value() : nullptr;
+    layout->sampleCount            = framebuffer->layout.sampleCount;
 }
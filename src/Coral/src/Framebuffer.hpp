@@ -3,6 +3,7 @@
 
 #include <Coral/Framebuffer.h>
 #include "CoralFwd.hpp"
+#include "Image.hpp"
 
 #include <cstdint>
 #include <optional>
@@ -21,6 +22,9 @@ struct ColorAttachment
 
     /// The index to bind the color attachment to
     uint32_t binding{ 0 };
+
+    /// The mip level and array layer to render into. If empty, the first mip level and array layer is used.
+    std::optional<ImageViewConfig> view;
 };
 
 
@@ -35,17 +39,20 @@ public:
 
         ///
         ImagePtr depthAttachment;
+
+        /// The mip level and array layer of the depth attachment to render into
+        std::optional<ImageViewConfig> depthAttachmentView;
     };
 
     enum class CreateError
     {
-        INTERNAL_ERROR,
+        INTERNAL_ERROR                          = CO_ERROR_INTERNAL,
         // Two or more color attachments are bound to the same attachment index
-        DUPLICATE_COLOR_ATTACHMENTS,
-        // The image format of a color attachment is invalid
-        INVALID_COLOR_ATTACHMENT_FORMAT,
-        // The image format of the depth-stencil attachment is invalid
-        INVALID_DEPTH_STENCIL_ATTACHMENT_FORMAT
+        DUPLICATE_COLOR_ATTACHMENTS             = CO_ERROR_INVALID_COLOR_ATTACHMENT,
+        // The image format or view of a color attachment is invalid
+        INVALID_COLOR_ATTACHMENT_FORMAT         = CO_ERROR_INVALID_COLOR_ATTACHMENT,
+        // The image format or view of the depth-stencil attachment is invalid
+        INVALID_DEPTH_STENCIL_ATTACHMENT_FORMAT = CO_ERROR_INVALID_DEPTH_STENCIL_ATTACHMENT,
     };
 
     struct Layout
@@ -55,6 +62,9 @@ public:
 
         ///
         std::optional<CoDepthStencilAttachmentInfo> depthStencilAttachment;
+
+        /// Number of samples per pixel of all attachments
+        uint32_t sampleCount{ 1 };
     };
 
     virtual ~Framebuffer() = default;
@@ -64,6 +74,12 @@ public:
     virtual uint32_t width() const = 0;
 
     virtual uint32_t height() const = 0;
+
+    /*!
+     * \brief Get the image bound to the color attachment \p binding
+     * \return The image or nullptr if no color attachment is bound to the binding index
+     */
+    virtual ImagePtr colorAttachment(uint32_t binding) const = 0;
 };
 
 } // namespace Coral
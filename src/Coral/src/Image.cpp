@@ -19,6 +19,37 @@ coContextCreateImage(CoContext context, const CoImageCreateConfig* pConfig, CoIm
 }
 
 
+CoResult
+coContextImportImage(CoContext context, 
+                     const CoImageCreateConfig* pConfig, 
+                     const CoExternalMemoryHandle* pHandle, 
+                     CoImage* pImage)
+{
+    auto impl = context->impl->importImage(*pConfig, *pHandle);
+    if (impl)
+    {
+        *pImage = new CoImage_T{ impl.value() };
+        return CO_SUCCESS;
+    }
+
+    return static_cast<CoResult>(impl.error());
+}
+
+
+CoResult
+coContextRequestRenderTarget(CoContext context, const CoImageCreateConfig* pConfig, CoImage* pImage)
+{
+    auto impl = context->impl->requestRenderTarget(*pConfig);
+    if (impl)
+    {
+        *pImage = new CoImage_T{ impl.value() };
+        return CO_SUCCESS;
+    }
+
+    return static_cast<CoResult>(impl.error());
+}
+
+
 void
 coDestroyImage(CoImage image)
 {
@@ -26,6 +57,32 @@ coDestroyImage(CoImage image)
 }
 
 
+bool
+coContextIsImageFormatSupported(CoContext context, CoPixelFormat format, CoImageUsageHint usageHint)
+{
+    return context->impl->isImageFormatSupported(format, usageHint);
+}
+
+
+uint32_t
+coContextGetMaxSampleCount(CoContext context, CoPixelFormat format)
+{
+    return context->impl->maxSampleCount(format);
+}
+
+
+CoResult
+coImageExportMemory(CoImage image, CoExternalMemoryHandle* pHandle)
+{
+    if (auto handle = image->impl->exportMemory())
+    {
+        *pHandle = *handle;
+        return CO_SUCCESS;
+    }
+    return CO_FAILED;
+}
+
+
 void
 coImageGetExtent(const CoImage image, CoExtent* pExtent)
 {
@@ -46,3 +103,75 @@ coImageGetMipLevelCount(const CoImage image)
 {
     return image->impl->getMipLevels();
 }
+
+
+uint32_t
+coImageGetSampleCount(const CoImage image)
+{
+    return image->impl->sampleCount();
+}
+
+
+bool
+coImageIsTransient(const CoImage image)
+{
+    return image->impl->isTransient();
+}
+
+
+CoResult
+coImageCreateView(CoImage image,
+                  uint32_t baseMipLevel,
+                  uint32_t mipLevelCount,
+                  uint32_t baseArrayLayer,
+                  uint32_t arrayLayerCount,
+                  CoPixelFormat format,
+                  CoImageView* pView)
+{
+    const auto& impl = image->impl;
+
+    if (mipLevelCount == 0 || baseMipLevel >= impl->getMipLevels() ||
+        mipLevelCount > impl->getMipLevels() - baseMipLevel ||
+        arrayLayerCount == 0 || baseArrayLayer >= impl->layerCount() ||
+        arrayLayerCount > impl->layerCount() - baseArrayLayer)
+    {
+        return CO_ERROR_INVALID_SIZE;
+    }
+
+    Coral::ImageViewConfig config{ baseMipLevel, mipLevelCount, baseArrayLayer, arrayLayerCount, format };
+    if (!impl->createView(config))
+    {
+        return CO_ERROR_UNSUPPORTED_FORMAT;
+    }
+
+    *pView = new CoImageView_T{ impl, config };
+    return CO_SUCCESS;
+}
+
+
+void
+coDestroyImageView(CoImageView view)
+{
+    delete view;
+}
+
+
+uint32_t
+coImageGetDepth(const CoImage image)
+{
+    return image->impl->depth();
+}
+
+
+uint32_t
+coImageGetArrayLayerCount(const CoImage image)
+{
+    return image->impl->layerCount();
+}
+
+
+CoImageType
+coImageGetType(const CoImage image)
+{
+    return image->impl->type();
+}
@@ -3,13 +3,34 @@
 
 #include <Coral/Image.h>
 
+#include <compare>
 #include <cstdint>
 
 #include <memory>
+#include <optional>
 
 namespace Coral
 {
 
+/*
+ * Range of mip levels and array layers of an image that is viewed with a pixel format
+ */
+struct ImageViewConfig
+{
+    uint32_t baseMipLevel{ 0 };
+
+    uint32_t mipLevelCount{ 1 };
+
+    uint32_t baseArrayLayer{ 0 };
+
+    uint32_t arrayLayerCount{ 1 };
+
+    /// The format the texels are interpreted with. Must be the image format or its sRGB or linear counterpart.
+    CoPixelFormat format{ CO_PIXEL_FORMAT_RGBA8_UI };
+
+    auto operator<=>(const ImageViewConfig&) const = default;
+};
+
 /*
  * Representation of a multidimensional array of pixel data which can be used for for texturing or render attachments
  */
@@ -24,7 +45,13 @@ public:
      */ 
     enum class CreateError
     {
-        INTERNAL_ERROR
+        INTERNAL_ERROR      = CO_ERROR_INTERNAL,
+        // The pixel format is not supported by the device for the usage hint
+        UNSUPPORTED_FORMAT  = CO_ERROR_UNSUPPORTED_FORMAT,
+        // The extent, depth or layer count does not match the image type
+        INVALID_SIZE        = CO_ERROR_INVALID_SIZE,
+        // The image type requires a device feature that is not supported (e.g. cube map arrays)
+        UNSUPPORTED_FEATURE = CO_ERROR_UNSUPPORTED_FEATURE,
     };
 
     virtual ~Image() = default;
@@ -41,6 +68,24 @@ public:
      */
     virtual uint32_t height() const = 0;
 
+    /*!
+     * \brief Get the depth of the Image
+     * \return The depth of 3D Images in pixels, one for all other Image types
+     */
+    virtual uint32_t depth() const = 0;
+
+    /*!
+     * \brief Get the number of array layers
+     * \return The number of array layers of the Image. Each face of a cube map is an array layer.
+     */
+    virtual uint32_t layerCount() const = 0;
+
+    /*!
+     * \brief Get the type of the Image
+     * \return The dimensionality and layer arrangement of the Image
+     */
+    virtual CoImageType type() const = 0;
+
     /*!
      * \brief Get the format of the Image
      * \return The pixel format of the Image
@@ -53,6 +98,26 @@ public:
      */
     virtual uint32_t getMipLevels() const = 0;
 
+    /*!
+     * \brief Get the number of samples per texel
+     * \return The number of samples per texel, one for images that are not multisampled
+     */
+    virtual uint32_t sampleCount() const = 0;
+
+    /*!
+     * \brief Check if the image is a transient framebuffer attachment
+     */
+    virtual bool isTransient() const = 0;
+
+    /*!
+     * \brief Create a view of a range of mip levels and array layers of the image
+     *
+     * Views are cached by the image and live as long as the image. Creating the same view again reuses the cached view.
+     *
+     * \return True if the view was created, false if the range or format is invalid for the image
+     */
+    virtual bool createView(const ImageViewConfig& config) = 0;
+
     /// Flag indicating if the Image is presentable, e.g. it is part of a swapchain.
     /**
      * Presentable Image have limitations on usage. They cannot be used for:
@@ -60,6 +125,12 @@ public:
      * * 
      */
     virtual bool presentable() const = 0;
+
+    /*!
+     * \brief Export the image memory as external memory handle
+     * \return The memory handle, or an empty optional if the image is not exportable or the export failed.
+     */
+    virtual std::optional<CoExternalMemoryHandle> exportMemory() = 0;
 };
 
 } // namespace Coral
@@ -69,4 +140,11 @@ struct CoImage_T
     std::shared_ptr<Coral::Image> impl;
 };
 
+struct CoImageView_T
+{
+    std::shared_ptr<Coral::Image> image;
+
+    Coral::ImageViewConfig config;
+};
+
 #endif // !CORAL_IMAGE_HPP
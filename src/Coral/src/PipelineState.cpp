@@ -4,10 +4,27 @@
 #include "Context.hpp"
 #include "ShaderModule.hpp"
 
+#include <algorithm>
 #include <span>
 
 using namespace Coral;
 
+namespace
+{
+
+CoResult
+convert(PipelineState::CreateError error)
+{
+    switch (error)
+    {
+        case PipelineState::CreateError::INVALID_SHADER_STAGE: return CO_FAILED;
+        case PipelineState::CreateError::UNSUPPORTED_FEATURE:  return CO_FAILED;
+        default:                                               return CO_ERROR_INTERNAL;
+    }
+}
+
+} // namespace
+
 
 CoResult
 coContextCreatePipelineState(CoContext context, const CoPipelineStateCreateConfig* pConfig, CoPipelineState* pPipelineState)
@@ -40,6 +57,8 @@ coContextCreatePipelineState(CoContext context, const CoPipelineStateCreateConfi
         configImpl.framebufferLayout.depthStencilAttachment = *pConfig->framebufferLayout.depthStencilAttachment;
     }
 
+    configImpl.framebufferLayout.sampleCount = std::max(pConfig->framebufferLayout.sampleCount, 1u);
+
     if (auto impl = context->impl->createPipelineState(configImpl))
     {
         *pPipelineState = new CoPipelineState_T{ impl.value() };
@@ -47,11 +66,30 @@ coContextCreatePipelineState(CoContext context, const CoPipelineStateCreateConfi
     }
     else
     {
-        return static_cast<CoResult>(impl.error());
+        return ::convert(impl.error());
     }
 }
 
 
+CoResult
+coContextCreateComputePipelineState(CoContext context,
+                                    const CoComputePipelineStateCreateConfig* pConfig,
+                                    CoPipelineState* pPipelineState)
+{
+    PipelineState::ComputeCreateConfig configImpl;
+    configImpl.shaderModule = pConfig->computeShaderModule ? pConfig->computeShaderModule->impl : nullptr;
+
+    auto impl = context->impl->createComputePipelineState(configImpl);
+    if (!impl)
+    {
+        return ::convert(impl.error());
+    }
+
+    *pPipelineState = new CoPipelineState_T{ impl.value() };
+    return CO_SUCCESS;
+}
+
+
 void
 coDestroyPipelineState(CoPipelineState pipelineState)
 {
@@ -54,9 +54,18 @@ public:
         CoTopology topology;
     };
 
+    /// Configuration to create a compute pipeline state object
+    struct ComputeCreateConfig
+    {
+        /// The shader module of stage CO_SHADER_STAGE_COMPUTE
+        ShaderModulePtr shaderModule;
+    };
+
     enum class CreateError
     {
-        INTERNAL_ERROR
+        INTERNAL_ERROR,
+        INVALID_SHADER_STAGE,
+        UNSUPPORTED_FEATURE
     };
 
     virtual ~PipelineState() = default;
@@ -0,0 +1,95 @@
+#include <Coral/Readback.h>
+
+#include "Buffer.hpp"
+#include "Readback.hpp"
+
+using namespace Coral;
+
+
+Readback::Readback(BufferPtr buffer, size_t size, CompletionTokenPtr token)
+    : mBuffer(std::move(buffer))
+    , mSize(size)
+    , mToken(std::move(token))
+{
+}
+
+
+Readback::~Readback()
+{
+    if (mMapped)
+    {
+        mBuffer->unmap();
+    }
+}
+
+
+bool
+Readback::isReady() const
+{
+    return mToken->isComplete() && !mToken->isFailed();
+}
+
+
+CompletionToken::WaitResult
+Readback::wait(uint64_t timeout) const
+{
+    return mToken->wait(timeout);
+}
+
+
+std::span<const std::byte>
+Readback::data()
+{
+    if (!isReady())
+    {
+        return {};
+    }
+
+    // Map the buffer only once the GPU has written the data so that mapping picks up the most recent memory content
+    if (!mMapped)
+    {
+        mMapped = mBuffer->map();
+        if (!mMapped)
+        {
+            return {};
+        }
+    }
+
+    return { mMapped, mSize };
+}
+
+
+void
+coDestroyReadback(CoReadback readback)
+{
+    delete readback;
+}
+
+
+bool
+coReadbackIsReady(CoReadback readback)
+{
+    return readback->impl->isReady();
+}
+
+
+CoResult
+coReadbackWait(CoReadback readback, uint64_t timeout)
+{
+    return static_cast<CoResult>(readback->impl->wait(timeout));
+}
+
+
+CoResult
+coReadbackGetData(CoReadback readback, const CoByte** ppData, uint64_t* pSize)
+{
+    auto data = readback->impl->data();
+    if (data.empty())
+    {
+        return CO_FAILED;
+    }
+
+    *ppData = reinterpret_cast<const CoByte*>(data.data());
+    *pSize  = data.size();
+    return CO_SUCCESS;
+}
@@ -0,0 +1,71 @@
+#ifndef CORAL_READBACK_HPP
+#define CORAL_READBACK_HPP
+
+#include <Coral/Readback.h>
+
+#include "CompletionToken.hpp"
+#include "CoralFwd.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace Coral
+{
+
+/*!
+ * CPU-side result of a readback command
+ * 
+ * The readback keeps the pooled CPU-visible buffer the GPU data was copied into. The buffer is returned to the pool
+ * once the readback is destroyed.
+ */
+class CORAL_API Readback
+{
+public:
+
+    /*!
+     * \param buffer The CPU-visible buffer the data is copied into
+     * \param size The number of bytes of readback data at the start of the buffer
+     * \param token The token that is completed once the copy into the buffer has finished
+     */
+    Readback(BufferPtr buffer, size_t size, CompletionTokenPtr token);
+
+    ~Readback();
+
+    /*!
+     * \brief Check if the data is available
+     */
+    bool isReady() const;
+
+    /*!
+     * \brief Block until the data is available or the timeout (in nanoseconds) is reached
+     * \return FAILED if the readback command was never executed
+     */
+    CompletionToken::WaitResult wait(uint64_t timeout) const;
+
+    /*!
+     * \brief Get the readback data
+     * \return The data or an empty span if the readback is not ready yet or the readback command was never executed.
+     */
+    std::span<const std::byte> data();
+
+private:
+
+    BufferPtr mBuffer;
+
+    size_t mSize{ 0 };
+
+    CompletionTokenPtr mToken;
+
+    std::byte* mMapped{ nullptr };
+
+}; // class Readback
+
+} // namespace Coral
+
+struct CoReadback_T
+{
+    std::shared_ptr<Coral::Readback> impl;
+};
+
+#endif // !CORAL_READBACK_HPP
@@ -19,8 +19,36 @@ coContextCreateSemaphore(CoContext context, const CoSemaphoreCreateConfig* pConf
     return static_cast<CoResult>(impl.error());
 }
 
+
+CoResult
+coContextImportSemaphore(CoContext context, int fd, CoSemaphore* pSemaphore)
+{
+    auto impl = context->impl->importSemaphore(fd);
+
+    if (impl)
+    {
+        *pSemaphore = new CoSemaphore_T{ impl.value() };
+        return CO_SUCCESS;
+    }
+
+    return static_cast<CoResult>(impl.error());
+}
+
+
 void
 coDestroySemaphore(CoSemaphore semaphore)
 {
     delete semaphore;
 }
+
+
+CoResult
+coSemaphoreExportFd(CoSemaphore semaphore, int* pFd)
+{
+    if (auto fd = semaphore->impl->exportFd())
+    {
+        *pFd = *fd;
+        return CO_SUCCESS;
+    }
+    return CO_FAILED;
+}
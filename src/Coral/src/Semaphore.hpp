@@ -4,6 +4,7 @@
 #include <Coral/Semaphore.h>
 
 #include <memory>
+#include <optional>
 
 namespace Coral
 {
@@ -15,11 +16,17 @@ public:
 
     enum class CreateError
     {
-        INTERNAL_ERROR
+        INTERNAL_ERROR = CO_ERROR_INTERNAL,
     };
 
     virtual ~Semaphore() = default;
 
+    /*!
+     * \brief Export the semaphore as opaque POSIX file descriptor
+     * \return The file descriptor, or an empty optional if the semaphore is not exportable or the export failed.
+     */
+    virtual std::optional<int> exportFd() = 0;
+
 };
 
 } // namespace Coral
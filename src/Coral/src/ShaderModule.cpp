@@ -95,6 +95,16 @@ coShaderModuleGetLayout(const CoShaderModule shaderModule, CoShaderModuleLayout*
                 [&](SamplerDefinition)              { info.type = CO_DESCRIPTOR_TYPE_SAMPLER; },
                 [&](TextureDefinition)              { info.type = CO_DESCRIPTOR_TYPE_TEXTURE; },
                 [&](CombinedTextureSamplerDefinition) { info.type = CO_DESCRIPTOR_TYPE_COMBINED_TEXTURE_SAMPLER; },
+                [&](StorageBufferDefinition storageBuffer)
+                {
+                    info.type          = CO_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                    info.storageBuffer = storageBuffer;
+                },
+                [&](StorageImageDefinition storageImage)
+                {
+                    info.type         = CO_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                    info.storageImage = storageImage;
+                },
                 [&](const UniformBlockDefinition& block)
                 {
                     info.type               = CO_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
@@ -110,6 +120,7 @@ coShaderModuleGetLayout(const CoShaderModule shaderModule, CoShaderModuleLayout*
     pLayout->inputAttributeBindingInfoCount  = static_cast<uint32_t>(shaderModule->mInputAttributeLayoutData.size());
     pLayout->pOutputAttributeBindingInfos    = shaderModule->mOutputAttributeLayoutData.data();
     pLayout->outputAttributeBindingInfoCount = static_cast<uint32_t>(shaderModule->mOutputAttributeLayoutData.size());
+    pLayout->workgroupSize                   = shaderModule->impl->workgroupSize();
     pLayout->pDescriptorBindingInfos         = shaderModule->mDescriptorBindingInfos.data();
     pLayout->descriptorBindingInfoCount      = static_cast<uint32_t>(shaderModule->mDescriptorBindingInfos.size());
 }
@@ -52,6 +52,8 @@ struct UniformBlockDefinition
 using SamplerDefinition                = CoSamplerDefinition;
 using TextureDefinition                = CoTextureDefinition;
 using CombinedTextureSamplerDefinition = CoCombinedTextureSamplerDefinition;
+using StorageBufferDefinition          = CoStorageBufferDefinition;
+using StorageImageDefinition           = CoStorageImageDefinition;
 
 /// Structure specifying a shader descriptor binding
 struct DescriptorDefinition
@@ -63,7 +65,12 @@ struct DescriptorDefinition
     std::string name;
 
     /// The type definition of the descriptor
-    std::variant<UniformBlockDefinition, SamplerDefinition, TextureDefinition, CombinedTextureSamplerDefinition> definition{ SamplerDefinition{} };
+    std::variant<UniformBlockDefinition,
+                 SamplerDefinition,
+                 TextureDefinition,
+                 CombinedTextureSamplerDefinition,
+                 StorageBufferDefinition,
+                 StorageImageDefinition> definition{ SamplerDefinition{} };
 };
 
 
@@ -118,6 +125,9 @@ public:
 
     /// Get the layout of descriptors required by this shader
     virtual const DescriptorLayout& descriptorLayout() const = 0;
+
+    /// Get the local workgroup size of the compute shader, zero for shaders of other stages
+    virtual CoExtent3D workgroupSize() const = 0;
 };
 
 } // namespace Coral
@@ -0,0 +1,579 @@
+#include <Coral/StreamingScheduler.h>
+
+#include "StreamingScheduler.hpp"
+#include "Context.hpp"
+#include "UploadQueue.hpp"
+
+#include <algorithm>
+#include <bit>
+
+using namespace Coral;
+
+namespace
+{
+
+uint32_t
+levelLayerCount(const Coral::Image::CreateConfig& config, uint32_t level)
+{
+    if (config.type == CO_IMAGE_TYPE_3D)
+    {
+        return std::max(std::max(config.depth, 1u) >> level, 1u);
+    }
+
+    if (config.arrayLayerCount != 0)
+    {
+        return config.arrayLayerCount;
+    }
+
+    return (config.type == CO_IMAGE_TYPE_CUBE || config.type == CO_IMAGE_TYPE_CUBE_ARRAY) ? 6 : 1;
+}
+
+
+/// Index of the first entry of the resource's data whose upload was enqueued. Uploads are enqueued from the last entry.
+uint32_t
+enqueuedLevel(const StreamingScheduler::Resource& resource)
+{
+    auto level = static_cast<uint32_t>(resource.tokens.size());
+    while (level > 0 && resource.tokens[level - 1] != 0)
+    {
+        level--;
+    }
+    return level;
+}
+
+} // namespace
+
+
+StreamingScheduler::StreamingScheduler(Context& context, UploadQueue& uploadQueue, const CreateConfig& config)
+    : mContext(context)
+    , mUploadQueue(uploadQueue)
+    , mConfig(config)
+{
+}
+
+
+StreamingScheduler::ResourcePtr
+StreamingScheduler::addImage(const Image::CreateConfig& config, std::vector<std::span<const std::byte>> mipLevelData)
+{
+    auto depth     = config.type == CO_IMAGE_TYPE_3D ? std::max(config.depth, 1u) : 1u;
+    auto mipLevels = 1u;
+    if (config.hasMipMaps)
+    {
+        auto extent = std::max({ config.extent.width, config.extent.height, depth });
+        mipLevels   = static_cast<uint32_t>(std::bit_width(extent));
+    }
+
+    if (mipLevelData.size() != mipLevels || config.transient || config.exportable)
+    {
+        return nullptr;
+    }
+
+    auto resource = std::make_shared<Resource>();
+
+    for (uint32_t level = 0; level < mipLevels; ++level)
+    {
+        auto levelSize = coPixelFormatGetRegionSizeInBytes(config.format,
+                                                           std::max(config.extent.width >> level, 1u),
+                                                           std::max(config.extent.height >> level, 1u));
+        levelSize *= ::levelLayerCount(config, level);
+
+        if (mipLevelData[level].size() < levelSize)
+        {
+            return nullptr;
+        }
+
+        resource->size += levelSize;
+    }
+
+    resource->imageConfig   = config;
+    resource->data          = std::move(mipLevelData);
+    resource->tokens.assign(resource->data.size(), 0);
+    resource->residentLevel = static_cast<uint32_t>(resource->data.size());
+
+    std::lock_guard lock(mProtection);
+    mResources.insert(resource);
+
+    return resource;
+}
+
+
+StreamingScheduler::ResourcePtr
+StreamingScheduler::addBuffer(const Buffer::CreateConfig& config, std::span<const std::byte> data)
+{
+    // CPU-visible buffers do not need to be streamed
+    if (data.size() != config.size || config.size == 0 || config.cpuVisible || config.exportable)
+    {
+        return nullptr;
+    }
+
+    auto resource = std::make_shared<Resource>();
+    resource->bufferConfig  = config;
+    resource->data          = { data };
+    resource->tokens        = { 0 };
+    resource->residentLevel = 1;
+    resource->size          = config.size;
+
+    std::lock_guard lock(mProtection);
+    mResources.insert(resource);
+
+    return resource;
+}
+
+
+void
+StreamingScheduler::remove(const ResourcePtr& resource)
+{
+    std::lock_guard lock(mProtection);
+
+    if (mResources.erase(resource) != 0)
+    {
+        evict(*resource);
+    }
+}
+
+
+void
+StreamingScheduler::request(const ResourcePtr& resource, float priority)
+{
+    std::lock_guard lock(mProtection);
+
+    if (resource->lastRequestFrame != mFrame)
+    {
+        resource->lastRequestFrame = mFrame;
+        resource->priority         = priority;
+    }
+    else
+    {
+        resource->priority = std::max(resource->priority, priority);
+    }
+}
+
+
+std::optional<CoUploadToken>
+StreamingScheduler::update()
+{
+    std::lock_guard lock(mProtection);
+
+    std::vector<Resource*> pending;
+    for (auto& resource : mResources)
+    {
+        updateResidency(*resource);
+
+        if (resource->lastRequestFrame == mFrame && !resource->failed && ::enqueuedLevel(*resource) > 0)
+        {
+            pending.push_back(resource.get());
+        }
+    }
+
+    std::ranges::stable_sort(pending, std::ranges::greater{}, &Resource::priority);
+
+    // Every round enqueues the next entry of each pending resource. A single entry exceeding the budget is uploaded
+    // alone, otherwise it would never be streamed.
+    CoUploadToken token{ 0 };
+    uint64_t uploadedBytes{ 0 };
+    bool budgetExhausted{ false };
+
+    while (!pending.empty() && !budgetExhausted)
+    {
+        std::vector<Resource*> remaining;
+        for (auto resource : pending)
+        {
+            auto size = resource->data[::enqueuedLevel(*resource) - 1].size();
+            if (uploadedBytes > 0 && uploadedBytes + size > mConfig.bytesPerFrame)
+            {
+                budgetExhausted = true;
+                break;
+            }
+
+            if (!uploadNext(*resource, token))
+            {
+                continue;
+            }
+
+            uploadedBytes += size;
+
+            if (::enqueuedLevel(*resource) > 0)
+            {
+                remaining.push_back(resource);
+            }
+        }
+
+        pending = std::move(remaining);
+    }
+
+    mStatistics.uploadedBytes        = uploadedBytes;
+    mStatistics.pendingResourceCount = 0;
+    for (auto& resource : mResources)
+    {
+        if (resource->lastRequestFrame == mFrame && resource->residentLevel > 0)
+        {
+            mStatistics.pendingResourceCount++;
+        }
+    }
+
+    mFrame++;
+
+    // Submit the uploads right away instead of waiting for a submission waiting for them
+    if (token != 0 && !mUploadQueue.flush())
+    {
+        return {};
+    }
+
+    return token;
+}
+
+
+CoStreamingSchedulerStatistics
+StreamingScheduler::statistics() const
+{
+    std::lock_guard lock(mProtection);
+    return mStatistics;
+}
+
+
+uint32_t
+StreamingScheduler::residentMipLevel(const ResourcePtr& resource)
+{
+    std::lock_guard lock(mProtection);
+
+    updateResidency(*resource);
+
+    return resource->residentLevel;
+}
+
+
+ImagePtr
+StreamingScheduler::residentImage(const ResourcePtr& resource, uint32_t& baseMipLevel, uint32_t& mipLevelCount)
+{
+    std::lock_guard lock(mProtection);
+
+    updateResidency(*resource);
+
+    if (!resource->image || resource->residentLevel >= resource->data.size())
+    {
+        return nullptr;
+    }
+
+    baseMipLevel  = resource->residentLevel;
+    mipLevelCount = static_cast<uint32_t>(resource->data.size()) - resource->residentLevel;
+
+    return resource->image;
+}
+
+
+BufferPtr
+StreamingScheduler::residentBuffer(const ResourcePtr& resource)
+{
+    std::lock_guard lock(mProtection);
+
+    updateResidency(*resource);
+
+    return resource->residentLevel == 0 ? resource->buffer : nullptr;
+}
+
+
+void
+StreamingScheduler::updateResidency(Resource& resource)
+{
+    while (resource.residentLevel > 0)
+    {
+        auto& token = resource.tokens[resource.residentLevel - 1];
+        if (token != 0 && mUploadQueue.isFailed(token))
+        {
+            // The next update enqueues the level again
+            token = 0;
+            break;
+        }
+
+        if (token == 0 || !mUploadQueue.isComplete(token))
+        {
+            break;
+        }
+
+        resource.residentLevel--;
+    }
+}
+
+
+bool
+StreamingScheduler::makeRoom(uint64_t size)
+{
+    // The device-local memory usage of the context is only reduced once the last references to the evicted resources
+    // are released. Hence, the usage is estimated from the sizes of the evicted resources.
+    uint64_t usage  = mStatistics.residentBytes;
+    uint64_t budget = mConfig.memoryBudget;
+    if (budget == 0)
+    {
+        auto memoryBudget = mContext.getMemoryBudget();
+        usage  = memoryBudget.usage;
+        budget = memoryBudget.budget;
+    }
+
+    if (usage + size <= budget)
+    {
+        return true;
+    }
+
+    std::vector<Resource*> candidates;
+    for (auto& resource : mResources)
+    {
+        if ((resource->image || resource->buffer) && resource->lastRequestFrame + mConfig.evictionDelay < mFrame)
+        {
+            candidates.push_back(resource.get());
+        }
+    }
+
+    std::ranges::sort(candidates, std::ranges::less{}, &Resource::lastRequestFrame);
+
+    for (auto resource : candidates)
+    {
+        if (usage + size <= budget)
+        {
+            break;
+        }
+
+        usage -= std::min(usage, resource->size);
+        evict(*resource);
+        mStatistics.evictionCount++;
+    }
+
+    return usage + size <= budget;
+}
+
+
+void
+StreamingScheduler::evict(Resource& resource)
+{
+    if (resource.image || resource.buffer)
+    {
+        mStatistics.residentBytes -= resource.size;
+    }
+
+    // Pending uploads keep the image or buffer alive until they finished
+    resource.image.reset();
+    resource.buffer.reset();
+    std::ranges::fill(resource.tokens, 0);
+    resource.residentLevel = static_cast<uint32_t>(resource.data.size());
+}
+
+
+bool
+StreamingScheduler::uploadNext(Resource& resource, CoUploadToken& token)
+{
+    if (!resource.image && !resource.buffer)
+    {
+        if (!makeRoom(resource.size))
+        {
+            return false;
+        }
+
+        if (resource.imageConfig)
+        {
+            auto image = mContext.createImage(*resource.imageConfig);
+            if (!image)
+            {
+                resource.failed = true;
+                return false;
+            }
+            resource.image = *image;
+        }
+        else
+        {
+            auto buffer = mContext.createBuffer(*resource.bufferConfig);
+            if (!buffer)
+            {
+                resource.failed = true;
+                return false;
+            }
+            resource.buffer = *buffer;
+        }
+
+        mStatistics.residentBytes += resource.size;
+    }
+
+    auto level = ::enqueuedLevel(resource) - 1;
+
+    std::optional<CoUploadToken> uploadToken;
+    if (resource.image)
+    {
+        UpdateImageDataInfo info{};
+        info.image      = resource.image;
+        info.data       = resource.data[level];
+        info.mipLevel   = level;
+        info.layerCount = ::levelLayerCount(*resource.imageConfig, level);
+
+        uploadToken = mUploadQueue.updateImageData(info);
+    }
+    else
+    {
+        UpdateBufferDataInfo info{};
+        info.buffer = resource.buffer;
+        info.data   = resource.data[level];
+
+        uploadToken = mUploadQueue.updateBufferData(info);
+    }
+
+    if (!uploadToken)
+    {
+        resource.failed = true;
+        return false;
+    }
+
+    resource.tokens[level] = *uploadToken;
+    token = std::max(token, *uploadToken);
+
+    return true;
+}
+
+
+CoResult
+coContextCreateStreamingScheduler(CoContext context,
+                                  const CoStreamingSchedulerCreateConfig* pConfig,
+                                  CoStreamingScheduler* pScheduler)
+{
+    if (pConfig->bytesPerFrame == 0)
+    {
+        return CO_FAILED;
+    }
+
+    auto uploadQueue = context->impl->getUploadQueue();
+    if (!uploadQueue)
+    {
+        return CO_FAILED;
+    }
+
+    auto scheduler = std::make_unique<StreamingScheduler>(*context->impl, *uploadQueue, *pConfig);
+
+    *pScheduler = new CoStreamingScheduler_T{ std::move(scheduler) };
+    return CO_SUCCESS;
+}
+
+
+void
+coDestroyStreamingScheduler(CoStreamingScheduler scheduler)
+{
+    delete scheduler;
+}
+
+
+CoResult
+coStreamingSchedulerAddImage(CoStreamingScheduler scheduler,
+                             const CoStreamingImageInfo* pInfo,
+                             CoStreamingResource* pResource)
+{
+    std::vector<std::span<const std::byte>> mipLevelData;
+    for (uint32_t i = 0; i < pInfo->mipLevelCount; ++i)
+    {
+        mipLevelData.push_back(std::as_bytes(std::span(pInfo->ppMipLevelData[i], pInfo->pMipLevelDataSizes[i])));
+    }
+
+    auto resource = scheduler->impl->addImage(pInfo->imageConfig, std::move(mipLevelData));
+    if (!resource)
+    {
+        return CO_ERROR_INVALID_SIZE;
+    }
+
+    *pResource = new CoStreamingResource_T{ resource, scheduler->impl.get() };
+    return CO_SUCCESS;
+}
+
+
+CoResult
+coStreamingSchedulerAddBuffer(CoStreamingScheduler scheduler,
+                              const CoStreamingBufferInfo* pInfo,
+                              CoStreamingResource* pResource)
+{
+    auto data     = std::as_bytes(std::span(pInfo->pData, pInfo->bufferConfig.size));
+    auto resource = scheduler->impl->addBuffer(pInfo->bufferConfig, data);
+    if (!resource)
+    {
+        return CO_FAILED;
+    }
+
+    *pResource = new CoStreamingResource_T{ resource, scheduler->impl.get() };
+    return CO_SUCCESS;
+}
+
+
+void
+coStreamingSchedulerRemove(CoStreamingScheduler scheduler, CoStreamingResource resource)
+{
+    scheduler->impl->remove(resource->impl);
+    delete resource;
+}
+
+
+void
+coStreamingSchedulerRequest(CoStreamingScheduler scheduler, CoStreamingResource resource, float priority)
+{
+    scheduler->impl->request(resource->impl, priority);
+}
+
+
+CoResult
+coStreamingSchedulerUpdate(CoStreamingScheduler scheduler, CoUploadToken* pToken)
+{
+    auto token = scheduler->impl->update();
+    if (!token)
+    {
+        return CO_FAILED;
+    }
+
+    if (pToken)
+    {
+        *pToken = *token;
+    }
+
+    return CO_SUCCESS;
+}
+
+
+void
+coStreamingSchedulerGetStatistics(CoStreamingScheduler scheduler, CoStreamingSchedulerStatistics* pStatistics)
+{
+    *pStatistics = scheduler->impl->statistics();
+}
+
+
+uint32_t
+coStreamingResourceGetResidentMipLevel(CoStreamingResource resource)
+{
+    return resource->scheduler->residentMipLevel(resource->impl);
+}
+
+
+CoResult
+coStreamingResourceGetImageView(CoStreamingResource resource, CoImageView* pView)
+{
+    uint32_t baseMipLevel{ 0 };
+    uint32_t mipLevelCount{ 0 };
+
+    auto image = resource->scheduler->residentImage(resource->impl, baseMipLevel, mipLevelCount);
+    if (!image)
+    {
+        return CO_FAILED;
+    }
+
+    Coral::ImageViewConfig config{ baseMipLevel, mipLevelCount, 0, image->layerCount(), image->format() };
+    if (!image->createView(config))
+    {
+        return CO_FAILED;
+    }
+
+    *pView = new CoImageView_T{ image, config };
+    return CO_SUCCESS;
+}
+
+
+CoResult
+coStreamingResourceGetBuffer(CoStreamingResource resource, CoBuffer* pBuffer)
+{
+    auto buffer = resource->scheduler->residentBuffer(resource->impl);
+    if (!buffer)
+    {
+        return CO_FAILED;
+    }
+
+    *pBuffer = new CoBuffer_T{ buffer };
+    return CO_SUCCESS;
+}
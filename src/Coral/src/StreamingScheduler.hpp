@@ -0,0 +1,171 @@
+#ifndef CORAL_STREAMINGSCHEDULER_HPP
+#define CORAL_STREAMINGSCHEDULER_HPP
+
+#include <Coral/StreamingScheduler.h>
+
+#include "Buffer.hpp"
+#include "CoralFwd.hpp"
+#include "Image.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+namespace Coral
+{
+
+/*!
+ * Priority-driven residency manager streaming images and buffers through the upload queue of a context
+ *
+ * Each update processes the requested resources in rounds: every round uploads the next mip level (or the buffer) of
+ * each incompletely resident resource in order of priority. Updates stop once the per-frame byte budget is exhausted.
+ * Resources are evicted in order of their last request before a resource is created that would exceed the memory
+ * budget.
+ */
+class CORAL_API StreamingScheduler
+{
+public:
+
+    using CreateConfig = CoStreamingSchedulerCreateConfig;
+
+    struct Resource;
+
+    using ResourcePtr = std::shared_ptr<Resource>;
+
+    StreamingScheduler(Context& context, UploadQueue& uploadQueue, const CreateConfig& config);
+
+    /*!
+     * \brief Register a streamed image
+     * \return The resource or an empty pointer if the mip level data does not match the image configuration
+     */
+    ResourcePtr addImage(const Image::CreateConfig& config, std::vector<std::span<const std::byte>> mipLevelData);
+
+    /*!
+     * \brief Register a streamed buffer
+     * \return The resource or an empty pointer if the data size does not match the buffer configuration
+     */
+    ResourcePtr addBuffer(const Buffer::CreateConfig& config, std::span<const std::byte> data);
+
+    /*!
+     * \brief Remove the resource from the scheduler
+     */
+    void remove(const ResourcePtr& resource);
+
+    /*!
+     * \brief Request the residency of the resource for the current frame
+     */
+    void request(const ResourcePtr& resource, float priority);
+
+    /*!
+     * \brief Enqueue the uploads of the current frame and start a new frame
+     * \return The upload token of the enqueued uploads (0 if nothing was uploaded) or an empty optional if the uploads
+     *         could not be enqueued
+     */
+    std::optional<CoUploadToken> update();
+
+    /*!
+     * \brief Get the current statistics
+     */
+    CoStreamingSchedulerStatistics statistics() const;
+
+    /*!
+     * \brief Get the first resident mip level of the resource
+     */
+    uint32_t residentMipLevel(const ResourcePtr& resource);
+
+    /*!
+     * \brief Get the image of the resource and the range of its resident mip levels
+     * \return The image or an empty pointer if no mip level is resident
+     */
+    ImagePtr residentImage(const ResourcePtr& resource, uint32_t& baseMipLevel, uint32_t& mipLevelCount);
+
+    /*!
+     * \brief Get the buffer of the resource
+     * \return The buffer or an empty pointer if the buffer is not resident
+     */
+    BufferPtr residentBuffer(const ResourcePtr& resource);
+
+    struct Resource
+    {
+        /// The image configuration of streamed images
+        std::optional<Image::CreateConfig> imageConfig;
+
+        /// The buffer configuration of streamed buffers
+        std::optional<Buffer::CreateConfig> bufferConfig;
+
+        /// The source data of each mip level of images or the data of buffers
+        std::vector<std::span<const std::byte>> data;
+
+        ImagePtr image;
+
+        BufferPtr buffer;
+
+        /// Upload tokens of each entry of data. 0 if the data was not uploaded since the resource was streamed in or if
+        /// the upload failed.
+        std::vector<CoUploadToken> tokens;
+
+        /// Index of the first entry of data whose upload finished. All following entries finished as well.
+        uint32_t residentLevel{ 0 };
+
+        /// Number of bytes of device memory of the resource
+        uint64_t size{ 0 };
+
+        float priority{ 0.0f };
+
+        /// Frame of the last request
+        uint64_t lastRequestFrame{ 0 };
+
+        /// Flag indicating if the upload of an entry failed. Failed resources are not streamed anymore.
+        bool failed{ false };
+    };
+
+private:
+
+    /// Update the resident levels of the streamed resources whose uploads finished
+    void updateResidency(Resource& resource);
+
+    /// Evict the least recently requested resources until \p size bytes fit into the memory budget
+    bool makeRoom(uint64_t size);
+
+    /// Release the image or buffer of the resource
+    void evict(Resource& resource);
+
+    /// Enqueue the upload of the next entry of the resource's data, creating the image or buffer if needed
+    bool uploadNext(Resource& resource, CoUploadToken& token);
+
+    Context& mContext;
+
+    UploadQueue& mUploadQueue;
+
+    CreateConfig mConfig{};
+
+    std::unordered_set<ResourcePtr> mResources;
+
+    /// Index of the current frame. Starts at 1 so that resources never requested are the least recently used ones.
+    uint64_t mFrame{ 1 };
+
+    CoStreamingSchedulerStatistics mStatistics{};
+
+    mutable std::mutex mProtection;
+
+}; // class StreamingScheduler
+
+} // namespace Coral
+
+struct CoStreamingScheduler_T
+{
+    std::unique_ptr<Coral::StreamingScheduler> impl;
+};
+
+struct CoStreamingResource_T
+{
+    Coral::StreamingScheduler::ResourcePtr impl;
+
+    Coral::StreamingScheduler* scheduler{ nullptr };
+};
+
+#endif // !CORAL_STREAMINGSCHEDULER_HPP
@@ -0,0 +1,101 @@
+#include <Coral/UploadQueue.h>
+
+#include "UploadQueue.hpp"
+#include "Context.hpp"
+
+#include <span>
+
+using namespace Coral;
+
+
+CoResult
+coContextGetUploadQueue(CoContext context, CoUploadQueue* pQueue)
+{
+    auto impl = context->impl->getUploadQueue();
+    if (!impl)
+    {
+        return CO_FAILED;
+    }
+
+    if (!context->m_uploadQueue)
+    {
+        context->m_uploadQueue = std::make_unique<CoUploadQueue_T>(impl);
+    }
+
+    *pQueue = context->m_uploadQueue.get();
+
+    return CO_SUCCESS;
+}
+
+
+CoResult
+coUploadQueueUpdateBufferData(CoUploadQueue queue, const CoUpdateBufferDataInfo* pInfo, CoUploadToken* pToken)
+{
+    Coral::UpdateBufferDataInfo info{};
+    info.buffer = pInfo->buffer->impl;
+    info.data   = std::as_bytes(std::span(pInfo->pData, pInfo->dataCount));
+    info.offset = pInfo->offset;
+
+    auto token = queue->impl->updateBufferData(info);
+    if (!token)
+    {
+        return CO_FAILED;
+    }
+
+    *pToken = *token;
+    return CO_SUCCESS;
+}
+
+
+CoResult
+coUploadQueueUpdateImageData(CoUploadQueue queue, const CoUpdateImageDataInfo* pInfo, CoUploadToken* pToken)
+{
+    Coral::UpdateImageDataInfo info{};
+    info.image         = pInfo->image->impl;
+    info.data          = std::as_bytes(std::span(pInfo->pData, pInfo->dataCount));
+    info.mipLevel      = pInfo->mipLevel;
+    info.offsetX       = pInfo->offsetX;
+    info.offsetY       = pInfo->offsetY;
+    info.extent        = pInfo->extent;
+    info.rowPitch      = pInfo->rowPitch;
+    info.mipLevelCount = pInfo->mipLevelCount;
+    info.arrayLayer    = pInfo->arrayLayer;
+    info.layerCount    = pInfo->layerCount;
+
+    auto token = queue->impl->updateImageData(info);
+    if (!token)
+    {
+        return CO_FAILED;
+    }
+
+    *pToken = *token;
+    return CO_SUCCESS;
+}
+
+
+CoResult
+coUploadQueueFlush(CoUploadQueue queue)
+{
+    return queue->impl->flush() ? CO_SUCCESS : CO_FAILED;
+}
+
+
+bool
+coUploadQueueIsComplete(CoUploadQueue queue, CoUploadToken token)
+{
+    return queue->impl->isComplete(token);
+}
+
+
+bool
+coUploadQueueIsFailed(CoUploadQueue queue, CoUploadToken token)
+{
+    return queue->impl->isFailed(token);
+}
+
+
+CoResult
+coUploadQueueWait(CoUploadQueue queue, CoUploadToken token, uint64_t timeout)
+{
+    return static_cast<CoResult>(queue->impl->wait(token, timeout));
+}
@@ -0,0 +1,74 @@
+#ifndef CORAL_UPLOADQUEUE_HPP
+#define CORAL_UPLOADQUEUE_HPP
+
+#include <Coral/UploadQueue.h>
+
+#include "CommandBuffer.hpp"
+
+#include <optional>
+
+namespace Coral
+{
+
+/*!
+ * Context-wide queue batching buffer and image uploads into transfer submissions
+ */
+class CORAL_API UploadQueue
+{
+public:
+
+    enum class WaitResult
+    {
+        SUCCESS        = CO_SUCCESS,
+        FAILED         = CO_FAILED,
+        TIMEOUT        = CO_ERROR_TIMEOUT,
+        INTERNAL_ERROR = CO_ERROR_INTERNAL,
+    };
+
+    virtual ~UploadQueue() = default;
+
+    /*!
+     * \brief Enqueue an update of the buffer data
+     * \return The token of the upload or an empty optional if the update parameters are invalid
+     */
+    virtual std::optional<CoUploadToken> updateBufferData(const UpdateBufferDataInfo& info) = 0;
+
+    /*!
+     * \brief Enqueue an update of the image data
+     * \return The token of the upload or an empty optional if the update parameters are invalid
+     */
+    virtual std::optional<CoUploadToken> updateImageData(const UpdateImageDataInfo& info) = 0;
+
+    /*!
+     * \brief Submit all enqueued uploads
+     */
+    virtual bool flush() = 0;
+
+    /*!
+     * \brief Check if the uploads identified by the token have finished
+     * \return False if the uploads are pending or their batch failed to be submitted
+     */
+    virtual bool isComplete(CoUploadToken token) = 0;
+
+    /*!
+     * \brief Check if the batch of the uploads identified by the token failed to be submitted
+     */
+    virtual bool isFailed(CoUploadToken token) = 0;
+
+    /*!
+     * \brief Block until the uploads identified by the token have finished or the timeout (in nanoseconds) is reached
+     * \return FAILED if the batch of the uploads failed to be submitted
+     */
+    virtual WaitResult wait(CoUploadToken token, uint64_t timeout) = 0;
+
+}; // class UploadQueue
+
+} // namespace Coral
+
+struct CoUploadQueue_T
+{
+    // The UploadQueue is owned by the Context
+    Coral::UploadQueue* impl{ nullptr };
+};
+
+#endif // !CORAL_UPLOADQUEUE_HPP
@@ -2,11 +2,19 @@
 
 #include "VulkanFormat.hpp"
 
+#include <bit>
+#include <cstdint>
+
 using namespace Coral::Vulkan;
 
 BufferImpl::~BufferImpl()
 {
-    if (mBuffer != VK_NULL_HANDLE)
+    if (mDeviceMemory != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(context().getVkDevice(), mBuffer, nullptr);
+        vkFreeMemory(context().getVkDevice(), mDeviceMemory, nullptr);
+    }
+    else if (mBuffer != VK_NULL_HANDLE)
     {
         vmaDestroyBuffer(context().getVmaAllocator(), mBuffer, mAllocation);
     }
@@ -21,16 +29,23 @@ BufferImpl::init(const Coral::Buffer::CreateConfig& config)
         return Coral::Buffer::CreateError::INVALID_SIZE;
     }
 
+    if (config.exportable)
+    {
+        return initExternal(config, nullptr);
+    }
+
     mType       = config.type;
     mSize       = config.size;
     mCpuVisible = config.cpuVisible;
 
-    uint32_t queueFamilyIndex = context().getQueueFamilyIndex();
+    // Buffers are shared with a dedicated transfer queue family without queue family ownership transfers
+    auto queueFamilyIndices = context().getQueueFamilyIndices();
 
     VkBufferCreateInfo createInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-    createInfo.pQueueFamilyIndices   = &queueFamilyIndex;
-    createInfo.queueFamilyIndexCount = 1;
-    createInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.pQueueFamilyIndices   = queueFamilyIndices.data();
+    createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilyIndices.size());
+    createInfo.sharingMode           = queueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT
+                                                                     : VK_SHARING_MODE_EXCLUSIVE;
     createInfo.size                  = mSize;
     createInfo.usage                 = convert(mType);
 
@@ -56,6 +71,160 @@ BufferImpl::init(const Coral::Buffer::CreateConfig& config)
 }
 
 
+std::optional<Coral::Buffer::CreateError>
+BufferImpl::init(const Coral::Buffer::CreateConfig& config, const CoExternalMemoryHandle& handle)
+{
+    if (config.size == 0)
+    {
+        return Coral::Buffer::CreateError::INVALID_SIZE;
+    }
+
+    return initExternal(config, &handle);
+}
+
+
+std::optional<Coral::Buffer::CreateError>
+BufferImpl::initExternal(const Coral::Buffer::CreateConfig& config, const CoExternalMemoryHandle* importHandle)
+{
+    // Memory shared with other processes cannot be sub-allocated by VMA, hence the buffer owns its memory directly
+    mType       = config.type;
+    mSize       = config.size;
+    mCpuVisible = config.cpuVisible;
+    mExportable = importHandle == nullptr;
+
+    auto device = context().getVkDevice();
+
+    VkExternalMemoryBufferCreateInfo externalCreateInfo{ VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+    externalCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+    auto queueFamilyIndices = context().getQueueFamilyIndices();
+
+    VkBufferCreateInfo createInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    createInfo.pNext                 = &externalCreateInfo;
+    createInfo.pQueueFamilyIndices   = queueFamilyIndices.data();
+    createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilyIndices.size());
+    createInfo.sharingMode           = queueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT
+                                                                     : VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.size                  = mSize;
+    createInfo.usage                 = convert(mType);
+
+    if (vkCreateBuffer(device, &createInfo, nullptr, &mBuffer) != VK_SUCCESS)
+    {
+        return Coral::Buffer::CreateError::INTERNAL_ERROR;
+    }
+
+    VkMemoryRequirements requirements{};
+    vkGetBufferMemoryRequirements(device, mBuffer, &requirements);
+
+    VkMemoryPropertyFlags properties = mCpuVisible ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                                                   : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    mDeviceMemory = context().allocateExternalMemory(requirements, properties, mBuffer, VK_NULL_HANDLE, importHandle);
+    if (mDeviceMemory == VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(device, mBuffer, nullptr);
+        mBuffer = VK_NULL_HANDLE;
+        return Coral::Buffer::CreateError::INTERNAL_ERROR;
+    }
+
+    mDeviceMemorySize = importHandle ? importHandle->size : requirements.size;
+
+    if (vkBindBufferMemory(device, mBuffer, mDeviceMemory, 0) != VK_SUCCESS)
+    {
+        return Coral::Buffer::CreateError::INTERNAL_ERROR;
+    }
+
+    return {};
+}
+
+
+std::optional<Coral::Buffer::CreateError>
+BufferImpl::initFromHostMemory(const std::byte* hostPointer, size_t size)
+{
+    auto alignment = context().getMinImportedHostPointerAlignment();
+    if (alignment == 0 || size == 0 || size % alignment != 0 || reinterpret_cast<uintptr_t>(hostPointer) % alignment != 0)
+    {
+        return Coral::Buffer::CreateError::INVALID_SIZE;
+    }
+
+    // Imported buffers are only used as source of copy operations
+    mType       = 0;
+    mSize       = size;
+    mCpuVisible = false;
+
+    auto device = context().getVkDevice();
+    auto handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT;
+
+    //-------------------------------------------------------------
+    // Create the buffer
+    //-------------------------------------------------------------
+    VkExternalMemoryBufferCreateInfo externalCreateInfo{ VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO };
+    externalCreateInfo.handleTypes = handleType;
+
+    auto queueFamilyIndices = context().getQueueFamilyIndices();
+
+    VkBufferCreateInfo createInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+    createInfo.pNext                 = &externalCreateInfo;
+    createInfo.pQueueFamilyIndices   = queueFamilyIndices.data();
+    createInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilyIndices.size());
+    createInfo.sharingMode           = queueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT
+                                                                     : VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.size                  = mSize;
+    createInfo.usage                 = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    if (vkCreateBuffer(device, &createInfo, nullptr, &mBuffer) != VK_SUCCESS)
+    {
+        return Coral::Buffer::CreateError::INTERNAL_ERROR;
+    }
+
+    //-------------------------------------------------------------
+    // Find a memory type that is compatible with both the buffer and the host pointer
+    //-------------------------------------------------------------
+    VkMemoryHostPointerPropertiesEXT hostPointerProperties{ VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT };
+    if (vkGetMemoryHostPointerPropertiesEXT(device, handleType, hostPointer, &hostPointerProperties) != VK_SUCCESS)
+    {
+        vkDestroyBuffer(device, mBuffer, nullptr);
+        mBuffer = VK_NULL_HANDLE;
+        return Coral::Buffer::CreateError::INTERNAL_ERROR;
+    }
+
+    VkMemoryRequirements requirements{};
+    vkGetBufferMemoryRequirements(device, mBuffer, &requirements);
+
+    auto memoryTypeBits = requirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+    if (memoryTypeBits == 0 || requirements.size > mSize)
+    {
+        vkDestroyBuffer(device, mBuffer, nullptr);
+        mBuffer = VK_NULL_HANDLE;
+        return Coral::Buffer::CreateError::INTERNAL_ERROR;
+    }
+
+    //-------------------------------------------------------------
+    // Import the host memory and bind it to the buffer
+    //-------------------------------------------------------------
+    VkImportMemoryHostPointerInfoEXT importInfo{ VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT };
+    importInfo.handleType   = handleType;
+    importInfo.pHostPointer = const_cast<std::byte*>(hostPointer);
+
+    VkMemoryAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocateInfo.pNext           = &importInfo;
+    allocateInfo.allocationSize  = mSize;
+    allocateInfo.memoryTypeIndex = static_cast<uint32_t>(std::countr_zero(memoryTypeBits));
+
+    if (vkAllocateMemory(device, &allocateInfo, nullptr, &mDeviceMemory) != VK_SUCCESS ||
+        vkBindBufferMemory(device, mBuffer, mDeviceMemory, 0) != VK_SUCCESS)
+    {
+        vkDestroyBuffer(device, mBuffer, nullptr);
+        vkFreeMemory(device, mDeviceMemory, nullptr);
+        mBuffer       = VK_NULL_HANDLE;
+        mDeviceMemory = VK_NULL_HANDLE;
+        return Coral::Buffer::CreateError::INTERNAL_ERROR;
+    }
+
+    return {};
+}
+
+
 VkBuffer
 BufferImpl::getVkBuffer()
 {
@@ -68,7 +237,7 @@ size_t BufferImpl::size() const
     return mSize;
 }
 
-CoBufferType
+CoBufferTypeFlags
 BufferImpl::type() const
 {
     return mType;
@@ -91,9 +260,23 @@ BufferImpl::map()
 
     void* data{ nullptr };
 
-    if (vmaMapMemory(context().getVmaAllocator(), mAllocation, &data) != VK_SUCCESS)
+    if (mDeviceMemory != VK_NULL_HANDLE)
     {
-        return nullptr;
+        if (vkMapMemory(context().getVkDevice(), mDeviceMemory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS)
+        {
+            return nullptr;
+        }
+    }
+    else
+    {
+        if (vmaMapMemory(context().getVmaAllocator(), mAllocation, &data) != VK_SUCCESS)
+        {
+            return nullptr;
+        }
+
+        // CPU-visible buffers are allocated in host-cached memory which is not necessarily coherent. Make GPU writes 
+        // visible to the host (no-op for coherent memory)
+        vmaInvalidateAllocation(context().getVmaAllocator(), mAllocation, 0, VK_WHOLE_SIZE);
     }
 
     mMapped = (std::byte*)data;
@@ -110,7 +293,28 @@ BufferImpl::unmap()
     }
 
     mMapped = nullptr;
-    vmaUnmapMemory(context().getVmaAllocator(), mAllocation);
+    if (mDeviceMemory != VK_NULL_HANDLE)
+    {
+        vkUnmapMemory(context().getVkDevice(), mDeviceMemory);
+    }
+    else
+    {
+        // Make host writes visible to the GPU (no-op for coherent memory)
+        vmaFlushAllocation(context().getVmaAllocator(), mAllocation, 0, VK_WHOLE_SIZE);
+        vmaUnmapMemory(context().getVmaAllocator(), mAllocation);
+    }
 
     return true;
 }
+
+
+std::optional<CoExternalMemoryHandle>
+BufferImpl::exportMemory()
+{
+    if (!mExportable)
+    {
+        return {};
+    }
+
+    return context().exportExternalMemory(mDeviceMemory, mDeviceMemorySize);
+}
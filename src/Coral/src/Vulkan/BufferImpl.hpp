@@ -24,23 +24,44 @@ public:
 
     std::optional<Coral::Buffer::CreateError> init(const Buffer::CreateConfig& config);
 
+    /// Create a transfer source buffer that aliases the given host memory (VK_EXT_external_memory_host)
+    /**
+     * \p hostPointer and \p size must be multiples of ContextImpl::getMinImportedHostPointerAlignment(). The host
+     * memory must stay valid for the lifetime of the buffer.
+     */
+    std::optional<Coral::Buffer::CreateError> initFromHostMemory(const std::byte* hostPointer, size_t size);
+
+    /// Create the buffer with memory imported from an opaque file descriptor (VK_KHR_external_memory_fd)
+    std::optional<Coral::Buffer::CreateError> init(const Buffer::CreateConfig& config, const CoExternalMemoryHandle& handle);
+
     size_t size() const override;
 
-    CoBufferType type() const override;
+    CoBufferTypeFlags type() const override;
 
     std::byte* map() override;
 
     bool unmap() override;
 
+    std::optional<CoExternalMemoryHandle> exportMemory() override;
+
     VkBuffer getVkBuffer();
 
 private:
 
+    std::optional<Coral::Buffer::CreateError> initExternal(const Buffer::CreateConfig& config, const CoExternalMemoryHandle* importHandle);
+
     VkBuffer mBuffer{ VK_NULL_HANDLE };
 
     VmaAllocation mAllocation{ VK_NULL_HANDLE };
 
-    CoBufferType mType{ CO_BUFFER_TYPE_STORAGE };
+    /// Device memory of buffers not allocated through VMA (e.g. imported memory)
+    VkDeviceMemory mDeviceMemory{ VK_NULL_HANDLE };
+
+    VkDeviceSize mDeviceMemorySize{ 0 };
+
+    bool mExportable{ false };
+
+    CoBufferTypeFlags mType{ CO_BUFFER_TYPE_STORAGE };
 
     size_t mSize{ 0 };
 
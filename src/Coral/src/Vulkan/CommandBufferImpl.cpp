@@ -4,11 +4,18 @@
 #include "Vulkan/CommandQueueImpl.hpp"
 #include "Vulkan/FramebufferImpl.hpp"
 #include "Vulkan/ImageImpl.hpp"
+#include "Vulkan/MipGenerator.hpp"
 #include "Vulkan/PipelineStateImpl.hpp"
 #include "Vulkan/SamplerImpl.hpp"
+#include "Vulkan/VulkanFormat.hpp"
 
+#include "CompletionToken.hpp"
+#include "Readback.hpp"
 #include "Visitor.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <optional>
 #include <ranges>
 #include <vector>
@@ -47,6 +54,249 @@ convert(CoClearOp clearOp)
     }
 }
 
+
+VkAttachmentStoreOp
+convert(CoStoreOp storeOp)
+{
+    switch (storeOp)
+    {
+    case CO_STORE_OP_STORE:     return VK_ATTACHMENT_STORE_OP_STORE;
+    case CO_STORE_OP_DONT_CARE: return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    case CO_STORE_OP_NONE:      return VK_ATTACHMENT_STORE_OP_NONE;
+    default:
+        assert(false);
+        return VK_ATTACHMENT_STORE_OP_STORE;
+    }
+}
+
+
+
+VkImageAspectFlags
+copyAspectMask(CoPixelFormat format)
+{
+    // Copies can only address a single aspect of depth/stencil images. Coral only copies the depth values.
+    return isDepthFormat(format) ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+}
+
+
+VkImageAspectFlags
+imageCopyAspectMask(CoPixelFormat format)
+{
+    // Image to image copies can address depth and stencil aspects at once
+    VkImageAspectFlags aspectMask = copyAspectMask(format);
+    if (isStencilFormat(format))
+    {
+        aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    return aspectMask;
+}
+
+
+VkImageSubresourceLayers
+convert(const CoImageSubresource& subresource, VkImageAspectFlags aspectMask)
+{
+    VkImageSubresourceLayers layers{};
+    layers.aspectMask     = aspectMask;
+    layers.mipLevel       = subresource.mipLevel;
+    layers.baseArrayLayer = subresource.baseArrayLayer;
+    layers.layerCount     = std::max(subresource.layerCount, 1u);
+    return layers;
+}
+
+
+VkOffset3D
+convert(const CoOffset3D& offset)
+{
+    return { offset.x, offset.y, offset.z };
+}
+
+
+VkExtent3D
+convert(const CoExtent3D& extent)
+{
+    return { extent.width, extent.height, std::max(extent.depth, 1u) };
+}
+
+
+bool
+isRegionBlockAligned(CoPixelFormat format, 
+                     uint32_t mipWidth, 
+                     uint32_t mipHeight, 
+                     uint32_t x, 
+                     uint32_t y, 
+                     uint32_t width, 
+                     uint32_t height)
+{
+    // Regions of block-compressed images must start at a block boundary and cover whole blocks unless they end at the
+    // border of the mip level
+    auto block = coPixelFormatGetBlockExtent(format);
+
+    return x % block.width == 0 && y % block.height == 0 &&
+           (width % block.width == 0 || x + width == mipWidth) &&
+           (height % block.height == 0 || y + height == mipHeight);
+}
+
+
+bool
+isRegionInside(const Coral::Image& image, 
+               const VkImageSubresourceLayers& subresource, 
+               const VkOffset3D& offset, 
+               const VkExtent3D& extent)
+{
+    auto mipLevel = subresource.mipLevel;
+    if (mipLevel >= image.getMipLevels() || subresource.layerCount == 0 ||
+        subresource.baseArrayLayer + subresource.layerCount > image.layerCount())
+    {
+        return false;
+    }
+
+    uint32_t mipWidth  = std::max(image.width() >> mipLevel, 1u);
+    uint32_t mipHeight = std::max(image.height() >> mipLevel, 1u);
+    uint32_t mipDepth  = std::max(image.depth() >> mipLevel, 1u);
+
+    if (offset.x < 0 || offset.y < 0 || offset.z < 0 || extent.width == 0 || extent.height == 0 || extent.depth == 0 ||
+        uint32_t(offset.x) + extent.width > mipWidth || uint32_t(offset.y) + extent.height > mipHeight ||
+        uint32_t(offset.z) + extent.depth > mipDepth)
+    {
+        return false;
+    }
+
+    return isRegionBlockAligned(image.format(), mipWidth, mipHeight, offset.x, offset.y, extent.width, extent.height);
+}
+
+
+/// Layers of a mip level addressed by a copy
+struct LayerRange
+{
+    VkImageSubresourceLayers subresource;
+    int32_t offsetZ;
+    uint32_t depth;
+};
+
+
+std::optional<LayerRange>
+getLayerRange(const Coral::Image& image, 
+              uint32_t mipLevel, 
+              uint32_t arrayLayer, 
+              uint32_t layerCount, 
+              VkImageAspectFlags aspectMask)
+{
+    // Layers of 3D images are the depth slices of the mip level
+    bool is3D   = image.type() == CO_IMAGE_TYPE_3D;
+    auto layers = is3D ? std::max(image.depth() >> mipLevel, 1u) : image.layerCount();
+
+    if (mipLevel >= image.getMipLevels() || layerCount == 0 || arrayLayer >= layers || layerCount > layers - arrayLayer)
+    {
+        return std::nullopt;
+    }
+
+    CoImageSubresource subresource{ mipLevel, is3D ? 0 : arrayLayer, is3D ? 1 : layerCount };
+
+    LayerRange range{};
+    range.subresource = ::convert(subresource, aspectMask);
+    range.offsetZ     = is3D ? static_cast<int32_t>(arrayLayer) : 0;
+    range.depth       = is3D ? layerCount : 1;
+
+    return range;
+}
+
+
+/// Accesses that must be made available before subsequent accesses
+constexpr VkAccessFlags2 writeAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT |
+                                           VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+                                           VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+                                           VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                           VK_ACCESS_2_TRANSFER_WRITE_BIT |
+                                           VK_ACCESS_2_HOST_WRITE_BIT |
+                                           VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+
+bool
+isWriteAccess(VkAccessFlags2 accessMask)
+{
+    return (accessMask & writeAccessMask) != 0;
+}
+
+
+VkImageLayout
+depthAttachmentLayout(CoPixelFormat format)
+{
+    return isStencilFormat(format) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL 
+                                   : VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+}
+
+
+bool
+isIntegerFormat(CoPixelFormat format)
+{
+    switch (format)
+    {
+        case CO_PIXEL_FORMAT_RGBA32_I:
+        case CO_PIXEL_FORMAT_RGB32_I:
+        case CO_PIXEL_FORMAT_RG32_I:
+        case CO_PIXEL_FORMAT_R32_I:
+        case CO_PIXEL_FORMAT_RGBA32_UI:
+        case CO_PIXEL_FORMAT_RGB32_UI:
+        case CO_PIXEL_FORMAT_RG32_UI:
+        case CO_PIXEL_FORMAT_R32_UI:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+VkAccessFlags2
+shaderAccessMask(VkImageLayout preferredLayout)
+{
+    // Images preferring the general layout are storage images, which shaders read and write
+    if (preferredLayout == VK_IMAGE_LAYOUT_GENERAL)
+    {
+        return VK_ACCESS_2_SHADER_SAMPLED_READ_BIT |
+               VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+               VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    }
+
+    return VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+}
+
+
+bool
+isValidResolveTarget(const Coral::Vulkan::ImageImpl& resolve, CoPixelFormat format, uint32_t width, uint32_t height)
+{
+    return resolve.sampleCount() == 1 &&
+           resolve.format() == format &&
+           resolve.width() == width &&
+           resolve.height() == height &&
+           resolve.type() == CO_IMAGE_TYPE_2D &&
+           resolve.getMipLevels() == 1;
+}
+
+
+/// Restrict the stages and accesses of a barrier to those supported by transfer-only queues
+template<typename Barrier>
+void
+restrictToTransferStages(Barrier& barrier)
+{
+    constexpr VkPipelineStageFlags2 stages = VK_PIPELINE_STAGE_2_TRANSFER_BIT |
+                                             VK_PIPELINE_STAGE_2_COPY_BIT |
+                                             VK_PIPELINE_STAGE_2_CLEAR_BIT |
+                                             VK_PIPELINE_STAGE_2_HOST_BIT |
+                                             VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+    constexpr VkAccessFlags2 accesses = VK_ACCESS_2_TRANSFER_READ_BIT |
+                                        VK_ACCESS_2_TRANSFER_WRITE_BIT |
+                                        VK_ACCESS_2_HOST_READ_BIT |
+                                        VK_ACCESS_2_HOST_WRITE_BIT |
+                                        VK_ACCESS_2_MEMORY_READ_BIT |
+                                        VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+    barrier.srcStageMask  &= stages;
+    barrier.srcAccessMask  = barrier.srcStageMask != 0 ? barrier.srcAccessMask & accesses : VK_ACCESS_2_NONE;
+    barrier.dstStageMask  &= stages;
+    barrier.dstAccessMask  = barrier.dstStageMask != 0 ? barrier.dstAccessMask & accesses : VK_ACCESS_2_NONE;
+}
+
 } // namespace
 
 CommandBufferImpl::CommandBufferImpl(CommandQueueImpl& commandQueue)
@@ -58,6 +308,13 @@ CommandBufferImpl::CommandBufferImpl(CommandQueueImpl& commandQueue)
 
 CommandBufferImpl::~CommandBufferImpl()
 {
+    // Tokens of commands that were never submitted are completed right away since the tracked memory is not accessed
+    // anymore. They are marked as failed since the commands were never executed.
+    for (auto& token : mCompletionTokens)
+    {
+        token->complete(false);
+    }
+
     if (mCommandBuffer != VK_NULL_HANDLE)
     {
         vkFreeCommandBuffers(context().getVkDevice(), mCommandPool, 1, &mCommandBuffer);
@@ -70,10 +327,17 @@ CommandBufferImpl::~CommandBufferImpl()
 
 bool
 CommandBufferImpl::init(const Coral::CommandBuffer::CreateConfig& config)
+{
+    return init(config, mCommandQueue.getVkCommandPool());
+}
+
+
+bool
+CommandBufferImpl::init(const Coral::CommandBuffer::CreateConfig& config, VkCommandPool commandPool)
 {
     mName             = config.name ? config.name : "";
     mRetainReferences = config.retainReferences;
-    mCommandPool      = mCommandQueue.getVkCommandPool();
+    mCommandPool      = commandPool;
 
     auto device  = context().getVkDevice();
 
@@ -93,6 +357,27 @@ CommandBufferImpl::init(const Coral::CommandBuffer::CreateConfig& config)
 bool
 CommandBufferImpl::begin()
 {
+    // Image states are tracked per recording
+    mTrackedImages.clear();
+    mPendingImageBarriers.clear();
+    mPendingBufferBarriers.clear();
+    mPendingMemoryBarriers.clear();
+    mBarrierBatch++;
+    mShaderStorageWriteStages = 0;
+
+    // Commands of a previous recording that was never submitted are discarded by recording again. Fail their tokens
+    // instead of completing them with an unrelated submission.
+    for (auto& token : mCompletionTokens)
+    {
+        token->complete(false);
+    }
+    mCompletionTokens.clear();
+
+    // Pipeline bindings do not persist across recordings
+    mLastBoundPipelineState        = nullptr;
+    mLastBoundComputePipelineState = nullptr;
+    mInsideRenderPass              = false;
+
     VkCommandBufferBeginInfo info{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
     
     return vkBeginCommandBuffer(mCommandBuffer, &info) == VK_SUCCESS;
@@ -102,6 +387,56 @@ CommandBufferImpl::begin()
 bool
 CommandBufferImpl::end()
 {
+    flushBarriers();
+
+    // Return all used mip levels into the layout expected by subsequent command buffers and make their writes visible
+    // to all subsequent commands. The transitions of all images are recorded with a single barrier.
+    for (auto& [_, tracked] : mTrackedImages)
+    {
+        for (uint32_t level = 0; level < tracked.mipLevels.size(); ++level)
+        {
+            const auto& state = tracked.mipLevels[level];
+            if (state && (state->layout != tracked.finalLayout || ::isWriteAccess(state->accessMask)))
+            {
+                transitionMipLevel(tracked,
+                                   level,
+                                   tracked.finalLayout,
+                                   VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                   VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT);
+            }
+        }
+    }
+
+    flushBarriers();
+
+    // Release the used mip levels of shared images to other processes. The release is recorded after the transitions
+    // above and keeps the layout, since the acquiring side expects the preferred layout and cannot know the layout the
+    // mip levels were used in.
+    for (auto& [_, tracked] : mTrackedImages)
+    {
+        if (!tracked.image->isShared())
+        {
+            continue;
+        }
+
+        for (uint32_t level = 0; level < tracked.mipLevels.size(); ++level)
+        {
+            if (!tracked.mipLevels[level])
+            {
+                continue;
+            }
+
+            auto& release = mPendingImageBarriers.emplace_back(
+                tracked.image->createLayoutBarrier(level, 1, tracked.finalLayout, tracked.finalLayout));
+            release.srcStageMask        = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            release.srcAccessMask       = VK_ACCESS_2_MEMORY_WRITE_BIT;
+            release.srcQueueFamilyIndex = mCommandQueue.getQueueFamilyIndex();
+            release.dstQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL;
+        }
+    }
+
+    flushBarriers();
+
     return vkEndCommandBuffer(mCommandBuffer) == VK_SUCCESS;
 }
 
@@ -109,7 +444,7 @@ CommandBufferImpl::end()
 bool
 CommandBufferImpl::cmdBeginRenderPass(const Coral::BeginRenderPassInfo& info)
 {
-    if (info.framebuffer == nullptr)
+    if (info.framebuffer == nullptr || mCommandQueue.isTransferOnly())
     {
         return false;
     }
@@ -124,8 +459,17 @@ CommandBufferImpl::cmdBeginRenderPass(const Coral::BeginRenderPassInfo& info)
         return false;
     }
 
+    // Only multisampled attachments can be resolved
+    if (framebuffer->sampleCount() == 1 && (!info.resolveImages.empty() || info.depthResolveImage))
+    {
+        return false;
+    }
+
+    std::vector<ImageImplPtr> resolveImages;
+    auto depthResolveImage = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(info.depthResolveImage);
+
     std::vector<VkRenderingAttachmentInfo> attachments;
-    for (const auto& [attachment, image] : colorAttachments)
+    for (const auto& [attachment, color] : colorAttachments)
     {
         VkRenderingAttachmentInfo attachmentInfo{ VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO };
  
@@ -141,15 +485,38 @@ CommandBufferImpl::cmdBeginRenderPass(const Coral::BeginRenderPassInfo& info)
         attachmentInfo.clearValue.color.float32[2] = clearColor->second.color[2];
         attachmentInfo.clearValue.color.float32[3] = clearColor->second.color[3];
 
-        attachmentInfo.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
-        attachmentInfo.imageLayout      = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR;
-        attachmentInfo.imageView        = image->getVkImageView();
+        attachmentInfo.storeOp          = ::convert(clearColor->second.storeOp);
+        attachmentInfo.imageLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        attachmentInfo.imageView        = color.imageView;
         attachmentInfo.resolveMode      = VK_RESOLVE_MODE_NONE;
         attachmentInfo.resolveImageView = VK_NULL_HANDLE;
 
+        if (auto resolve = info.resolveImages.find(attachment); resolve != info.resolveImages.end())
+        {
+            auto resolveImage = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(resolve->second);
+            if (!::isValidResolveTarget(*resolveImage, color.view.format, framebuffer->width(), framebuffer->height()))
+            {
+                return false;
+            }
+
+            // Integer formats cannot be averaged. The store op of the multisampled contents is applied independently of
+            // the resolve.
+            attachmentInfo.resolveMode        = ::isIntegerFormat(color.view.format) ? VK_RESOLVE_MODE_SAMPLE_ZERO_BIT
+                                                                                     : VK_RESOLVE_MODE_AVERAGE_BIT;
+            attachmentInfo.resolveImageView   = resolveImage->getVkImageView();
+            attachmentInfo.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+            resolveImages.push_back(resolveImage);
+        }
+
         attachments.push_back(attachmentInfo);
     }
 
+    if (info.resolveImages.size() != resolveImages.size())
+    {
+        return false;
+    }
+
     VkRenderingInfo renderingInfo{ VK_STRUCTURE_TYPE_RENDERING_INFO };
     renderingInfo.colorAttachmentCount     = static_cast<uint32_t>(attachments.size());
     renderingInfo.pColorAttachments        = attachments.data();
@@ -168,24 +535,121 @@ CommandBufferImpl::cmdBeginRenderPass(const Coral::BeginRenderPassInfo& info)
             return false;
         }
 
-        auto image = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(depthAttachment);
-
         // Clear the depth attachment
         depthAttachmentInfo.loadOp                          = ::convert(info.clearDepth->clearOp);
         depthAttachmentInfo.clearValue.depthStencil.depth   = info.clearDepth->depth;
         depthAttachmentInfo.clearValue.depthStencil.stencil = info.clearDepth->stencil;
 
-        depthAttachmentInfo.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
-        depthAttachmentInfo.imageLayout      = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL;
-        depthAttachmentInfo.imageView        = image->getVkImageView();
+        depthAttachmentInfo.storeOp          = ::convert(info.clearDepth->storeOp);
+        depthAttachmentInfo.imageLayout      = ::depthAttachmentLayout(depthAttachment->view.format);
+        depthAttachmentInfo.imageView        = depthAttachment->imageView;
         depthAttachmentInfo.resolveMode      = VK_RESOLVE_MODE_NONE;
         depthAttachmentInfo.resolveImageView = VK_NULL_HANDLE;
 
-        renderingInfo.pDepthAttachment   = &depthAttachmentInfo;
-        renderingInfo.pStencilAttachment = &depthAttachmentInfo;
+        if (depthResolveImage)
+        {
+            if (!::isValidResolveTarget(*depthResolveImage,
+                                        depthAttachment->view.format,
+                                        framebuffer->width(),
+                                        framebuffer->height()))
+            {
+                return false;
+            }
+
+            // Sample zero is the only depth-stencil resolve mode every implementation supports
+            depthAttachmentInfo.resolveMode        = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT;
+            depthAttachmentInfo.resolveImageView   = depthResolveImage->getVkImageView();
+            depthAttachmentInfo.resolveImageLayout = depthAttachmentInfo.imageLayout;
+        }
+
+        renderingInfo.pDepthAttachment = &depthAttachmentInfo;
+
+        // Formats without a stencil aspect must not be used as stencil attachment
+        if (isStencilFormat(depthAttachment->view.format))
+        {
+            renderingInfo.pStencilAttachment = &depthAttachmentInfo;
+        }
+    }
+    else if (depthResolveImage)
+    {
+        return false;
+    }
+
+    // Barriers cannot be recorded within the render pass. Transition the attachments and make prior writes to images
+    // sampled during the render pass visible before rendering starts. Only the mip levels rendered into are excluded,
+    // hence other mip levels of an attachment can be sampled during the render pass.
+    std::vector<ImageMipLevel> attachmentMipLevels;
+    for (const auto& [_, color] : colorAttachments)
+    {
+        useImage(color.image,
+                 color.view.baseMipLevel,
+                 1,
+                 VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                 VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                 VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+        attachmentMipLevels.emplace_back(color.image.get(), color.view.baseMipLevel);
+    }
+
+    if (depthAttachment)
+    {
+        useImage(depthAttachment->image,
+                 depthAttachment->view.baseMipLevel,
+                 1,
+                 ::depthAttachmentLayout(depthAttachment->view.format),
+                 VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                 VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        attachmentMipLevels.emplace_back(depthAttachment->image.get(), depthAttachment->view.baseMipLevel);
+
+        if (depthResolveImage)
+        {
+            // Depth-stencil resolves are performed in the color attachment output stage
+            useImage(depthResolveImage,
+                     0,
+                     1,
+                     ::depthAttachmentLayout(depthAttachment->view.format),
+                     VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                     VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+            attachmentMipLevels.emplace_back(depthResolveImage.get(), 0);
+        }
+    }
+
+    for (const auto& resolveImage : resolveImages)
+    {
+        useImage(resolveImage,
+                 0,
+                 1,
+                 VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                 VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                 VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+        attachmentMipLevels.emplace_back(resolveImage.get(), 0);
     }
 
+    useImagesForShaderAccess(attachmentMipLevels,
+                             VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT);
+    flushBarriers();
+
     vkCmdBeginRendering(mCommandBuffer, &renderingInfo);
+    mInsideRenderPass = true;
+
+    if (mRetainReferences)
+    {
+        for (const auto& [_, color] : colorAttachments)
+        {
+            mRetainedResources.insert(color.image);
+        }
+
+        if (depthAttachment)
+        {
+            mRetainedResources.insert(depthAttachment->image);
+        }
+
+        mRetainedResources.insert(resolveImages.begin(), resolveImages.end());
+
+        if (depthResolveImage)
+        {
+            mRetainedResources.insert(depthResolveImage);
+        }
+    }
 
     return true;
 }
@@ -195,6 +659,7 @@ bool
 CommandBufferImpl::cmdEndRenderPass()
 {
     vkCmdEndRendering(mCommandBuffer);
+    mInsideRenderPass = false;
 
     return true;
 }
@@ -210,6 +675,8 @@ CommandBufferImpl::cmdCopyBuffer(const CopyBufferInfo& info)
     bufferCopy.srcOffset = info.sourceOffset;
     bufferCopy.dstOffset = info.destOffset;
     bufferCopy.size      = info.size;
+
+    flushBarriers();
     vkCmdCopyBuffer(mCommandBuffer, source->getVkBuffer(), dest->getVkBuffer(), 1, &bufferCopy);
 
     if (mRetainReferences)
@@ -223,67 +690,109 @@ CommandBufferImpl::cmdCopyBuffer(const CopyBufferInfo& info)
 
 
 bool
-CommandBufferImpl::cmdCopyImage(const CopyImageInfo& info)
+CommandBufferImpl::cmdCopyBufferToImage(const CopyBufferToImageInfo& info)
 {
-    //auto buffer = static_cast<CO
-    //vkCmdCopyBufferToImage(mCommandBuffer, info.source)
-    return false;
-}
-
+    auto source = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(info.source);
+    auto dest   = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(info.dest);
 
-bool
-CommandBufferImpl::cmdBindVertexBuffer(Coral::BufferPtr buffer, uint32_t location, size_t offset, size_t stride)
-{
-    if (buffer->type() != CO_BUFFER_TYPE_VERTEX)
+    // Transient images are created without transfer usage
+    if (dest->isTransient())
     {
         return false;
     }
 
-    auto bufferImpl       = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(buffer);
-    auto vkBuffer         = bufferImpl->getVkBuffer();
-    VkDeviceSize vkOffset = offset;
-    VkDeviceSize vkSize   = bufferImpl->size();
-    VkDeviceSize vkStride = stride;
-
-    vkCmdBindVertexBuffers2(mCommandBuffer, location, 1, &vkBuffer, &vkOffset, &vkSize, &vkStride);
+    auto aspectMask = ::copyAspectMask(dest->format());
+    auto blockSize  = coPixelFormatGetSizeInBytes(dest->format());
+    auto block      = coPixelFormatGetBlockExtent(dest->format());
 
-    if (mRetainReferences)
+    std::vector<VkBufferImageCopy> copies;
+    if (info.regions.empty())
     {
-        mRetainedResources.insert(bufferImpl);
+        // Copy the tightly packed start of the buffer into the entire first mip level
+        auto& copy = copies.emplace_back();
+        copy.imageSubresource = ::convert(CoImageSubresource{ 0, 0, dest->layerCount() }, aspectMask);
+        copy.imageExtent      = { dest->width(), dest->height(), dest->depth() };
     }
-    return true;
-}
-
 
-bool
-CommandBufferImpl::cmdBindIndexBuffer(Coral::BufferPtr buffer, CoIndexFormat format, size_t offset)
-{  
-    if (buffer->type() != CO_BUFFER_TYPE_INDEX)
+    for (const auto& region : info.regions)
     {
-        // TODO buffer type must be index buffer
-        return false;
+        auto& copy = copies.emplace_back();
+        copy.bufferOffset      = region.bufferOffset;
+        copy.bufferRowLength   = region.bufferRowLength;
+        copy.bufferImageHeight = region.bufferImageHeight;
+        copy.imageSubresource  = ::convert(region.imageSubresource, aspectMask);
+        copy.imageOffset       = ::convert(region.imageOffset);
+        copy.imageExtent       = ::convert(region.imageExtent);
     }
 
-    auto bufferImpl = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(buffer);
+    uint32_t firstMipLevel = UINT32_MAX;
+    uint32_t lastMipLevel  = 0;
 
-    VkIndexType indexType{};
-    switch (format)
+    for (const auto& copy : copies)
     {
-        case CO_INDEX_FORMAT_UINT16 :
-            indexType = VK_INDEX_TYPE_UINT16;
-            break;
-        case CO_INDEX_FORMAT_UINT32:
-            indexType = VK_INDEX_TYPE_UINT32;
-            break;
-        default:
-            std::unreachable();
+        if (!::isRegionInside(*dest, copy.imageSubresource, copy.imageOffset, copy.imageExtent))
+        {
+            return false;
+        }
+
+        // The buffer layout of block-compressed images is addressed in whole blocks
+        if (copy.bufferRowLength % block.width != 0 || copy.bufferImageHeight % block.height != 0 || 
+            copy.bufferOffset % blockSize != 0)
+        {
+            return false;
+        }
+
+        // Buffer rows and images must not be shorter than the region
+        if ((copy.bufferRowLength != 0 && copy.bufferRowLength < copy.imageExtent.width) ||
+            (copy.bufferImageHeight != 0 && copy.bufferImageHeight < copy.imageExtent.height))
+        {
+            return false;
+        }
+
+        // Check that the last block of the region lies within the source buffer
+        size_t columns     = (copy.imageExtent.width + block.width - 1) / block.width;
+        size_t rows        = (copy.imageExtent.height + block.height - 1) / block.height;
+        size_t rowLength   = (std::max(copy.bufferRowLength, copy.imageExtent.width) + block.width - 1) / block.width;
+        size_t imageHeight = (std::max(copy.bufferImageHeight, copy.imageExtent.height) + block.height - 1) /
+                             block.height;
+        size_t slices      = size_t(copy.imageExtent.depth) * copy.imageSubresource.layerCount;
+        size_t lastBlock   = (slices - 1) * imageHeight * rowLength + (rows - 1) * rowLength + columns;
+
+        if (copy.bufferOffset + lastBlock * blockSize > source->size())
+        {
+            return false;
+        }
+
+        firstMipLevel = std::min(firstMipLevel, copy.imageSubresource.mipLevel);
+        lastMipLevel  = std::max(lastMipLevel, copy.imageSubresource.mipLevel);
     }
 
-    vkCmdBindIndexBuffer(mCommandBuffer, bufferImpl->getVkBuffer(), offset, indexType);
+    // Wait for all prior writes to the source buffer before copying
+    addMemoryBarrier(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                     VK_ACCESS_2_MEMORY_WRITE_BIT,
+                     VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                     VK_ACCESS_2_TRANSFER_READ_BIT);
+
+    useImage(dest,
+             firstMipLevel,
+             lastMipLevel - firstMipLevel + 1,
+             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+             VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+             VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    flushBarriers();
+
+    // Copy all regions at once
+    vkCmdCopyBufferToImage(mCommandBuffer,
+                           source->getVkBuffer(),
+                           dest->getVkImage(),
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<uint32_t>(copies.size()),
+                           copies.data());
 
     if (mRetainReferences)
     {
-        mRetainedResources.insert(bufferImpl);
+        mRetainedResources.insert(source);
+        mRetainedResources.insert(dest);
     }
 
     return true;
@@ -291,30 +800,364 @@ CommandBufferImpl::cmdBindIndexBuffer(Coral::BufferPtr buffer, CoIndexFormat for
 
 
 bool
-CommandBufferImpl::cmdBindPipeline(Coral::PipelineStatePtr pipelineState)
+CommandBufferImpl::cmdCopyImage(const CopyImageInfo& info)
 {
-    mLastBoundPipelineState = std::static_pointer_cast<Coral::Vulkan::PipelineStateImpl>(pipelineState);
-    vkCmdBindPipeline(mCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mLastBoundPipelineState->getVkPipeline());
+    auto source = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(info.source);
+    auto dest   = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(info.dest);
 
-    if (mRetainReferences)
+    // Transient images are created without transfer usage
+    if (info.regions.empty() || source->isTransient() || dest->isTransient() ||
+        source->sampleCount() != dest->sampleCount())
     {
-       // mRetainedResources.insert(pipelineState);
+        return false;
     }
 
-    return true;
-}
-
+    // Copies reinterpret the texel blocks, hence both formats must have the same block size and extent
+    auto srcBlock = coPixelFormatGetBlockExtent(source->format());
+    auto dstBlock = coPixelFormatGetBlockExtent(dest->format());
+    if (coPixelFormatGetSizeInBytes(source->format()) != coPixelFormatGetSizeInBytes(dest->format()) ||
+        srcBlock.width != dstBlock.width || srcBlock.height != dstBlock.height)
+    {
+        return false;
+    }
 
-bool
+    // Both images must have the same aspects. Depth-stencil formats can only be copied into the same format.
+    auto aspectMask = ::imageCopyAspectMask(source->format());
+    if (aspectMask != ::imageCopyAspectMask(dest->format()) ||
+        ((isDepthFormat(source->format()) || isDepthFormat(dest->format())) && source->format() != dest->format()))
+    {
+        return false;
+    }
+
+    uint32_t firstSrcMipLevel = UINT32_MAX;
+    uint32_t lastSrcMipLevel  = 0;
+    uint32_t firstDstMipLevel = UINT32_MAX;
+    uint32_t lastDstMipLevel  = 0;
+
+    std::vector<VkImageCopy> copies;
+    copies.reserve(info.regions.size());
+
+    for (const auto& region : info.regions)
+    {
+        auto& copy = copies.emplace_back();
+        copy.srcSubresource = ::convert(region.srcSubresource, aspectMask);
+        copy.srcOffset      = ::convert(region.srcOffset);
+        copy.dstSubresource = ::convert(region.dstSubresource, aspectMask);
+        copy.dstOffset      = ::convert(region.dstOffset);
+        copy.extent         = ::convert(region.extent);
+
+        if (!::isRegionInside(*source, copy.srcSubresource, copy.srcOffset, copy.extent) ||
+            !::isRegionInside(*dest, copy.dstSubresource, copy.dstOffset, copy.extent))
+        {
+            return false;
+        }
+
+        firstSrcMipLevel = std::min(firstSrcMipLevel, copy.srcSubresource.mipLevel);
+        lastSrcMipLevel  = std::max(lastSrcMipLevel, copy.srcSubresource.mipLevel);
+        firstDstMipLevel = std::min(firstDstMipLevel, copy.dstSubresource.mipLevel);
+        lastDstMipLevel  = std::max(lastDstMipLevel, copy.dstSubresource.mipLevel);
+    }
+
+    // Copies within the same image (e.g. between mip levels or atlas regions) use a single layout for all affected mip
+    // levels since the source and destination ranges may overlap
+    bool sameImage = source == dest;
+    if (sameImage)
+    {
+        firstSrcMipLevel = firstDstMipLevel = std::min(firstSrcMipLevel, firstDstMipLevel);
+        lastSrcMipLevel  = lastDstMipLevel  = std::max(lastSrcMipLevel, lastDstMipLevel);
+    }
+
+    auto srcLayout = sameImage ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    auto dstLayout = sameImage ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+
+    useImage(source,
+             firstSrcMipLevel,
+             lastSrcMipLevel - firstSrcMipLevel + 1,
+             srcLayout,
+             VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+             sameImage ? VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT 
+                       : VK_ACCESS_2_TRANSFER_READ_BIT);
+
+    if (!sameImage)
+    {
+        useImage(dest,
+                 firstDstMipLevel,
+                 lastDstMipLevel - firstDstMipLevel + 1,
+                 dstLayout,
+                 VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                 VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    }
+
+    flushBarriers();
+
+    // Copy all regions at once
+    vkCmdCopyImage(mCommandBuffer,
+                   source->getVkImage(),
+                   srcLayout,
+                   dest->getVkImage(),
+                   dstLayout,
+                   static_cast<uint32_t>(copies.size()),
+                   copies.data());
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(source);
+        mRetainedResources.insert(dest);
+    }
+
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdBindVertexBuffer(Coral::BufferPtr buffer, uint32_t location, size_t offset, size_t stride)
+{
+    if ((buffer->type() & CO_BUFFER_TYPE_VERTEX) == 0)
+    {
+        return false;
+    }
+
+    auto bufferImpl       = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(buffer);
+    auto vkBuffer         = bufferImpl->getVkBuffer();
+    VkDeviceSize vkOffset = offset;
+    VkDeviceSize vkSize   = bufferImpl->size();
+    VkDeviceSize vkStride = stride;
+
+    vkCmdBindVertexBuffers2(mCommandBuffer, location, 1, &vkBuffer, &vkOffset, &vkSize, &vkStride);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(bufferImpl);
+    }
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdBindIndexBuffer(Coral::BufferPtr buffer, CoIndexFormat format, size_t offset)
+{  
+    if ((buffer->type() & CO_BUFFER_TYPE_INDEX) == 0)
+    {
+        return false;
+    }
+
+    auto bufferImpl = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(buffer);
+
+    VkIndexType indexType{};
+    switch (format)
+    {
+        case CO_INDEX_FORMAT_UINT16 :
+            indexType = VK_INDEX_TYPE_UINT16;
+            break;
+        case CO_INDEX_FORMAT_UINT32:
+            indexType = VK_INDEX_TYPE_UINT32;
+            break;
+        default:
+            std::unreachable();
+    }
+
+    vkCmdBindIndexBuffer(mCommandBuffer, bufferImpl->getVkBuffer(), offset, indexType);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(bufferImpl);
+    }
+
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdBindPipeline(Coral::PipelineStatePtr pipelineState)
+{
+    if (mCommandQueue.isTransferOnly())
+    {
+        return false;
+    }
+
+    auto impl         = std::static_pointer_cast<Coral::Vulkan::PipelineStateImpl>(pipelineState);
+    auto bindingPoint = impl->getVkPipelineBindingPoint();
+
+    // Graphics and compute pipelines are bound to separate binding points and do not replace each other
+    if (bindingPoint == VK_PIPELINE_BIND_POINT_COMPUTE)
+    {
+        mLastBoundComputePipelineState = impl;
+    }
+    else
+    {
+        mLastBoundPipelineState = impl;
+    }
+
+    vkCmdBindPipeline(mCommandBuffer, bindingPoint, impl->getVkPipeline());
+
+    if (mRetainReferences)
+    {
+       // mRetainedResources.insert(pipelineState);
+    }
+
+    return true;
+}
+
+
+bool
 CommandBufferImpl::cmdDrawIndexed(const CoDrawIndexedInfo& info)
 {
-    cmdBindCachedDescriptors();
+    if (mLastBoundPipelineState && !cmdBindCachedDescriptors(*mLastBoundPipelineState))
+    {
+        return false;
+    }
+
     vkCmdDrawIndexed(mCommandBuffer, info.indexCount, 1, info.firstIndex, 0, 0);
 
     return true;
 }
 
 
+bool
+CommandBufferImpl::cmdDrawIndexedIndirect(const Coral::DrawIndexedIndirectInfo& info)
+{
+    auto bufferImpl = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(info.buffer);
+    auto countImpl  = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(info.countBuffer);
+
+    constexpr size_t commandSize = sizeof(VkDrawIndexedIndirectCommand);
+    static_assert(commandSize == sizeof(CoDrawIndexedIndirectCommand));
+
+    size_t stride = info.stride == 0 ? commandSize : info.stride;
+
+    if ((bufferImpl->type() & CO_BUFFER_TYPE_INDIRECT) == 0 ||
+        info.offset % sizeof(uint32_t) != 0 ||
+        stride % sizeof(uint32_t) != 0 ||
+        stride < commandSize ||
+        (info.drawCount > 0 && info.offset + (info.drawCount - 1) * stride + commandSize > bufferImpl->size()))
+    {
+        return false;
+    }
+
+    if (countImpl)
+    {
+        if (!context().isDrawIndirectCountSupported() ||
+            (countImpl->type() & CO_BUFFER_TYPE_INDIRECT) == 0 ||
+            info.countOffset % sizeof(uint32_t) != 0 ||
+            info.countOffset + sizeof(uint32_t) > countImpl->size())
+        {
+            return false;
+        }
+    }
+    else if (info.drawCount > 1 && !context().isMultiDrawIndirectSupported())
+    {
+        return false;
+    }
+
+    if (!prepareDraw())
+    {
+        return false;
+    }
+
+    if (countImpl)
+    {
+        vkCmdDrawIndexedIndirectCount(mCommandBuffer,
+                                      bufferImpl->getVkBuffer(),
+                                      info.offset,
+                                      countImpl->getVkBuffer(),
+                                      info.countOffset,
+                                      info.drawCount,
+                                      static_cast<uint32_t>(stride));
+    }
+    else
+    {
+        vkCmdDrawIndexedIndirect(mCommandBuffer,
+                                 bufferImpl->getVkBuffer(),
+                                 info.offset,
+                                 info.drawCount,
+                                 static_cast<uint32_t>(stride));
+    }
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(bufferImpl);
+
+        if (countImpl)
+        {
+            mRetainedResources.insert(countImpl);
+        }
+    }
+
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    if (!prepareDispatch())
+    {
+        return false;
+    }
+
+    vkCmdDispatch(mCommandBuffer, groupCountX, groupCountY, groupCountZ);
+
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdDispatchIndirect(Coral::BufferPtr buffer, size_t offset)
+{
+    auto bufferImpl = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(buffer);
+
+    // The workgroup counts are three consecutive uint32_t values
+    if ((bufferImpl->type() & CO_BUFFER_TYPE_INDIRECT) == 0 ||
+        offset % sizeof(uint32_t) != 0 ||
+        offset + 3 * sizeof(uint32_t) > bufferImpl->size())
+    {
+        return false;
+    }
+
+    if (!prepareDispatch())
+    {
+        return false;
+    }
+
+    vkCmdDispatchIndirect(mCommandBuffer, bufferImpl->getVkBuffer(), offset);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(bufferImpl);
+    }
+
+    return true;
+}
+
+
+bool
+CommandBufferImpl::prepareDispatch()
+{
+    if (!mLastBoundComputePipelineState || mInsideRenderPass || mCommandQueue.isTransferOnly())
+    {
+        return false;
+    }
+
+    // Images written by previous commands are transitioned back into their preferred layout for shader access. The
+    // barriers also make storage writes of previous dispatches visible.
+    useImagesForShaderAccess({}, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT);
+    flushBarriers();
+
+    return cmdBindCachedDescriptors(*mLastBoundComputePipelineState);
+}
+
+
+bool
+CommandBufferImpl::prepareDraw()
+{
+    if (!mLastBoundPipelineState || !mInsideRenderPass)
+    {
+        return false;
+    }
+
+    return cmdBindCachedDescriptors(*mLastBoundPipelineState);
+}
+
+
 bool
 CommandBufferImpl::cmdSetViewport(const CoViewportInfo& info)
 {
@@ -367,169 +1210,713 @@ CommandBufferImpl::cmdUpdateBufferData(const Coral::UpdateBufferDataInfo& info)
 
     auto stagingBuffer = context().requestStagingBuffer(info.data.size());
 
-    auto mapped = stagingBuffer->map();
-    std::memcpy(mapped + info.offset, info.data.data(), info.data.size());
-    stagingBuffer->unmap();
+    auto mapped = stagingBuffer->map();
+    std::memcpy(mapped, info.data.data(), info.data.size());
+    stagingBuffer->unmap();
+
+    VkBufferCopy bufferCopy;
+    bufferCopy.srcOffset = 0;
+    bufferCopy.dstOffset = info.offset;
+    bufferCopy.size      = info.data.size();
+
+    flushBarriers();
+    vkCmdCopyBuffer(mCommandBuffer, stagingBuffer->getVkBuffer(), buffer->getVkBuffer(), 1, &bufferCopy);
+
+    addTransferWriteBarrier(*buffer);
+
+    // Store the temporary staging buffer until the command buffer was executed
+    mRetainedResources.insert(stagingBuffer);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(buffer);
+    }
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdUpdateBufferDataFromHostMemory(const Coral::UpdateBufferDataInfo& info, Coral::CompletionTokenPtr token)
+{
+    if (info.offset + info.data.size() > info.buffer->size())
+    {
+        return false;
+    }
+
+    auto alignment = context().getMinImportedHostPointerAlignment();
+
+    // Host memory can only be imported at the granularity of the import alignment (usually the page size). Import the
+    // aligned range enclosing the data and offset the copy accordingly. If the alignment exceeds the page size, the
+    // enclosing range may cover unmapped neighbouring pages, in which case the import fails and the staging copy below
+    // is used instead. The imported memory is only ever read.
+    std::shared_ptr<BufferImpl> hostBuffer;
+    uintptr_t address      = reinterpret_cast<uintptr_t>(info.data.data());
+    uintptr_t alignedBegin = address;
+    if (alignment > 0 && !info.data.empty())
+    {
+        alignedBegin    = address - address % alignment;
+        auto alignedEnd = (address + info.data.size() + alignment - 1) / alignment * alignment;
+
+        hostBuffer = std::make_shared<BufferImpl>(context());
+        if (hostBuffer->initFromHostMemory(reinterpret_cast<const std::byte*>(alignedBegin), alignedEnd - alignedBegin))
+        {
+            hostBuffer.reset();
+        }
+    }
+
+    if (!hostBuffer)
+    {
+        // Host memory import is not available. Fall back to a staging copy, after which the host memory is no longer
+        // accessed.
+        if (!cmdUpdateBufferData(info))
+        {
+            return false;
+        }
+        token->complete(true);
+        return true;
+    }
+
+    auto buffer = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(info.buffer);
+
+    VkBufferCopy bufferCopy;
+    bufferCopy.srcOffset = address - alignedBegin;
+    bufferCopy.dstOffset = info.offset;
+    bufferCopy.size      = info.data.size();
+
+    flushBarriers();
+    vkCmdCopyBuffer(mCommandBuffer, hostBuffer->getVkBuffer(), buffer->getVkBuffer(), 1, &bufferCopy);
+
+    addTransferWriteBarrier(*buffer);
+
+    // Keep the imported memory alive until the command buffer was executed and complete the token afterwards
+    mRetainedResources.insert(hostBuffer);
+    mCompletionTokens.push_back(token);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(buffer);
+    }
+    return true;
+}
+
+
+Coral::ReadbackPtr
+CommandBufferImpl::cmdReadbackBuffer(Coral::BufferPtr source, size_t offset, size_t size)
+{
+    if (size == 0 || offset + size > source->size())
+    {
+        return nullptr;
+    }
+
+    auto sourceImpl     = std::static_pointer_cast<Coral::Vulkan::BufferImpl>(source);
+    auto readbackBuffer = context().requestReadbackBuffer(size);
+    if (!readbackBuffer)
+    {
+        return nullptr;
+    }
+
+    // Wait for all prior writes to the source buffer before copying
+    addBufferBarrier(sourceImpl->getVkBuffer(),
+                     offset,
+                     size,
+                     VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                     VK_ACCESS_2_MEMORY_WRITE_BIT,
+                     VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                     VK_ACCESS_2_TRANSFER_READ_BIT);
+    flushBarriers();
+
+    VkBufferCopy bufferCopy;
+    bufferCopy.srcOffset = offset;
+    bufferCopy.dstOffset = 0;
+    bufferCopy.size      = size;
+
+    vkCmdCopyBuffer(mCommandBuffer, sourceImpl->getVkBuffer(), readbackBuffer->getVkBuffer(), 1, &bufferCopy);
+
+    // Make the copied data available to the host. The barrier is batched with the barriers of the next command.
+    addBufferBarrier(readbackBuffer->getVkBuffer(),
+                     0,
+                     size,
+                     VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                     VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                     VK_PIPELINE_STAGE_2_HOST_BIT,
+                     VK_ACCESS_2_HOST_READ_BIT);
+
+    auto token = std::make_shared<Coral::CompletionToken>();
+
+    // The readback becomes ready once the command queue completed the token after execution
+    mCompletionTokens.push_back(token);
+    mRetainedResources.insert(readbackBuffer);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(sourceImpl);
+    }
+
+    return std::make_shared<Coral::Readback>(readbackBuffer, size, token);
+}
+
+
+Coral::ReadbackPtr
+CommandBufferImpl::cmdReadbackImage(const Coral::ReadbackImageInfo& info)
+{
+    auto image = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(info.image);
+
+    // Transient images are created without transfer usage
+    if (image->isTransient())
+    {
+        return nullptr;
+    }
+
+    // Only a single aspect can be copied at once. For depth/stencil images, read the depth values.
+    auto layers = ::getLayerRange(*image, info.mipLevel, info.arrayLayer, 1, ::copyAspectMask(image->format()));
+    if (!layers)
+    {
+        return nullptr;
+    }
+
+    uint32_t mipWidth  = std::max(image->width() >> info.mipLevel, 1u);
+    uint32_t mipHeight = std::max(image->height() >> info.mipLevel, 1u);
+
+    if (info.offsetX >= mipWidth || info.offsetY >= mipHeight)
+    {
+        return nullptr;
+    }
+
+    // A zero extent reads the remainder of the mip level
+    uint32_t width  = info.extent.width  == 0 ? mipWidth - info.offsetX  : info.extent.width;
+    uint32_t height = info.extent.height == 0 ? mipHeight - info.offsetY : info.extent.height;
+
+    if (info.offsetX + width > mipWidth || info.offsetY + height > mipHeight ||
+        !::isRegionBlockAligned(image->format(), mipWidth, mipHeight, info.offsetX, info.offsetY, width, height))
+    {
+        return nullptr;
+    }
+
+    size_t size = coPixelFormatGetRegionSizeInBytes(image->format(), width, height);
+
+    auto readbackBuffer = context().requestReadbackBuffer(size);
+    if (!readbackBuffer)
+    {
+        return nullptr;
+    }
+
+    // Wait for all prior writes to the mip level before copying
+    useImage(image,
+             info.mipLevel,
+             1,
+             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+             VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+             VK_ACCESS_2_TRANSFER_READ_BIT);
+    flushBarriers();
+
+    VkBufferImageCopy copy{};
+    copy.bufferOffset       = 0;
+    copy.bufferRowLength    = 0; // Tightly packed
+    copy.bufferImageHeight  = 0; // Tightly packed
+    copy.imageExtent.width  = width;
+    copy.imageExtent.height = height;
+    copy.imageExtent.depth  = 1;
+    copy.imageOffset.x      = static_cast<int32_t>(info.offsetX);
+    copy.imageOffset.y      = static_cast<int32_t>(info.offsetY);
+    copy.imageOffset.z      = layers->offsetZ;
+    copy.imageSubresource   = layers->subresource;
+
+    vkCmdCopyImageToBuffer(mCommandBuffer, 
+                           image->getVkImage(), 
+                           VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 
+                           readbackBuffer->getVkBuffer(), 
+                           1, 
+                           &copy);
+
+    // Make the copied data available to the host. The barrier is batched with the barriers of the next command.
+    addBufferBarrier(readbackBuffer->getVkBuffer(),
+                     0,
+                     size,
+                     VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                     VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                     VK_PIPELINE_STAGE_2_HOST_BIT,
+                     VK_ACCESS_2_HOST_READ_BIT);
+
+    auto token = std::make_shared<Coral::CompletionToken>();
+
+    // The readback becomes ready once the command queue completed the token after execution
+    mCompletionTokens.push_back(token);
+    mRetainedResources.insert(readbackBuffer);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(image);
+    }
+
+    return std::make_shared<Coral::Readback>(readbackBuffer, size, token);
+}
+
+
+void
+CommandBufferImpl::addTransferWriteBarrier(BufferImpl& buffer)
+{
+    VkPipelineStageFlags2 dstStageMask{ 0 };
+    VkAccessFlags2 dstAccessMask{ 0 };
+
+    // Make the written data visible to every usage the buffer was created with
+    auto type = buffer.type();
+    if (type & CO_BUFFER_TYPE_INDEX)
+    {
+        dstAccessMask |= VK_ACCESS_2_INDEX_READ_BIT;
+        dstStageMask  |= VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+    }
+    if (type & CO_BUFFER_TYPE_VERTEX)
+    {
+        dstAccessMask |= VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+        dstStageMask  |= VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT;
+    }
+    if (type & CO_BUFFER_TYPE_UNIFORM)
+    {
+        dstAccessMask |= VK_ACCESS_2_UNIFORM_READ_BIT;
+        dstStageMask  |= VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | 
+                         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT |
+                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    }
+    if (type & CO_BUFFER_TYPE_STORAGE)
+    {
+        dstAccessMask |= VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+        dstStageMask  |= VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | 
+                         VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | 
+                         VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    }
+    if (type & CO_BUFFER_TYPE_INDIRECT)
+    {
+        dstAccessMask |= VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+        dstStageMask  |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+    }
+    if (dstStageMask == 0)
+    {
+        // Transfer-only buffer, subsequent reads happen through copy commands
+        dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    }
+
+    addBufferBarrier(buffer.getVkBuffer(),
+                     0,
+                     VK_WHOLE_SIZE,
+                     VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                     VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                     dstStageMask,
+                     dstAccessMask);
+}
+
+
+void
+CommandBufferImpl::addBufferBarrier(VkBuffer buffer,
+                                    VkDeviceSize offset,
+                                    VkDeviceSize size,
+                                    VkPipelineStageFlags2 srcStageMask,
+                                    VkAccessFlags2 srcAccessMask,
+                                    VkPipelineStageFlags2 dstStageMask,
+                                    VkAccessFlags2 dstAccessMask)
+{
+    VkBufferMemoryBarrier2 barrier{ VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2 };
+    barrier.srcStageMask        = srcStageMask;
+    barrier.srcAccessMask       = srcAccessMask;
+    barrier.dstStageMask        = dstStageMask;
+    barrier.dstAccessMask       = dstAccessMask;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer              = buffer;
+    barrier.offset              = offset;
+    barrier.size                = size;
+
+    mPendingBufferBarriers.push_back(barrier);
+}
+
+
+void
+CommandBufferImpl::addMemoryBarrier(VkPipelineStageFlags2 srcStageMask,
+                                    VkAccessFlags2 srcAccessMask,
+                                    VkPipelineStageFlags2 dstStageMask,
+                                    VkAccessFlags2 dstAccessMask)
+{
+    VkMemoryBarrier2 barrier{ VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+    barrier.srcStageMask  = srcStageMask;
+    barrier.srcAccessMask = srcAccessMask;
+    barrier.dstStageMask  = dstStageMask;
+    barrier.dstAccessMask = dstAccessMask;
+
+    mPendingMemoryBarriers.push_back(barrier);
+}
+
+
+bool
+CommandBufferImpl::cmdClearImage(Coral::ImagePtr image, const CoClearColor& clearColor)
+{
+    // Block-compressed images cannot be cleared. Transient images are created without transfer usage. Transfer-only
+    // queues do not support clearing images.
+    if (image->presentable() || image->isTransient() || coPixelFormatIsCompressed(image->format()) ||
+        mCommandQueue.isTransferOnly())
+    {
+        return false;
+    }
+
+    auto imageImpl = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(image);
+
+    VkClearColorValue color;
+    color.float32[0] = clearColor.color[0];
+    color.float32[1] = clearColor.color[1];
+    color.float32[2] = clearColor.color[2];
+    color.float32[3] = clearColor.color[3];
+
+    useImage(imageImpl,
+             0,
+             image->getMipLevels(),
+             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+             VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+             VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    flushBarriers();
+
+    // Clear all mip levels and array layers
+    VkImageSubresourceRange range{};
+    range.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    range.baseArrayLayer = 0;
+    range.layerCount     = image->layerCount();
+    range.baseMipLevel   = 0;
+    range.levelCount     = image->getMipLevels();
+
+    vkCmdClearColorImage(mCommandBuffer,
+        imageImpl->getVkImage(),
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        &color,
+        1,
+        &range);
+
+    if (mRetainReferences)
+    {
+        mRetainedResources.insert(imageImpl);
+    }
+
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdUpdateImageData(const Coral::UpdateImageDataInfo& info)
+{
+    auto image = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(info.image);
+
+    uint32_t levelCount = std::max(info.mipLevelCount, 1u);
+    uint32_t layerCount = std::max(info.layerCount, 1u);
+
+    // Transient images are created without transfer usage
+    if (image->isTransient() || info.mipLevel + levelCount > image->getMipLevels())
+    {
+        return false;
+    }
+
+    auto aspectMask = ::copyAspectMask(image->format());
+
+    std::vector<VkBufferImageCopy> copies;
+    size_t stagingSize{ 0 };
+
+    // Size of a tightly packed row and number of rows of the region. Rows of block-compressed formats are rows of
+    // blocks.
+    size_t rowSize{ 0 };
+    size_t rowCount{ 0 };
+
+    if (levelCount == 1)
+    {
+        auto layers = ::getLayerRange(*image, info.mipLevel, info.arrayLayer, layerCount, aspectMask);
+        if (!layers)
+        {
+            return false;
+        }
+
+        uint32_t mipWidth  = std::max(image->width() >> info.mipLevel, 1u);
+        uint32_t mipHeight = std::max(image->height() >> info.mipLevel, 1u);
+
+        if (info.offsetX >= mipWidth || info.offsetY >= mipHeight)
+        {
+            return false;
+        }
+
+        // A zero extent updates the remainder of the mip level
+        uint32_t width  = info.extent.width  == 0 ? mipWidth - info.offsetX  : info.extent.width;
+        uint32_t height = info.extent.height == 0 ? mipHeight - info.offsetY : info.extent.height;
+
+        if (info.offsetX + width > mipWidth || info.offsetY + height > mipHeight ||
+            !::isRegionBlockAligned(image->format(), mipWidth, mipHeight, info.offsetX, info.offsetY, width, height))
+        {
+            return false;
+        }
+
+        auto block = coPixelFormatGetBlockExtent(image->format());
+
+        rowSize  = coPixelFormatGetRegionSizeInBytes(image->format(), width, 1);
+        rowCount = (height + block.height - 1) / block.height;
+
+        // The rows of all layers are stored one after another
+        rowCount *= layerCount;
+
+        size_t rowPitch = info.rowPitch == 0 ? rowSize : info.rowPitch;
+
+        if (rowPitch < rowSize || info.data.size() < (rowCount - 1) * rowPitch + rowSize)
+        {
+            return false;
+        }
+
+        stagingSize = rowSize * rowCount;
+
+        auto& copy = copies.emplace_back();
+        copy.imageSubresource = layers->subresource;
+        copy.imageOffset      = { static_cast<int32_t>(info.offsetX), 
+                                  static_cast<int32_t>(info.offsetY), 
+                                  layers->offsetZ };
+        copy.imageExtent      = { width, height, layers->depth };
+    }
+    else
+    {
+        // A mip chain consists of complete, tightly packed mip levels stored one after another
+        if (info.offsetX != 0 || info.offsetY != 0 || info.extent.width != 0 || info.extent.height != 0 || 
+            info.rowPitch != 0)
+        {
+            return false;
+        }
+
+        // Each level of a 3D image contains all of its depth slices
+        bool is3D = image->type() == CO_IMAGE_TYPE_3D;
+        if (is3D && (info.arrayLayer != 0 || layerCount != 1))
+        {
+            return false;
+        }
+
+        for (uint32_t level = info.mipLevel; level < info.mipLevel + levelCount; ++level)
+        {
+            uint32_t mipWidth  = std::max(image->width() >> level, 1u);
+            uint32_t mipHeight = std::max(image->height() >> level, 1u);
+            uint32_t slices    = is3D ? std::max(image->depth() >> level, 1u) : layerCount;
+
+            auto layers = ::getLayerRange(*image, level, info.arrayLayer, slices, aspectMask);
+            if (!layers)
+            {
+                return false;
+            }
 
-    VkBufferCopy bufferCopy;
-    bufferCopy.srcOffset = 0;
-    bufferCopy.dstOffset = info.offset;
-    bufferCopy.size      = info.data.size();
+            auto& copy = copies.emplace_back();
+            copy.bufferOffset     = stagingSize;
+            copy.imageSubresource = layers->subresource;
+            copy.imageOffset      = { 0, 0, layers->offsetZ };
+            copy.imageExtent      = { mipWidth, mipHeight, layers->depth };
 
-    vkCmdCopyBuffer(mCommandBuffer, stagingBuffer->getVkBuffer(), buffer->getVkBuffer(), 1, &bufferCopy);
+            stagingSize += coPixelFormatGetRegionSizeInBytes(image->format(), mipWidth, mipHeight) * slices;
+        }
 
-    VkPipelineStageFlags dstStageMask;
+        if (info.data.size() < stagingSize)
+        {
+            return false;
+        }
+    }
 
-    VkBufferMemoryBarrier barrier{};
-    barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-    barrier.buffer              = buffer->getVkBuffer();
-    barrier.dstQueueFamilyIndex = context().getQueueFamilyIndex();
-    barrier.srcQueueFamilyIndex = context().getQueueFamilyIndex();
-    barrier.offset              = 0;
-    barrier.size                = VK_WHOLE_SIZE;
-    barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+    auto stagingBuffer   = context().requestStagingBuffer(stagingSize);
+    auto stagingBufferVK = static_cast<Coral::Vulkan::BufferImpl*>(stagingBuffer.get());
 
-    switch (buffer->type())
+    // Only the pixels of the region are written to the staging buffer. Row padding of the source data is skipped
+    // while copying so that the GPU copy reads tightly packed rows.
+    auto mapped = stagingBuffer->map();
+    if (levelCount > 1 || info.rowPitch == 0 || info.rowPitch == rowSize)
     {
-        case CO_BUFFER_TYPE_INDEX:
-            barrier.dstAccessMask = VK_ACCESS_INDEX_READ_BIT;
-            dstStageMask          = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-            break;
-        case CO_BUFFER_TYPE_VERTEX:
-            barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-            dstStageMask          = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-            break;
-        case CO_BUFFER_TYPE_UNIFORM:
-            barrier.dstAccessMask = VK_ACCESS_UNIFORM_READ_BIT;
-            dstStageMask          = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | 
-                                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-            break;
-        case CO_BUFFER_TYPE_STORAGE:
-            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-            dstStageMask = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | 
-                           VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | 
-                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-            break;
+        std::memcpy(mapped, info.data.data(), stagingSize);
+    }
+    else
+    {
+        for (size_t row = 0; row < rowCount; ++row)
+        {
+            std::memcpy(mapped + row * rowSize, info.data.data() + row * info.rowPitch, rowSize);
+        }
     }
+    stagingBuffer->unmap();
 
-    vkCmdPipelineBarrier(mCommandBuffer,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        dstStageMask,
-        0,
-        0, nullptr,
-        1, &barrier,
-        0, nullptr
-    );
+    // Before copying data, transition the mip levels to be optimal for receiving data. Regions outside the update
+    // keep their content since the transition starts from the current layout.
+    useImage(image,
+             info.mipLevel,
+             levelCount,
+             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+             VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+             VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    flushBarriers();
+
+    // Copy all mip levels with a single command
+    vkCmdCopyBufferToImage(mCommandBuffer, 
+                           stagingBufferVK->getVkBuffer(), 
+                           image->getVkImage(), 
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 
+                           static_cast<uint32_t>(copies.size()), 
+                           copies.data());
 
-    // Store the temporary staging buffer until the command buffer was executed
     mRetainedResources.insert(stagingBuffer);
 
     if (mRetainReferences)
     {
-        mRetainedResources.insert(buffer);
+        mRetainedResources.insert(image);
     }
+
     return true;
 }
 
 
 bool
-CommandBufferImpl::cmdClearImage(Coral::ImagePtr image, const CoClearColor& clearColor)
+CommandBufferImpl::cmdGenerateMipMaps(Coral::ImagePtr image, CoMipReduction reduction)
 {
-    if (image->presentable())
+    auto impl = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(image);
+
+    // Block-compressed images support neither blits nor storage writes. Their mip levels must be uploaded. Both
+    // require a graphics or compute queue. Transient images have no mip levels.
+    auto levels = image->getMipLevels();
+    if (levels == 1 || image->isTransient() || coPixelFormatIsCompressed(image->format()) ||
+        mCommandQueue.isTransferOnly())
     {
         return false;
     }
 
-    auto imageImpl = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(image);
-
-    VkClearColorValue color;
-    color.float32[0] = clearColor.color[0];
-    color.float32[1] = clearColor.color[1];
-    color.float32[2] = clearColor.color[2];
-    color.float32[3] = clearColor.color[3];
-
-    std::vector<VkImageSubresourceRange> ranges;
-
-    for (uint32_t i = 0; i < image->getMipLevels(); ++i)
+    // The compute shader reads and writes float texels, hence integer formats are downsampled with blits. Larger images
+    // exceed the tiles reduced by the last work group and are downsampled with blits as well.
+    if (impl->isStorageSupported() && !::isIntegerFormat(image->format()) &&
+        std::max(image->width(), image->height()) <= MipGenerator::MaxExtent)
     {
-        auto& range = ranges.emplace_back();
-        range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        range.baseArrayLayer = 0;
-        range.layerCount = 1;
-        range.baseMipLevel = i;
-        range.levelCount = image->getMipLevels();
+        if (auto generator = context().getMipGenerator())
+        {
+            return cmdGenerateMipMapsCompute(impl, reduction, *generator);
+        }
     }
 
-    vkCmdClearColorImage(mCommandBuffer,
-        imageImpl->getVkImage(),
-        imageImpl->getPreferredImageLayout(),
-        &color,
-        static_cast<uint32_t>(ranges.size()),
-        ranges.data());
-
-    if (mRetainReferences)
+    // Blits only support linear filtering
+    if (reduction != CO_MIP_REDUCTION_AVERAGE)
     {
-        mRetainedResources.insert(imageImpl);
+        return false;
     }
 
+    cmdGenerateMipMapsBlit(impl);
+
     return true;
 }
 
 
 bool
-CommandBufferImpl::cmdUpdateImageData(const Coral::UpdateImageDataInfo& info)
+CommandBufferImpl::cmdGenerateMipMapsCompute(const ImageImplPtr& image, CoMipReduction reduction, MipGenerator& generator)
 {
-    auto image = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(info.image);
-
-    auto stagingBuffer   = context().requestStagingBuffer(info.data.size());
-    auto stagingBufferVK = static_cast<Coral::Vulkan::BufferImpl*>(stagingBuffer.get());
-
-    auto mapped = stagingBuffer->map();
-    std::memcpy(mapped, info.data.data(), info.data.size());
-    stagingBuffer->unmap();
+    auto levels = image->getMipLevels();
+    auto layers = image->layerCount();
+
+    MipGenerator::Parameters parameters{};
+    parameters.extent[0]     = image->width();
+    parameters.extent[1]     = image->height();
+    parameters.tileCount[0]  = (image->width() + MipGenerator::TileSize - 1) / MipGenerator::TileSize;
+    parameters.tileCount[1]  = (image->height() + MipGenerator::TileSize - 1) / MipGenerator::TileSize;
+    parameters.mipLevelCount = levels;
+    parameters.reduction     = static_cast<uint32_t>(reduction);
+
+    // The scratch buffer holds one float4 texel per tile and layer, followed by one counter of finished tiles per
+    // layer. The counters are placed at an offset satisfying any minStorageBufferOffsetAlignment (at most 256 bytes).
+    VkDeviceSize resultsSize    = VkDeviceSize(parameters.tileCount[0]) * parameters.tileCount[1] * layers * 16;
+    VkDeviceSize countersOffset = (resultsSize + 255) & ~VkDeviceSize(255);
+    VkDeviceSize countersSize   = VkDeviceSize(layers) * sizeof(uint32_t);
+
+    auto scratchBuffer = context().requestScratchBuffer(countersOffset + countersSize);
+    if (!scratchBuffer)
+    {
+        return false;
+    }
 
-    // Before copying data, transition the image layout to be optimal for receiving data. 
-    ImageImpl::cmdTransitionImageLayout(mCommandBuffer, 
-                                        *image, 
-                                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 
-                                        0, 
-                                        image->getMipLevels(), 
-                                        VK_ACCESS_TRANSFER_READ_BIT,
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT);
+    vkCmdFillBuffer(mCommandBuffer, scratchBuffer->getVkBuffer(), countersOffset, countersSize, 0);
+
+    addBufferBarrier(scratchBuffer->getVkBuffer(),
+                     countersOffset,
+                     countersSize,
+                     VK_PIPELINE_STAGE_2_CLEAR_BIT,
+                     VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                     VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                     VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+
+    // The first mip level is only sampled and stays in a read-only layout. All other mip levels are written as storage
+    // images in the general layout.
+    useImage(image,
+             0,
+             1,
+             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+             VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+             VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+
+    useImage(image,
+             1,
+             levels - 1,
+             VK_IMAGE_LAYOUT_GENERAL,
+             VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+             VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+    flushBarriers();
+
+    VkDescriptorImageInfo sourceInfo{};
+    sourceInfo.imageView   = image->getMipLevelView(0);
+    sourceInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    // All array elements must be valid. Elements beyond the mip chain reference the last mip level but are never
+    // written by the shader.
+    std::array<VkDescriptorImageInfo, MipGenerator::MaxMipLevels> destinationInfos{};
+    for (uint32_t i = 0; i < MipGenerator::MaxMipLevels; ++i)
+    {
+        destinationInfos[i].imageView   = image->getMipLevelView(std::min(i + 1, levels - 1));
+        destinationInfos[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    }
 
-    VkBufferImageCopy copy{};
-    copy.bufferOffset       = 0;
-    copy.bufferRowLength    = 0; // TODO: Support non-tightly packed images
-    copy.bufferImageHeight  = 0; // TODO: Support non-tightly packed images
-    copy.imageExtent.width  = image->width();
-    copy.imageExtent.height = image->height();
-    copy.imageExtent.depth  = 1;
-    copy.imageOffset.x      = 0;
-    copy.imageOffset.y      = 0;
-    copy.imageOffset.z      = 0;
+    VkDescriptorBufferInfo resultsInfo{};
+    resultsInfo.buffer = scratchBuffer->getVkBuffer();
+    resultsInfo.offset = 0;
+    resultsInfo.range  = resultsSize;
 
-    // Copy the data to the first mip level
-    copy.imageSubresource.mipLevel       = 0;
-    copy.imageSubresource.layerCount     = 1;
-    copy.imageSubresource.baseArrayLayer = 0;
-    copy.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    VkDescriptorBufferInfo countersInfo{};
+    countersInfo.buffer = scratchBuffer->getVkBuffer();
+    countersInfo.offset = countersOffset;
+    countersInfo.range  = countersSize;
 
-    vkCmdCopyBufferToImage(mCommandBuffer, stagingBufferVK->getVkBuffer(), image->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+    std::array<VkWriteDescriptorSet, 4> writes{};
+    for (auto& write : writes)
+    {
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.descriptorCount = 1;
+    }
 
-    mRetainedResources.insert(stagingBuffer);
+    writes[0].dstBinding      = MipGenerator::SOURCE_BINDING;
+    writes[0].descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    writes[0].pImageInfo      = &sourceInfo;
+    writes[1].dstBinding      = MipGenerator::DESTINATION_BINDING;
+    writes[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    writes[1].descriptorCount = MipGenerator::MaxMipLevels;
+    writes[1].pImageInfo      = destinationInfos.data();
+    writes[2].dstBinding      = MipGenerator::TILE_RESULTS_BINDING;
+    writes[2].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writes[2].pBufferInfo     = &resultsInfo;
+    writes[3].dstBinding      = MipGenerator::TILE_COUNTERS_BINDING;
+    writes[3].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writes[3].pBufferInfo     = &countersInfo;
+
+    auto layout = generator.getVkPipelineLayout();
+
+    vkCmdBindPipeline(mCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, generator.getVkPipeline());
+    vkCmdPushDescriptorSetKHR(mCommandBuffer,
+                              VK_PIPELINE_BIND_POINT_COMPUTE,
+                              layout,
+                              0,
+                              static_cast<uint32_t>(writes.size()),
+                              writes.data());
+    vkCmdPushConstants(mCommandBuffer, layout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(parameters), &parameters);
+    vkCmdDispatch(mCommandBuffer, parameters.tileCount[0], parameters.tileCount[1], layers);
+
+    // Restore the compute pipeline bound by the user. Its descriptors are pushed again with the next dispatch.
+    if (mLastBoundComputePipelineState)
+    {
+        vkCmdBindPipeline(mCommandBuffer,
+                          VK_PIPELINE_BIND_POINT_COMPUTE,
+                          mLastBoundComputePipelineState->getVkPipeline());
+    }
 
-    // Finally, transition the image layout back
-    ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                        *image,
-                                        image->getPreferredImageLayout(),
-                                        0,
-                                        image->getMipLevels(),
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_ACCESS_SHADER_READ_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    mRetainedResources.insert(scratchBuffer);
 
     if (mRetainReferences)
     {
@@ -540,77 +1927,53 @@ CommandBufferImpl::cmdUpdateImageData(const Coral::UpdateImageDataInfo& info)
 }
 
 
-bool
-CommandBufferImpl::cmdGenerateMipMaps(Coral::ImagePtr image)
+void
+CommandBufferImpl::cmdGenerateMipMapsBlit(const ImageImplPtr& image)
 {
-    auto impl = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(image);
-
     auto levels = image->getMipLevels();
-    if (levels == 1)
-    {
-        return false;
-    }
-
 
     for (uint32_t i = 1; i < levels; ++i)
     {
-        // Transition the image layout of the source and destination image to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL and 
-        // K_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.
-        ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                            *impl,
-                                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                            i - 1,
-                                            1,
-                                            VK_ACCESS_TRANSFER_WRITE_BIT,
-                                            VK_ACCESS_SHADER_READ_BIT,
-                                            VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
-        ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                    *impl,
-                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                    i,
-                                    1,
-                                    VK_ACCESS_TRANSFER_WRITE_BIT,
-                                    VK_ACCESS_SHADER_READ_BIT,
-                                    VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
+        // Each level is read after the blit into it finished. Both transitions are recorded with a single barrier.
+        useImage(image,
+                 i - 1,
+                 1,
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                 VK_PIPELINE_STAGE_2_BLIT_BIT,
+                 VK_ACCESS_2_TRANSFER_READ_BIT);
+
+        useImage(image,
+                 i,
+                 1,
+                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                 VK_PIPELINE_STAGE_2_BLIT_BIT,
+                 VK_ACCESS_2_TRANSFER_WRITE_BIT);
+        flushBarriers();
+
+        // All array layers of a level are downsampled with a single blit. The depth of 3D images is halved as well.
         VkImageBlit imageBlit{};
         imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        imageBlit.srcSubresource.layerCount = 1;
+        imageBlit.srcSubresource.layerCount = image->layerCount();
         imageBlit.srcSubresource.mipLevel   = i - 1;
-        imageBlit.srcOffsets[1].x           = int32_t(image->width() >> (i - 1));
-        imageBlit.srcOffsets[1].y           = int32_t(image->height() >> (i - 1));
-        imageBlit.srcOffsets[1].z           = 1;
+        imageBlit.srcOffsets[1].x           = int32_t(std::max(image->width() >> (i - 1), 1u));
+        imageBlit.srcOffsets[1].y           = int32_t(std::max(image->height() >> (i - 1), 1u));
+        imageBlit.srcOffsets[1].z           = int32_t(std::max(image->depth() >> (i - 1), 1u));
 
         imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-        imageBlit.dstSubresource.layerCount = 1;
+        imageBlit.dstSubresource.layerCount = image->layerCount();
         imageBlit.dstSubresource.mipLevel   = i;
-        imageBlit.dstOffsets[1].x           = int32_t(image->width() >> i);
-        imageBlit.dstOffsets[1].y           = int32_t(image->height() >> i);
-        imageBlit.dstOffsets[1].z           = 1;
+        imageBlit.dstOffsets[1].x           = int32_t(std::max(image->width() >> i, 1u));
+        imageBlit.dstOffsets[1].y           = int32_t(std::max(image->height() >> i, 1u));
+        imageBlit.dstOffsets[1].z           = int32_t(std::max(image->depth() >> i, 1u));
 
-        vkCmdBlitImage(mCommandBuffer, impl->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                       impl->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
+        vkCmdBlitImage(mCommandBuffer, image->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       image->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
     }
 
-    // Finally, transition all levels back to the preferred image layout
-    ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                        *impl,
-                                        impl->getPreferredImageLayout(),
-                                        0,
-                                        levels,
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_ACCESS_SHADER_READ_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
     if (mRetainReferences)
     {
-        mRetainedResources.insert(impl);
+        mRetainedResources.insert(image);
     }
-    return true;
 }
 
 
@@ -624,7 +1987,9 @@ CommandBufferImpl::cmdBindDescriptor(Coral::BufferPtr buffer, uint32_t binding)
     info.offset     = 0.f;
     info.range      = buffer->size();
 
-    mCachedDescriptorInfos[binding] = info;
+    mCachedDescriptorInfos[binding]   = info;
+    mCachedDescriptorBuffers[binding] = bufferImpl;
+    mCachedDescriptorImages.erase(binding);
 
     if (mRetainReferences)
     {
@@ -635,6 +2000,32 @@ CommandBufferImpl::cmdBindDescriptor(Coral::BufferPtr buffer, uint32_t binding)
 
 void
 CommandBufferImpl::cmdBindDescriptor(Coral::ImagePtr image, uint32_t binding)
+{
+    auto imageImpl = std::static_pointer_cast<ImageImpl>(image);
+
+    bindImageDescriptor(imageImpl,
+                        imageImpl ? imageImpl->getVkImageView() : VK_NULL_HANDLE,
+                        0,
+                        imageImpl ? imageImpl->getMipLevels() : 0,
+                        binding);
+}
+
+
+void
+CommandBufferImpl::cmdBindDescriptor(Coral::ImagePtr image, const Coral::ImageViewConfig& view, uint32_t binding)
+{
+    auto imageImpl = std::static_pointer_cast<ImageImpl>(image);
+
+    bindImageDescriptor(imageImpl, imageImpl->getVkImageView(view), view.baseMipLevel, view.mipLevelCount, binding);
+}
+
+
+void
+CommandBufferImpl::bindImageDescriptor(const ImageImplPtr& imageImpl,
+                                       VkImageView imageView,
+                                       uint32_t baseMipLevel,
+                                       uint32_t mipLevelCount,
+                                       uint32_t binding)
 {
     auto iter = mCachedDescriptorInfos.find(binding);
 
@@ -645,15 +2036,24 @@ CommandBufferImpl::cmdBindDescriptor(Coral::ImagePtr image, uint32_t binding)
     }
     if (!info)
     {
-        iter = mCachedDescriptorInfos.emplace(binding, VkDescriptorImageInfo{}).first;
+        // Replaces a buffer descriptor previously bound at the binding
+        iter = mCachedDescriptorInfos.insert_or_assign(binding, VkDescriptorImageInfo{}).first;
         info = &std::get<VkDescriptorImageInfo>(iter->second);
+        mCachedDescriptorBuffers.erase(binding);
     }
 
-    auto imageImpl = std::static_pointer_cast<ImageImpl>(image);
-
-    info->imageView   = imageImpl ? imageImpl->getVkImageView() : VK_NULL_HANDLE;
+    info->imageView   = imageView;
     info->imageLayout = imageImpl ? imageImpl->getPreferredImageLayout() : VK_IMAGE_LAYOUT_UNDEFINED;
 
+    if (imageImpl)
+    {
+        mCachedDescriptorImages[binding] = DescriptorImage{ imageImpl, baseMipLevel, mipLevelCount };
+    }
+    else
+    {
+        mCachedDescriptorImages.erase(binding);
+    }
+
     if (mRetainReferences)
     {
         mRetainedResources.insert(imageImpl);
@@ -673,8 +2073,10 @@ CommandBufferImpl::cmdBindDescriptor(Coral::SamplerPtr sampler, uint32_t binding
     }
     if (!info)
     {
-        iter = mCachedDescriptorInfos.emplace(binding, VkDescriptorImageInfo{}).first;
+        // Replaces a buffer descriptor previously bound at the binding
+        iter = mCachedDescriptorInfos.insert_or_assign(binding, VkDescriptorImageInfo{}).first;
         info = &std::get<VkDescriptorImageInfo>(iter->second);
+        mCachedDescriptorBuffers.erase(binding);
     }
 
     auto samplerImpl = std::static_pointer_cast<SamplerImpl>(sampler);
@@ -688,21 +2090,72 @@ CommandBufferImpl::cmdBindDescriptor(Coral::SamplerPtr sampler, uint32_t binding
 }
 
 
-void
-CommandBufferImpl::cmdBindCachedDescriptors()
+bool
+CommandBufferImpl::validateCachedDescriptors(PipelineStateImpl& pipeline) const
 {
-    if (!mLastBoundPipelineState)
+    for (const auto& [binding, info] : mCachedDescriptorInfos)
     {
-        return;
+        auto type = pipeline.getVkDescriptorType(binding);
+        if (!type)
+        {
+            continue;
+        }
+
+        // Buffers must have been created with the usage of the descriptor type declared by the pipeline
+        if (auto buffer = mCachedDescriptorBuffers.find(binding); buffer != mCachedDescriptorBuffers.end())
+        {
+            auto usage = *type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ? CO_BUFFER_TYPE_STORAGE : CO_BUFFER_TYPE_UNIFORM;
+            if ((buffer->second->type() & usage) == 0)
+            {
+                return false;
+            }
+        }
+
+        // Storage image descriptors require the storage usage and the general layout of CO_IMAGE_USAGE_HINT_STORAGE.
+        // Transient images are created without sampled and storage usage.
+        if (auto image = mCachedDescriptorImages.find(binding); image != mCachedDescriptorImages.end())
+        {
+            if (image->second.image->isTransient() ||
+                (*type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE && !image->second.image->isStorageImage()))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+bool
+CommandBufferImpl::cmdBindCachedDescriptors(PipelineStateImpl& pipeline)
+{
+    // Mismatching descriptors are rejected before anything is pushed
+    if (!validateCachedDescriptors(pipeline))
+    {
+        return false;
     }
 
-    auto layout       = mLastBoundPipelineState->getVkPipelineLayout();
-    auto bindingPoint = mLastBoundPipelineState->getVkPipelineBindingPoint();
+    auto layout       = pipeline.getVkPipelineLayout();
+    auto bindingPoint = pipeline.getVkPipelineBindingPoint();
+
+    // Shaders of the pipeline writing to storage descriptors may write to any storage buffer or image bound
+    bool writesStorage              = pipeline.writesStorageDescriptors();
+    VkPipelineStageFlags2 stageMask = bindingPoint == VK_PIPELINE_BIND_POINT_COMPUTE
+                                    ? VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT
+                                    : VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
 
     mDescriptorWrites.clear();
    
     for (const auto& [binding, info] : mCachedDescriptorInfos)
     {
+        // Descriptors not declared by the shaders of the pipeline must not be pushed
+        auto type = pipeline.getVkDescriptorType(binding);
+        if (!type)
+        {
+            continue;
+        }
+
         VkWriteDescriptorSet descriptorWrite{ VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
         descriptorWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         descriptorWrite.dstBinding      = binding;
@@ -712,13 +2165,26 @@ CommandBufferImpl::cmdBindCachedDescriptors()
         std::visit(Visitor{
             [&](const VkDescriptorBufferInfo& info)
             {
+                // The same buffer can be bound as uniform buffer or storage buffer if it was created with both usages
                 descriptorWrite.pBufferInfo    = &info;
-                descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+                descriptorWrite.descriptorType = *type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                                                 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                                                 : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
             },
             [&](const VkDescriptorImageInfo& info)
             {
                 descriptorWrite.pImageInfo = &info;
-                if (info.sampler && info.imageView)
+                if (*type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE && info.imageView)
+                {
+                    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+
+                    auto image = mCachedDescriptorImages.find(binding);
+                    if (writesStorage && image != mCachedDescriptorImages.end())
+                    {
+                        recordStorageImageWrite(image->second, stageMask);
+                    }
+                }
+                else if (info.sampler && info.imageView)
                 {
                     descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
                 }
@@ -740,79 +2206,91 @@ CommandBufferImpl::cmdBindCachedDescriptors()
     {
         vkCmdPushDescriptorSetKHR(mCommandBuffer, bindingPoint, layout, 0, mDescriptorWrites.size(), mDescriptorWrites.data());
     }
+
+    if (writesStorage)
+    {
+        mShaderStorageWriteStages |= stageMask;
+    }
+
+    return true;
+}
+
+
+void
+CommandBufferImpl::recordStorageImageWrite(const DescriptorImage& image, VkPipelineStageFlags2 stageMask)
+{
+    auto& tracked = trackImage(image.image);
+
+    for (uint32_t level = image.baseMipLevel; level < image.baseMipLevel + image.mipLevelCount; ++level)
+    {
+        auto& state = tracked.mipLevels[level];
+        if (!state)
+        {
+            state = MipLevelState{ image.image->getPreferredImageLayout(),
+                                   VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                   VK_ACCESS_2_NONE,
+                                   0,
+                                   0 };
+        }
+
+        state->stageMask  |= stageMask;
+        state->accessMask |= VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    }
 }
 
 
 bool
 CommandBufferImpl::cmdBlitImage(Coral::ImagePtr source, Coral::ImagePtr dest)
 {
+    // Block-compressed images do not support blits. Transient images are created without transfer usage. Blits require
+    // a graphics queue.
+    if (coPixelFormatIsCompressed(source->format()) || coPixelFormatIsCompressed(dest->format()) ||
+        source->isTransient() || dest->isTransient() || mCommandQueue.isTransferOnly())
+    {
+        return false;
+    }
+
     auto srcImpl = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(source);
     auto dstImpl = std::static_pointer_cast<Coral::Vulkan::ImageImpl>(dest);
 
     // Transition the image layout of the source and destination image to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL and 
     // VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.
+    useImage(srcImpl,
+             0,
+             1,
+             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+             VK_PIPELINE_STAGE_2_BLIT_BIT,
+             VK_ACCESS_2_TRANSFER_READ_BIT);
+
+    useImage(dstImpl,
+             0,
+             1,
+             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+             VK_PIPELINE_STAGE_2_BLIT_BIT,
+             VK_ACCESS_2_TRANSFER_WRITE_BIT);
+    flushBarriers();
+
+    // Blit the src image into the dst image. Layers present in both images are blitted one-to-one.
+    auto layerCount = std::min(source->layerCount(), dest->layerCount());
 
-    ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                        *srcImpl,
-                                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                        0,
-                                        1,
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_ACCESS_SHADER_READ_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
-    ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                        *dstImpl,
-                                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                        0,
-                                        1,
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_ACCESS_SHADER_READ_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
-    // Blit the src image into the dst image
     VkImageBlit imageBlit{};
     imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    imageBlit.srcSubresource.layerCount = 1;
+    imageBlit.srcSubresource.layerCount = layerCount;
     imageBlit.srcSubresource.mipLevel   = 0;
     imageBlit.srcOffsets[1].x           = int32_t(source->width());
     imageBlit.srcOffsets[1].y           = int32_t(source->height());
-    imageBlit.srcOffsets[1].z           = 1;
+    imageBlit.srcOffsets[1].z           = int32_t(source->depth());
 
     imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    imageBlit.dstSubresource.layerCount = 1;
+    imageBlit.dstSubresource.layerCount = layerCount;
     imageBlit.dstSubresource.mipLevel   = 0;
     imageBlit.dstOffsets[1].x           = int32_t(dest->width());
     imageBlit.dstOffsets[1].y           = int32_t(dest->height());
-    imageBlit.dstOffsets[1].z           = 1;
+    imageBlit.dstOffsets[1].z           = int32_t(dest->depth());
 
     vkCmdBlitImage(mCommandBuffer, srcImpl->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
                    dstImpl->getVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
 
-    // Finally, transition the image layouts back to the preferred
-
-    ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                        *srcImpl,
-                                        srcImpl->getPreferredImageLayout(),
-                                        0,
-                                        1,
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_ACCESS_SHADER_READ_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
-    ImageImpl::cmdTransitionImageLayout(mCommandBuffer,
-                                        *dstImpl,
-                                        dstImpl->getPreferredImageLayout(),
-                                        0,
-                                        1,
-                                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                                        VK_ACCESS_SHADER_READ_BIT,
-                                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
-
     if (mRetainReferences)
     {
         mRetainedResources.insert(srcImpl);
@@ -823,6 +2301,221 @@ CommandBufferImpl::cmdBlitImage(Coral::ImagePtr source, Coral::ImagePtr dest)
 }
 
 
+CommandBufferImpl::TrackedImage&
+CommandBufferImpl::trackImage(const ImageImplPtr& image)
+{
+    auto [iter, inserted] = mTrackedImages.try_emplace(image.get());
+    if (inserted)
+    {
+        iter->second.image       = image;
+        iter->second.finalLayout = image->getPreferredImageLayout();
+        iter->second.mipLevels.resize(image->getMipLevels());
+    }
+
+    return iter->second;
+}
+
+
+void
+CommandBufferImpl::useImage(const ImageImplPtr& image,
+                            uint32_t firstMipLevel,
+                            uint32_t levelCount,
+                            VkImageLayout layout,
+                            VkPipelineStageFlags2 stageMask,
+                            VkAccessFlags2 accessMask)
+{
+    auto& tracked = trackImage(image);
+
+    for (uint32_t level = firstMipLevel; level < firstMipLevel + levelCount; ++level)
+    {
+        auto& state = tracked.mipLevels[level];
+        if (!state)
+        {
+            // Previous command buffers leave the mip level in its preferred layout with all writes visible. Only the
+            // prior commands of this command buffer may still access it.
+            state = MipLevelState{ image->getPreferredImageLayout(), 
+                                   VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 
+                                   VK_ACCESS_2_NONE, 
+                                   0, 
+                                   0 };
+        }
+
+        bool pending = state->barrierBatch == mBarrierBatch;
+
+        if (state->layout == layout && !::isWriteAccess(state->accessMask) && !::isWriteAccess(accessMask))
+        {
+            // Reads in the same layout do not depend on each other. A pending barrier of the mip level must cover the
+            // new access as well.
+            state->stageMask  |= stageMask;
+            state->accessMask |= accessMask;
+
+            if (pending)
+            {
+                mPendingImageBarriers[state->barrierIndex].dstStageMask  |= stageMask;
+                mPendingImageBarriers[state->barrierIndex].dstAccessMask |= accessMask;
+            }
+            continue;
+        }
+
+        if (pending)
+        {
+            // The mip level is already transitioned by the pending barriers for another access
+            flushBarriers();
+        }
+
+        transitionMipLevel(tracked, level, layout, stageMask, accessMask);
+    }
+}
+
+
+void
+CommandBufferImpl::transitionMipLevel(TrackedImage& tracked,
+                                      uint32_t mipLevel,
+                                      VkImageLayout layout,
+                                      VkPipelineStageFlags2 stageMask,
+                                      VkAccessFlags2 accessMask)
+{
+    auto& state = *tracked.mipLevels[mipLevel];
+
+    // Only writes must be made available, prior reads just require an execution dependency
+    auto srcAccessMask = state.accessMask & ::writeAccessMask;
+
+    // Extend the last pending barrier if it transitions the previous mip level of the image the same way
+    VkImageMemoryBarrier2* previous = mPendingImageBarriers.empty() ? nullptr : &mPendingImageBarriers.back();
+    if (previous && previous->image == tracked.image->getVkImage() && 
+        previous->subresourceRange.baseMipLevel + previous->subresourceRange.levelCount == mipLevel &&
+        previous->oldLayout == state.layout && previous->newLayout == layout && 
+        previous->srcStageMask == state.stageMask && previous->srcAccessMask == srcAccessMask &&
+        previous->dstStageMask == stageMask && previous->dstAccessMask == accessMask)
+    {
+        previous->subresourceRange.levelCount++;
+    }
+    else
+    {
+        auto& barrier = mPendingImageBarriers.emplace_back(
+            tracked.image->createLayoutBarrier(mipLevel, 1, state.layout, layout));
+        barrier.srcStageMask  = state.stageMask;
+        barrier.srcAccessMask = srcAccessMask;
+        barrier.dstStageMask  = stageMask;
+        barrier.dstAccessMask = accessMask;
+    }
+
+    state = MipLevelState{ layout, stageMask, accessMask, mBarrierBatch, mPendingImageBarriers.size() - 1 };
+}
+
+
+void
+CommandBufferImpl::useImagesForShaderAccess(std::span<const ImageMipLevel> excluded, VkPipelineStageFlags2 stageMask)
+{
+    for (auto& [image, tracked] : mTrackedImages)
+    {
+        for (uint32_t level = 0; level < tracked.mipLevels.size(); ++level)
+        {
+            if (tracked.mipLevels[level] && std::ranges::find(excluded, ImageMipLevel{ image, level }) == excluded.end())
+            {
+                useImage(tracked.image,
+                         level,
+                         1,
+                         image->getPreferredImageLayout(),
+                         stageMask,
+                         ::shaderAccessMask(image->getPreferredImageLayout()));
+            }
+        }
+    }
+}
+
+
+void
+CommandBufferImpl::setFinalImageLayout(const ImageImplPtr& image, VkImageLayout layout)
+{
+    auto& tracked = trackImage(image);
+
+    tracked.finalLayout = layout;
+
+    // All mip levels are left in the layout, including those not accessed by the recorded commands
+    for (auto& state : tracked.mipLevels)
+    {
+        if (!state)
+        {
+            state = MipLevelState{ image->getPreferredImageLayout(), 
+                                   VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, 
+                                   VK_ACCESS_2_NONE, 
+                                   0, 
+                                   0 };
+        }
+    }
+}
+
+
+void
+CommandBufferImpl::flushBarriers()
+{
+    if (mShaderStorageWriteStages != 0)
+    {
+        addMemoryBarrier(mShaderStorageWriteStages,
+                         VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                         VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                         VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT);
+        mShaderStorageWriteStages = 0;
+    }
+
+    if (mPendingImageBarriers.empty() && mPendingBufferBarriers.empty() && mPendingMemoryBarriers.empty())
+    {
+        return;
+    }
+
+    // Barriers for subsequent usages on other queues (e.g. vertex input after an upload) cannot be recorded on
+    // transfer-only queues. These usages are synchronized by the semaphores between the submissions instead.
+    if (mCommandQueue.isTransferOnly())
+    {
+        std::ranges::for_each(mPendingMemoryBarriers, ::restrictToTransferStages<VkMemoryBarrier2>);
+        std::ranges::for_each(mPendingBufferBarriers, ::restrictToTransferStages<VkBufferMemoryBarrier2>);
+        std::ranges::for_each(mPendingImageBarriers, ::restrictToTransferStages<VkImageMemoryBarrier2>);
+    }
+
+    VkDependencyInfo dependencyInfo{ VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    dependencyInfo.memoryBarrierCount       = static_cast<uint32_t>(mPendingMemoryBarriers.size());
+    dependencyInfo.pMemoryBarriers          = mPendingMemoryBarriers.data();
+    dependencyInfo.bufferMemoryBarrierCount = static_cast<uint32_t>(mPendingBufferBarriers.size());
+    dependencyInfo.pBufferMemoryBarriers    = mPendingBufferBarriers.data();
+    dependencyInfo.imageMemoryBarrierCount  = static_cast<uint32_t>(mPendingImageBarriers.size());
+    dependencyInfo.pImageMemoryBarriers     = mPendingImageBarriers.data();
+
+    vkCmdPipelineBarrier2(mCommandBuffer, &dependencyInfo);
+
+    mPendingMemoryBarriers.clear();
+    mPendingBufferBarriers.clear();
+    mPendingImageBarriers.clear();
+
+    // Mip level states referring to the flushed batch are no longer pending
+    mBarrierBatch++;
+}
+
+
+std::vector<VkImageMemoryBarrier2>
+CommandBufferImpl::resolveImageLayouts(OwnershipReleaseBarriers& releaseBarriers)
+{
+    std::vector<VkImageMemoryBarrier2> barriers;
+    std::vector<VkImageLayout> exitLayouts;
+
+    for (auto& [_, tracked] : mTrackedImages)
+    {
+        exitLayouts.assign(tracked.mipLevels.size(), VK_IMAGE_LAYOUT_MAX_ENUM);
+        for (size_t level = 0; level < tracked.mipLevels.size(); ++level)
+        {
+            if (tracked.mipLevels[level])
+            {
+                exitLayouts[level] = tracked.finalLayout;
+            }
+        }
+
+        tracked.image->submitLayouts(exitLayouts, mCommandQueue, barriers, releaseBarriers);
+    }
+
+    return barriers;
+}
+
+
 VkCommandBuffer 
 CommandBufferImpl::getVkCommandBuffer()
 {
@@ -837,3 +2530,12 @@ CommandBufferImpl::releaseRetainedResources()
     std::swap(resources, mRetainedResources);
     return resources;
 }
+
+
+std::vector<Coral::CompletionTokenPtr>
+CommandBufferImpl::releaseCompletionTokens()
+{
+    std::vector<Coral::CompletionTokenPtr> tokens;
+    std::swap(tokens, mCompletionTokens);
+    return tokens;
+}
@@ -4,11 +4,16 @@
 #include "CommandBuffer.hpp"
 
 #include "Fwd.hpp"
+#include "ImageImpl.hpp"
 #include "Resource.hpp"
 #include "Vulkan.hpp"
 
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Coral::Vulkan
@@ -16,6 +21,11 @@ namespace Coral::Vulkan
 
 /*!
  * Implementation of the CommandBuffer interface using the Vulkan backend
+ *
+ * The command buffer tracks the layout and last access of each mip level it uses. Commands declare their image
+ * accesses, which adds the required transitions to a list of pending barriers. All pending barriers are recorded with
+ * a single vkCmdPipelineBarrier2 call right before the command that consumes them. Image layouts left by previously
+ * submitted command buffers are resolved on submission (see CommandQueueImpl::submit).
  */
 class CommandBufferImpl : public Coral::CommandBuffer,
                           public std::enable_shared_from_this<CommandBufferImpl>,
@@ -29,6 +39,10 @@ public:
 
     bool init(const CommandBuffer::CreateConfig& config);
 
+    /// Initialize the command buffer with a command buffer allocated from \p commandPool instead of the per-thread
+    /// command pool of the queue
+    bool init(const CommandBuffer::CreateConfig& config, VkCommandPool commandPool);
+
     bool begin() override; 
 
     bool end() override;
@@ -41,6 +55,8 @@ public:
 
     bool cmdCopyBuffer(const CopyBufferInfo& info) override;
 
+    bool cmdCopyBufferToImage(const CopyBufferToImageInfo& info) override;
+
     bool cmdCopyImage(const CopyImageInfo& info) override;
 
     bool cmdBindVertexBuffer(Coral::BufferPtr buffer, uint32_t binding, size_t offset, size_t stride) override;
@@ -51,13 +67,25 @@ public:
 
     bool cmdDrawIndexed(const CoDrawIndexedInfo& info) override;
 
+    bool cmdDrawIndexedIndirect(const Coral::DrawIndexedIndirectInfo& info) override;
+
+    bool cmdDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override;
+
+    bool cmdDispatchIndirect(Coral::BufferPtr buffer, size_t offset) override;
+
     bool cmdSetViewport(const CoViewportInfo& info) override;
 
     bool cmdUpdateBufferData(const Coral::UpdateBufferDataInfo& info) override;
 
+    bool cmdUpdateBufferDataFromHostMemory(const Coral::UpdateBufferDataInfo& info, Coral::CompletionTokenPtr token) override;
+
     bool cmdUpdateImageData(const Coral::UpdateImageDataInfo& info) override;
 
-    bool cmdGenerateMipMaps(Coral::ImagePtr image) override;
+    Coral::ReadbackPtr cmdReadbackBuffer(Coral::BufferPtr source, size_t offset, size_t size) override;
+
+    Coral::ReadbackPtr cmdReadbackImage(const Coral::ReadbackImageInfo& info) override;
+
+    bool cmdGenerateMipMaps(Coral::ImagePtr image, CoMipReduction reduction) override;
 
     void cmdBindDescriptor(Coral::BufferPtr buffer, uint32_t binding) override;
 
@@ -65,15 +93,158 @@ public:
 
     void cmdBindDescriptor(Coral::ImagePtr image, uint32_t binding) override;
 
+    void cmdBindDescriptor(Coral::ImagePtr image, const Coral::ImageViewConfig& view, uint32_t binding) override;
+
     bool cmdBlitImage(Coral::ImagePtr source, Coral::ImagePtr dest) override;
 
     VkCommandBuffer getVkCommandBuffer();
 
+    /// Declare the access of the next recorded command to mip levels of the image
+    /**
+     * The layout transition or memory dependency required for the access is added to the pending barriers, which are
+     * recorded by the next call to flushBarriers. Reads in the same layout as the previous access do not require a
+     * barrier.
+     */
+    void useImage(const ImageImplPtr& image, 
+                  uint32_t firstMipLevel, 
+                  uint32_t levelCount, 
+                  VkImageLayout layout, 
+                  VkPipelineStageFlags2 stageMask, 
+                  VkAccessFlags2 accessMask);
+
+    /// Leave the image in the given layout at the end of the command buffer instead of its preferred layout
+    /**
+     * Used for swapchain images, which must be in VK_IMAGE_LAYOUT_PRESENT_SRC_KHR for presentation.
+     */
+    void setFinalImageLayout(const ImageImplPtr& image, VkImageLayout layout);
+
+    /// Resolve the layouts of the images used by the command buffer on submission
+    /**
+     * Returns the barriers transitioning the used images from the layouts left by previously submitted command buffers
+     * into the layouts expected by this command buffer. The barriers must execute before the command buffer. Must be
+     * called in submission order.
+     *
+     * Images last used on a queue of another queue family are acquired by the returned barriers. The matching release
+     * barriers are added to \p releaseBarriers under the queue that must execute them.
+     */
+    [[nodiscard]] std::vector<VkImageMemoryBarrier2> resolveImageLayouts(OwnershipReleaseBarriers& releaseBarriers);
+
     [[nodiscard]] std::unordered_set<ResourcePtr> releaseRetainedResources();
 
+    /// Release the completion tokens of the recorded commands
+    /**
+     * The tokens must be completed once the command buffer finished execution.
+     */
+    [[nodiscard]] std::vector<Coral::CompletionTokenPtr> releaseCompletionTokens();
+
 private:
 
-    void cmdBindCachedDescriptors();
+    /// Push the cached descriptors declared by the shaders of the pipeline
+    /**
+     * Returns false without pushing any descriptor if a bound resource does not support the descriptor type declared
+     * by the pipeline.
+     */
+    [[nodiscard]] bool cmdBindCachedDescriptors(PipelineStateImpl& pipeline);
+
+    /// Check that the cached resources support the descriptor types declared by the shaders of the pipeline
+    bool validateCachedDescriptors(PipelineStateImpl& pipeline) const;
+
+    /// Make prior writes visible to the compute shader and push the descriptors of the bound compute pipeline
+    bool prepareDispatch();
+
+    /// Push the descriptors of the bound graphics pipeline. Fails outside of render passes.
+    bool prepareDraw();
+
+    /// Generate all mip levels of the image with a single compute dispatch
+    bool cmdGenerateMipMapsCompute(const ImageImplPtr& image, CoMipReduction reduction, MipGenerator& generator);
+
+    /// Generate the mip levels of the image with one blit per mip level
+    void cmdGenerateMipMapsBlit(const ImageImplPtr& image);
+
+    /// Make transfer writes to the buffer visible to all usages of the buffer
+    void addTransferWriteBarrier(BufferImpl& buffer);
+
+    /// Add a buffer memory dependency to the pending barriers
+    void addBufferBarrier(VkBuffer buffer, 
+                          VkDeviceSize offset, 
+                          VkDeviceSize size, 
+                          VkPipelineStageFlags2 srcStageMask, 
+                          VkAccessFlags2 srcAccessMask, 
+                          VkPipelineStageFlags2 dstStageMask, 
+                          VkAccessFlags2 dstAccessMask);
+
+    /// Add a global memory dependency to the pending barriers
+    void addMemoryBarrier(VkPipelineStageFlags2 srcStageMask, 
+                          VkAccessFlags2 srcAccessMask, 
+                          VkPipelineStageFlags2 dstStageMask, 
+                          VkAccessFlags2 dstAccessMask);
+
+    /// Record all pending barriers with a single vkCmdPipelineBarrier2 call
+    void flushBarriers();
+
+    /// Mip level of an image
+    using ImageMipLevel = std::pair<const ImageImpl*, uint32_t>;
+
+    /// Declare shader access through descriptors to all mip levels used by previous commands, except \p excluded
+    /**
+     * Descriptors reference images in their preferred layout. Mip levels left in a different layout or with pending
+     * writes are transitioned before the next draw. Storage images are accessed in the general layout and may be
+     * written by the next draws.
+     */
+    void useImagesForShaderAccess(std::span<const ImageMipLevel> excluded, VkPipelineStageFlags2 stageMask);
+
+    /// Cache the image descriptor of \p binding referencing \p mipLevelCount mip levels starting at \p baseMipLevel
+    void bindImageDescriptor(const ImageImplPtr& image,
+                             VkImageView imageView,
+                             uint32_t baseMipLevel,
+                             uint32_t mipLevelCount,
+                             uint32_t binding);
+
+    /// Range of mip levels of an image referenced by a descriptor
+    struct DescriptorImage
+    {
+        ImageImplPtr image;
+        uint32_t baseMipLevel;
+        uint32_t mipLevelCount;
+    };
+
+    /// Record a write by the shaders of the next draw to the mip levels referenced by a storage image descriptor
+    /**
+     * The write is performed within the render pass, after all pending barriers were recorded. Hence, only the state
+     * of the mip levels is updated, such that subsequent accesses wait for the write.
+     */
+    void recordStorageImageWrite(const DescriptorImage& image, VkPipelineStageFlags2 stageMask);
+
+    /// State of a mip level within the command buffer
+    struct MipLevelState
+    {
+        VkImageLayout layout;
+        /// Stages and accesses of the commands since the last barrier of the mip level
+        VkPipelineStageFlags2 stageMask;
+        VkAccessFlags2 accessMask;
+        /// Barrier batch and index of the pending barrier of the mip level
+        uint64_t barrierBatch;
+        size_t barrierIndex;
+    };
+
+    /// Image used by the recorded commands
+    struct TrackedImage
+    {
+        ImageImplPtr image;
+        /// State of each mip level, empty for mip levels not used by the recorded commands
+        std::vector<std::optional<MipLevelState>> mipLevels;
+        /// Layout the image is left in at the end of the command buffer
+        VkImageLayout finalLayout;
+    };
+
+    TrackedImage& trackImage(const ImageImplPtr& image);
+
+    /// Transition the mip level into a new state and update its pending barrier
+    void transitionMipLevel(TrackedImage& tracked, 
+                            uint32_t mipLevel, 
+                            VkImageLayout layout, 
+                            VkPipelineStageFlags2 stageMask, 
+                            VkAccessFlags2 accessMask);
 
     CommandQueueImpl& mCommandQueue;
 
@@ -87,12 +258,42 @@ private:
 
     PipelineStateImplPtr mLastBoundPipelineState{ nullptr };
 
+    PipelineStateImplPtr mLastBoundComputePipelineState{ nullptr };
+
+    bool mInsideRenderPass{ false };
+
     std::unordered_set<ResourcePtr> mRetainedResources;
 
+    std::vector<Coral::CompletionTokenPtr> mCompletionTokens;
+
     std::unordered_map<uint32_t, std::variant<VkDescriptorBufferInfo, VkDescriptorImageInfo>> mCachedDescriptorInfos;
 
+    /// Images referenced by the cached image descriptors
+    std::unordered_map<uint32_t, DescriptorImage> mCachedDescriptorImages;
+
+    /// Buffers referenced by the cached buffer descriptors
+    std::unordered_map<uint32_t, BufferImplPtr> mCachedDescriptorBuffers;
+
+    /// Shader stages that wrote through storage descriptors since the last barrier
+    /**
+     * Storage buffer writes are not tracked per buffer. A global memory barrier makes them visible to all subsequent
+     * commands when the next barriers are recorded.
+     */
+    VkPipelineStageFlags2 mShaderStorageWriteStages{ 0 };
+
     std::vector<VkWriteDescriptorSet> mDescriptorWrites;
 
+    std::unordered_map<ImageImpl*, TrackedImage> mTrackedImages;
+
+    std::vector<VkImageMemoryBarrier2> mPendingImageBarriers;
+
+    std::vector<VkBufferMemoryBarrier2> mPendingBufferBarriers;
+
+    std::vector<VkMemoryBarrier2> mPendingMemoryBarriers;
+
+    /// Index of the batch of pending barriers, incremented with each flush
+    uint64_t mBarrierBatch{ 0 };
+
 }; // class CommandBufferImpl
 
 } // namespace Coral::Vulkan
@@ -1,10 +1,14 @@
 #include "CommandQueueImpl.hpp"
 
 #include "CommandBufferImpl.hpp"
+#include "CompletionToken.hpp"
 #include "FenceImpl.hpp"
 #include "SemaphoreImpl.hpp"
 #include "SwapchainImpl.hpp"
+#include "UploadQueueImpl.hpp"
+#include "VulkanFormat.hpp"
 
+#include <chrono>
 #include <future>
 
 
@@ -27,6 +31,11 @@ CommandQueueImpl::~CommandQueueImpl()
     {
         vkDestroyCommandPool(context().getVkDevice(), commandPool, nullptr);
     }
+
+    if (mTransitionCommandPool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(context().getVkDevice(), mTransitionCommandPool, nullptr);
+    }
 }
 
 
@@ -48,15 +57,44 @@ CommandQueueImpl::createCommandBuffer(const Coral::CommandBuffer::CreateConfig&
 bool
 CommandQueueImpl::submit(const Coral::CommandBufferSubmitInfo& info, Coral::FencePtr fence)
 {
+    return submit(info, fence, std::nullopt);
+}
+
+
+bool
+CommandQueueImpl::submit(const Coral::CommandBufferSubmitInfo& info,
+                         Coral::FencePtr fence,
+                         std::optional<TimelineSemaphoreValue> signal)
+{
+    // Pending uploads are submitted before locking the queue, since the upload queue submits to the transfer queue,
+    // which might be this queue. Their layout transitions are resolved before the ones of the command buffers.
+    std::optional<TimelineSemaphoreValue> uploadWait;
+    if (info.waitUploadToken != 0)
+    {
+        auto uploadQueue = static_cast<UploadQueueImpl*>(context().getUploadQueue());
+        if (!uploadQueue || !uploadQueue->flush(info.waitUploadToken))
+        {
+            return false;
+        }
+
+        if (!uploadQueue->isComplete(info.waitUploadToken))
+        {
+            uploadWait = TimelineSemaphoreValue{ uploadQueue->getVkSemaphore(), info.waitUploadToken };
+        }
+    }
+
     std::lock_guard lock(mQueueProtection);
 
     std::vector<VkSemaphore> waitSemaphores;
     std::vector<VkPipelineStageFlags> waitFlags;
-    for (auto semaphore : info.waitSemaphores)
+    for (size_t i = 0; i < info.waitSemaphores.size(); ++i)
     {
-        waitSemaphores.push_back(std::static_pointer_cast<Vulkan::SemaphoreImpl>(semaphore)->getVkSemaphore());
-        // Wait with execution of all commands until all semaphores are signaled
-        waitFlags.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        auto semaphore = std::static_pointer_cast<Vulkan::SemaphoreImpl>(info.waitSemaphores[i]);
+        waitSemaphores.push_back(semaphore->getVkSemaphore());
+        // Without stage masks, execution of all commands waits until all semaphores are signaled. Layout transitions
+        // resolved on submission wait for all semaphores in any case.
+        waitFlags.push_back(i < info.waitStageMasks.size() ? convert(info.waitStageMasks[i])
+                                                             : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
     }
 
     std::vector<VkSemaphore> signalSemaphores;
@@ -67,13 +105,68 @@ CommandQueueImpl::submit(const Coral::CommandBufferSubmitInfo& info, Coral::Fenc
 
     // Collect all command buffers and staging buffers used in the command buffers
     std::vector<VkCommandBuffer> commandBuffers;
+    std::vector<VkCommandBuffer> transitionCommandBuffers;
     std::unordered_set<ResourcePtr> retainedResources;
+    std::vector<Coral::CompletionTokenPtr> completionTokens;
+    OwnershipReleaseBarriers releaseBarriers;
 
     for (auto commandBuffer : info.commandBuffers)
     {
         auto commandBufferImpl = std::static_pointer_cast<Vulkan::CommandBufferImpl>(commandBuffer);
+
+        // Command buffers expect the images they use in their preferred layout. Images left in another layout by
+        // previous submissions (e.g. new or presented images) are transitioned by a command buffer executed right
+        // before. Resolving the layouts while holding the queue lock keeps them in submission order.
+        auto transitions = commandBufferImpl->resolveImageLayouts(releaseBarriers);
+        if (!transitions.empty())
+        {
+            auto transitionCommandBuffer = recordLayoutTransitions(transitions);
+            if (transitionCommandBuffer != VK_NULL_HANDLE)
+            {
+                commandBuffers.push_back(transitionCommandBuffer);
+                transitionCommandBuffers.push_back(transitionCommandBuffer);
+            }
+        }
+
         commandBuffers.push_back(commandBufferImpl->getVkCommandBuffer());
         retainedResources.insert_range(commandBufferImpl->releaseRetainedResources());
+        completionTokens.append_range(commandBufferImpl->releaseCompletionTokens());
+    }
+
+    // The commands of a failed submission are never executed. Fail their tokens so that waiting threads do not
+    // mistake them for executed commands and return the transition command buffers for reuse.
+    auto failSubmission = [&]
+    {
+        for (auto& token : completionTokens)
+        {
+            token->complete(false);
+        }
+
+        std::lock_guard transitionLock(mTransitionProtection);
+        mIdleTransitionCommandBuffers.append_range(transitionCommandBuffers);
+        return false;
+    };
+
+    // Images last used by a queue of another queue family are released by the queue that last used them, which orders
+    // the release after the prior work of that queue. The transition command buffers acquiring them wait for the
+    // releases.
+    for (auto& [owner, barriers] : releaseBarriers)
+    {
+        auto semaphore = context().createSemaphore({});
+        if (!semaphore)
+        {
+            return failSubmission();
+        }
+
+        auto semaphoreImpl = std::static_pointer_cast<Vulkan::SemaphoreImpl>(*semaphore);
+        if (!owner->submitOwnershipRelease(barriers, semaphoreImpl->getVkSemaphore()))
+        {
+            return failSubmission();
+        }
+
+        waitSemaphores.push_back(semaphoreImpl->getVkSemaphore());
+        waitFlags.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        retainedResources.insert(semaphoreImpl);
     }
 
     // Coral does automatically create staging buffers for CPU <-> GPU copy operations. To reduce buffer allocations, 
@@ -83,16 +176,44 @@ CommandQueueImpl::submit(const Coral::CommandBufferSubmitInfo& info, Coral::Fenc
     // command queue keeps track of the count of in-flight staging buffers. Only after the semaphore is signaled
     // decrement the count. Idling the command queue must wait until the in-flight staging buffer count is 0.
 
+    // Completion tokens of the recorded commands are completed by the same task after the fence was signaled. Layout
+    // transition command buffers are returned for reuse.
+
+    bool needsRetainTask = !retainedResources.empty() || !completionTokens.empty() || !transitionCommandBuffers.empty();
+
     // If an external fence is used, reuse this fence, otherwise create a temporary fence object.
-    if (!retainedResources.empty() && !fence)
+    if (needsRetainTask && !fence)
     {
         fence = context().createFence({}).value();
     }
 
     auto fenceImpl = std::static_pointer_cast<Vulkan::FenceImpl>(fence);
 
+    // Binary semaphores ignore their values in the timeline semaphore submit info
+    std::vector<uint64_t> waitValues(waitSemaphores.size(), 0);
+    std::vector<uint64_t> signalValues(signalSemaphores.size(), 0);
+
+    if (uploadWait)
+    {
+        waitSemaphores.push_back(uploadWait->semaphore);
+        waitFlags.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        waitValues.push_back(uploadWait->value);
+    }
+
+    if (signal)
+    {
+        signalSemaphores.push_back(signal->semaphore);
+        signalValues.push_back(signal->value);
+    }
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineInfo.pWaitSemaphoreValues      = waitValues.data();
+    timelineInfo.waitSemaphoreValueCount   = static_cast<uint32_t>(waitValues.size());
+    timelineInfo.pSignalSemaphoreValues    = signalValues.data();
+    timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalValues.size());
+
     VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
-    submitInfo.pNext                = nullptr;
+    submitInfo.pNext                = (uploadWait || signal) ? &timelineInfo : nullptr;
     submitInfo.pCommandBuffers      = commandBuffers.data();
     submitInfo.commandBufferCount   = static_cast<uint32_t>(commandBuffers.size());
     submitInfo.pSignalSemaphores    = signalSemaphores.data();
@@ -101,42 +222,92 @@ CommandQueueImpl::submit(const Coral::CommandBufferSubmitInfo& info, Coral::Fenc
     submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(waitSemaphores.size());
     submitInfo.pWaitDstStageMask    = waitFlags.data();
 
-    if (vkQueueSubmit(mQueue, 1, &submitInfo, fenceImpl ? fenceImpl->getVkFence() : VK_NULL_HANDLE) != VK_SUCCESS)
+    VkResult result{ VK_SUCCESS };
     {
-        return false;
+        std::lock_guard submitLock(mSubmitProtection);
+        result = vkQueueSubmit(mQueue, 1, &submitInfo, fenceImpl ? fenceImpl->getVkFence() : VK_NULL_HANDLE);
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        return failSubmission();
     }
 
     // Add the async task that waits for the command buffer execution to release the staging buffers
-    if (!retainedResources.empty())
+    if (needsRetainTask)
     {
-        // Increment the count of in-flight staging buffers
-        mResourcesInFlight += retainedResources.size();
+        addRetainTask(fence,
+                      std::move(retainedResources),
+                      std::move(completionTokens),
+                      std::move(transitionCommandBuffers));
+    }
 
-        // Transfer ownership of the staging buffers to the async task
-        auto task = [stagingBuffers = std::move(retainedResources), fence = fence, this]() mutable
-        {
-            // Wait until the fence is signaled
-            fence->wait(UINT64_MAX);
+    return true;
+}
 
-            auto count = stagingBuffers.size();
-            // Clear all staging buffers (this reduces the use count of the shared ptr which effectively  returns
-            // them to the pool.
-            stagingBuffers.clear();
-            // Decrement the count of in-flight staging buffers
-            mResourcesInFlight -= count;
-        };
 
-        auto future = std::async(std::launch::async, std::move(task));
-    }
+void
+CommandQueueImpl::addRetainTask(Coral::FencePtr fence,
+                                std::unordered_set<ResourcePtr> resources,
+                                std::vector<Coral::CompletionTokenPtr> tokens,
+                                std::vector<VkCommandBuffer> transitionCommandBuffers)
+{
+    auto count = resources.size() + tokens.size() + transitionCommandBuffers.size();
+
+    // Increment the count of in-flight staging buffers
+    mResourcesInFlight += count;
+
+    // Transfer ownership of the staging buffers to the async task
+    auto task = [stagingBuffers = std::move(resources),
+                 tokens = std::move(tokens),
+                 transitions = std::move(transitionCommandBuffers),
+                 fence = fence,
+                 count,
+                 this]() mutable
+    {
+        // Wait until the fence is signaled
+        fence->wait(UINT64_MAX);
 
-    return true;
+        // Clear all staging buffers (this reduces the use count of the shared ptr which effectively  returns
+        // them to the pool.
+        stagingBuffers.clear();
+
+        // The resources used by the commands are released, notify the token owners
+        for (auto& token : tokens)
+        {
+            token->complete(true);
+        }
+
+        if (!transitions.empty())
+        {
+            std::lock_guard lock(mTransitionProtection);
+            mIdleTransitionCommandBuffers.append_range(transitions);
+        }
+
+        // Decrement the count of in-flight staging buffers and wake up threads waiting for the retain tasks
+        mResourcesInFlight -= count;
+        mResourcesInFlight.notify_all();
+    };
+
+    // Keep the future alive, since destroying a future returned by std::async blocks until the task finished,
+    // which would stall the submitting thread until the GPU finished the work.
+    std::lock_guard lock(mRetainTasksProtection);
+    std::erase_if(mRetainTasks, [](auto& future)
+    {
+        return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+    mRetainTasks.push_back(std::async(std::launch::async, std::move(task)));
 }
 
 
 void
 CommandQueueImpl::awaitRetainTasks()
 {
-    while (mResourcesInFlight > 0);
+    // Block until the retain tasks released all resources instead of spinning for the duration of the GPU work
+    for (auto count = mResourcesInFlight.load(); count > 0; count = mResourcesInFlight.load())
+    {
+        mResourcesInFlight.wait(count);
+    }
 }
 
 
@@ -149,7 +320,11 @@ CommandQueueImpl::waitIdle()
     }
 
     // Wait for the queue to finish processing all commands
-    auto success = vkQueueWaitIdle(mQueue) == VK_SUCCESS;
+    bool success{ false };
+    {
+        std::lock_guard lock(mSubmitProtection);
+        success = vkQueueWaitIdle(mQueue) == VK_SUCCESS;
+    }
 
     awaitRetainTasks();
 
@@ -166,6 +341,123 @@ CommandQueueImpl::submit(const Coral::PresentInfo& info)
 }
 
 
+bool
+CommandQueueImpl::isTransferOnly()
+{
+    return mQueueFamilyIndex != context().getQueueFamilyIndex();
+}
+
+
+bool
+CommandQueueImpl::submitOwnershipRelease(const std::vector<VkImageMemoryBarrier2>& barriers, VkSemaphore semaphore)
+{
+    auto commandBuffer = recordLayoutTransitions(barriers);
+    if (commandBuffer == VK_NULL_HANDLE)
+    {
+        return false;
+    }
+
+    auto fence = context().createFence({});
+    if (!fence)
+    {
+        std::lock_guard lock(mTransitionProtection);
+        mIdleTransitionCommandBuffers.push_back(commandBuffer);
+        return false;
+    }
+
+    VkSubmitInfo submitInfo{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
+    submitInfo.pCommandBuffers      = &commandBuffer;
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.pSignalSemaphores    = &semaphore;
+    submitInfo.signalSemaphoreCount = 1;
+
+    auto fenceImpl = std::static_pointer_cast<Vulkan::FenceImpl>(*fence);
+
+    // Only the VkQueue is locked. Locking the whole queue could deadlock with a submission of this queue releasing
+    // images to the queue family of the caller.
+    VkResult result{ VK_SUCCESS };
+    {
+        std::lock_guard lock(mSubmitProtection);
+        result = vkQueueSubmit(mQueue, 1, &submitInfo, fenceImpl->getVkFence());
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        std::lock_guard lock(mTransitionProtection);
+        mIdleTransitionCommandBuffers.push_back(commandBuffer);
+        return false;
+    }
+
+    addRetainTask(*fence, {}, {}, { commandBuffer });
+
+    return true;
+}
+
+
+VkResult
+CommandQueueImpl::present(const VkPresentInfoKHR& info)
+{
+    std::lock_guard lock(mSubmitProtection);
+    return vkQueuePresentKHR(mQueue, &info);
+}
+
+
+VkCommandBuffer
+CommandQueueImpl::recordLayoutTransitions(const std::vector<VkImageMemoryBarrier2>& barriers)
+{
+    auto device = context().getVkDevice();
+
+    // Other queues record ownership releases with the command pool while submitting
+    std::lock_guard lock(mTransitionProtection);
+
+    if (mTransitionCommandPool == VK_NULL_HANDLE)
+    {
+        VkCommandPoolCreateInfo createInfo{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+        createInfo.queueFamilyIndex = mQueueFamilyIndex;
+        createInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | 
+                                      VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+        if (vkCreateCommandPool(device, &createInfo, nullptr, &mTransitionCommandPool) != VK_SUCCESS)
+        {
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
+    if (!mIdleTransitionCommandBuffers.empty())
+    {
+        commandBuffer = mIdleTransitionCommandBuffers.back();
+        mIdleTransitionCommandBuffers.pop_back();
+    }
+
+    if (commandBuffer == VK_NULL_HANDLE)
+    {
+        VkCommandBufferAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+        allocInfo.commandPool        = mTransitionCommandPool;
+        allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS)
+        {
+            return VK_NULL_HANDLE;
+        }
+    }
+
+    // Beginning the command buffer implicitly resets previous recordings
+    VkCommandBufferBeginInfo beginInfo{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    VkDependencyInfo dependencyInfo{ VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+    dependencyInfo.pImageMemoryBarriers    = barriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    vkEndCommandBuffer(commandBuffer);
+
+    return commandBuffer;
+}
+
+
 VkCommandPool
 CommandQueueImpl::getVkCommandPool()
 {
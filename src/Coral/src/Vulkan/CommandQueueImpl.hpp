@@ -7,9 +7,15 @@
 #include "Resource.hpp"
 #include "Vulkan.hpp"
 
+#include <atomic>
+#include <future>
+#include <list>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Coral::Vulkan
 {
@@ -28,14 +34,41 @@ public:
 
     std::expected<Coral::CommandBufferPtr, Coral::CommandBuffer::CreateError> createCommandBuffer(const Coral::CommandBuffer::CreateConfig& config) override;
 
+    /// Value of a timeline semaphore
+    struct TimelineSemaphoreValue
+    {
+        VkSemaphore semaphore{ VK_NULL_HANDLE };
+
+        uint64_t value{ 0 };
+    };
+
     bool submit(const Coral::CommandBufferSubmitInfo& info, FencePtr fence) override;
 
+    /// Submit a sequence of command buffers and set the timeline semaphore to the value once their execution finished
+    bool submit(const Coral::CommandBufferSubmitInfo& info,
+                FencePtr fence,
+                std::optional<TimelineSemaphoreValue> signal);
+
     bool submit(const Coral::PresentInfo& info) override;
 
     bool waitIdle() override;
 
     uint32_t getQueueIndex() { return mQueueIndex; }
 
+    uint32_t getQueueFamilyIndex() const { return mQueueFamilyIndex; }
+
+    /// Check if the queue belongs to a dedicated transfer queue family that only supports copy commands
+    bool isTransferOnly();
+
+    /// Submit the release of the queue family ownership of image subresources to another queue family
+    /**
+     * The release executes after all previously submitted commands of the queue finished and signals \p semaphore.
+     */
+    bool submitOwnershipRelease(const std::vector<VkImageMemoryBarrier2>& barriers, VkSemaphore semaphore);
+
+    /// Present a swapchain image with the queue
+    VkResult present(const VkPresentInfoKHR& info);
+
     VkCommandPool getVkCommandPool();
 
     VkQueue getVkQueue();
@@ -44,8 +77,21 @@ private:
 
     void awaitRetainTasks();
 
+    /// Release the resources, complete the tokens and recycle the layout transition command buffers once the fence is
+    /// signaled
+    void addRetainTask(Coral::FencePtr fence,
+                       std::unordered_set<ResourcePtr> resources,
+                       std::vector<Coral::CompletionTokenPtr> tokens,
+                       std::vector<VkCommandBuffer> transitionCommandBuffers);
+
+    /// Record a command buffer executing the layout transitions resolved when submitting a command buffer
+    VkCommandBuffer recordLayoutTransitions(const std::vector<VkImageMemoryBarrier2>& barriers);
+
     std::mutex mQueueProtection;
 
+    /// Protects the VkQueue, which is also used by other queues submitting ownership releases
+    std::mutex mSubmitProtection;
+
     VkQueue mQueue{ VK_NULL_HANDLE };
 
     uint32_t mQueueIndex{ 0 };
@@ -56,6 +102,18 @@ private:
 
     std::atomic<size_t> mResourcesInFlight{ 0 };
 
+    std::list<std::future<void>> mRetainTasks;
+
+    std::mutex mRetainTasksProtection;
+
+    /// Command pool of the layout transition command buffers
+    VkCommandPool mTransitionCommandPool{ VK_NULL_HANDLE };
+
+    /// Layout transition command buffers that finished execution and can be recorded again
+    std::vector<VkCommandBuffer> mIdleTransitionCommandBuffers;
+
+    std::mutex mTransitionProtection;
+
 }; // class CommandQueueImpl
 
 } // namespace Coral::Vulkan
@@ -6,30 +6,73 @@
 #include "FenceImpl.hpp"
 #include "FramebufferImpl.hpp"
 #include "ImageImpl.hpp"
+#include "MipGenerator.hpp"
 #include "PipelineStateImpl.hpp"
+#include "RenderTargetPool.hpp"
 #include "SamplerImpl.hpp"
 #include "SemaphoreImpl.hpp"
 #include "ShaderModuleImpl.hpp"
 #include "SwapchainImpl.hpp"
+#include "UploadQueueImpl.hpp"
 #include "VulkanFormat.hpp"
 
 #include <array>
+#include <bit>
 #include <cassert>
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <mutex>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 
 using namespace Coral::Vulkan;
 
+namespace
+{
+
+/// Duplicate a POSIX file descriptor. Returns -1 on failure and on platforms without file descriptors.
+int
+duplicateFd(int fd)
+{
+#ifdef _WIN32
+    return -1;
+#else
+    return dup(fd);
+#endif
+}
+
+
+void
+closeFd(int fd)
+{
+#ifndef _WIN32
+    close(fd);
+#endif
+}
+
+} // namespace
+
 ContextImpl::~ContextImpl()
 {
     mStagingBufferPool.reset();
+    mReadbackBufferPool.reset();
+    mScratchBufferPool.reset();
+    mMipGenerator.reset();
+
+    // The upload queue waits for its pending batches, which are submitted to the transfer queue
+    mUploadQueue.reset();
 
     mTransferQueue.reset();     
     mGraphicsQueue.reset();
     mComputeQueue.reset();
 
+    // The pool frees the memory of its render targets, hence it is destroyed after pending submissions released them
+    mRenderTargetPool.reset();
+
     if (mAllocator != VK_NULL_HANDLE)
     {
         vmaDestroyAllocator(mAllocator);
@@ -83,9 +126,16 @@ ContextImpl::init(const Context::CreateConfig& config)
 
     std::string appName = config.pApplicationName ? config.pApplicationName : "Coral";
 
+    // Surface extensions are only needed to present into a window. If they are not requested or not available (e.g.
+    // in CI or on render farms without a display), the context is created headless and only supports offscreen 
+    // rendering into framebuffer images.
+    auto systemInfo = vkb::SystemInfo::get_system_info();
+    mHeadless = config.headless || !systemInfo || !systemInfo->is_extension_available(VK_KHR_SURFACE_EXTENSION_NAME);
+
     vkb::InstanceBuilder builder;
     auto instance = builder
         .set_app_name(appName.c_str())
+        .set_headless(mHeadless)
         .request_validation_layers(requestValidationLayers)
         .use_default_debug_messenger()
         .require_api_version(1, 3, 0)
@@ -139,15 +189,63 @@ ContextImpl::init(const Context::CreateConfig& config)
 
     mPhysicalDevice = physicalDevice->physical_device;
 
+    // Optional extensions
+    mHostMemoryImportSupported    = physicalDevice->enable_extension_if_present(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+    mExternalMemoryFdSupported    = physicalDevice->enable_extension_if_present(VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME);
+    mExternalSemaphoreFdSupported = physicalDevice->enable_extension_if_present(VK_KHR_EXTERNAL_SEMAPHORE_FD_EXTENSION_NAME);
+    mMemoryBudgetSupported        = physicalDevice->enable_extension_if_present(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    // Optional features. Block-compressed formats are enabled per family since devices typically support only some
+    // of them (e.g. BC on desktop, ETC2/ASTC on mobile). Use isImageFormatSupported() to query individual formats.
+    VkPhysicalDeviceFeatures compressionBC{};
+    compressionBC.textureCompressionBC = VK_TRUE;
+    physicalDevice->enable_features_if_present(compressionBC);
+
+    VkPhysicalDeviceFeatures compressionETC2{};
+    compressionETC2.textureCompressionETC2 = VK_TRUE;
+    physicalDevice->enable_features_if_present(compressionETC2);
+
+    VkPhysicalDeviceFeatures compressionASTC{};
+    compressionASTC.textureCompressionASTC_LDR = VK_TRUE;
+    physicalDevice->enable_features_if_present(compressionASTC);
+
+    VkPhysicalDeviceFeatures cubeArray{};
+    cubeArray.imageCubeArray = VK_TRUE;
+    mImageCubeArraySupported = physicalDevice->enable_features_if_present(cubeArray);
+
+    // Required by the single-pass mip generation, which writes images of any float format through a single shader
+    VkPhysicalDeviceFeatures storageWriteWithoutFormat{};
+    storageWriteWithoutFormat.shaderStorageImageWriteWithoutFormat = VK_TRUE;
+    mStorageImageWriteWithoutFormatSupported = physicalDevice->enable_features_if_present(storageWriteWithoutFormat);
+
+    // Required by indirect draws with more than one draw and by indirect draws with a draw count read from a buffer
+    VkPhysicalDeviceFeatures multiDrawIndirect{};
+    multiDrawIndirect.multiDrawIndirect = VK_TRUE;
+    mMultiDrawIndirectSupported = physicalDevice->enable_features_if_present(multiDrawIndirect);
+
+    VkPhysicalDeviceVulkan12Features drawIndirectCount{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+    drawIndirectCount.drawIndirectCount = VK_TRUE;
+    mDrawIndirectCountSupported = physicalDevice->enable_extension_features_if_present(drawIndirectCount);
+
+    // Required by graphics pipelines whose vertex or fragment shaders write storage buffers or storage images
+    VkPhysicalDeviceFeatures vertexPipelineStores{};
+    vertexPipelineStores.vertexPipelineStoresAndAtomics = VK_TRUE;
+    mVertexPipelineStoresSupported = physicalDevice->enable_features_if_present(vertexPipelineStores);
+
+    VkPhysicalDeviceFeatures fragmentStores{};
+    fragmentStores.fragmentStoresAndAtomics = VK_TRUE;
+    mFragmentStoresSupported = physicalDevice->enable_features_if_present(fragmentStores);
+
     std::optional<uint32_t> queueFamilyIndex;
     // Look for a device queue family that supports GRAPHICS, COMPUTE and 
     // TRANSFER in one, so we don't need command pool for different queue
     // families. Ideally, the queue family also for a dedicated queue for each
     // queue type.
-    uint32_t index{ 0 };
     auto queueFamilies = physicalDevice->get_queue_families();
-    for (const auto& queueFamily : queueFamilies)
+    for (uint32_t index = 0; index < queueFamilies.size(); ++index)
     {
+        const auto& queueFamily = queueFamilies[index];
+
         // We don't need to check for VK_QUEUE_TRANSFER_BIT explicitely.
         // 
         // All commands that are allowed on a queue that supports transfer 
@@ -165,7 +263,11 @@ ContextImpl::init(const Context::CreateConfig& config)
             continue;
         }
 
-        queueFamilyIndex = index;
+        // Prefer the suitable queue family with the most queues
+        if (!queueFamilyIndex || queueFamily.queueCount > queueFamilies[*queueFamilyIndex].queueCount)
+        {
+            queueFamilyIndex = index;
+        }
 
         // We found a queue family that supports three or more queues. We
         // consider this as optimal so we can have dedicated GRAPHICS, COMPUTE 
@@ -174,7 +276,6 @@ ContextImpl::init(const Context::CreateConfig& config)
         {
             break;
         }
-        index++;
     }
 
     if (!queueFamilyIndex)
@@ -183,15 +284,40 @@ ContextImpl::init(const Context::CreateConfig& config)
     }
 
     mQueueFamilyIndex = *queueFamilyIndex;
+    mQueueFamilyIndices.assign(1, mQueueFamilyIndex);
 
-    auto numDedicatedQueues = std::min(static_cast<uint32_t>(queueFamilies.size()), 3u);
+    // Discrete GPUs expose their DMA engines as a queue family that only supports transfer operations. Copies on such
+    // a queue do not compete with rendering for the graphics queue.
+    std::optional<uint32_t> transferQueueFamilyIndex;
+    for (uint32_t index = 0; index < queueFamilies.size(); ++index)
+    {
+        auto flags = queueFamilies[index].queueFlags;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) != 0 &&
+            (flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) == 0 &&
+            queueFamilies[index].queueCount > 0)
+        {
+            transferQueueFamilyIndex = index;
+            mQueueFamilyIndices.push_back(index);
+            break;
+        }
+    }
+
+    // The number of queues is limited by the queue family, not by the number of queue families. With a dedicated
+    // transfer queue family, the queue family only provides the graphics and compute queues.
+    auto numDedicatedQueues = std::min(queueFamilies[mQueueFamilyIndex].queueCount, transferQueueFamilyIndex ? 2u : 3u);
 
     std::vector<float> priorities(numDedicatedQueues, 1.f);
 
-    vkb::CustomQueueDescription queueDescription{ mQueueFamilyIndex, priorities };
+    std::vector<vkb::CustomQueueDescription> queueDescriptions;
+    queueDescriptions.emplace_back(mQueueFamilyIndex, priorities);
+
+    if (transferQueueFamilyIndex)
+    {
+        queueDescriptions.emplace_back(*transferQueueFamilyIndex, std::vector<float>{ 1.f });
+    }
 
     vkb::DeviceBuilder deviceBuilder{ physicalDevice.value()};
-    auto device = deviceBuilder.custom_queue_setup({ queueDescription })
+    auto device = deviceBuilder.custom_queue_setup(queueDescriptions)
                                .build();
 
     if (!device)
@@ -221,9 +347,10 @@ ContextImpl::init(const Context::CreateConfig& config)
             vkGetDeviceQueue(mDevice, mQueueFamilyIndex, 0, &queue0);
             vkGetDeviceQueue(mDevice, mQueueFamilyIndex, 1, &queue1);
 
+            // Async compute and transfer work share the second queue to overlap with the graphics queue
             mGraphicsQueue = std::make_shared<Coral::Vulkan::CommandQueueImpl>(*this, queue0, 0, mQueueFamilyIndex);
-            mComputeQueue  = mGraphicsQueue;
-            mTransferQueue = std::make_shared<Coral::Vulkan::CommandQueueImpl>(*this, queue1, 1, mQueueFamilyIndex);
+            mComputeQueue  = std::make_shared<Coral::Vulkan::CommandQueueImpl>(*this, queue1, 1, mQueueFamilyIndex);
+            mTransferQueue = mComputeQueue;
             break;
         }
         case 3:
@@ -245,6 +372,14 @@ ContextImpl::init(const Context::CreateConfig& config)
             return false;
     }
 
+    if (transferQueueFamilyIndex)
+    {
+        VkQueue queue{ VK_NULL_HANDLE };
+        vkGetDeviceQueue(mDevice, *transferQueueFamilyIndex, 0, &queue);
+
+        mTransferQueue = std::make_shared<Coral::Vulkan::CommandQueueImpl>(*this, queue, 0, *transferQueueFamilyIndex);
+    }
+
     VmaAllocatorCreateInfo allocatorCreateInfo{};
     allocatorCreateInfo.device           = mDevice;
     allocatorCreateInfo.instance         = mInstance;
@@ -260,14 +395,42 @@ ContextImpl::init(const Context::CreateConfig& config)
     // Allocate 64 MiB sized memory block chunks. If requested, the allocator 
     // will create larger memory blocks to ensure continuous memory per buffer.
     allocatorCreateInfo.preferredLargeHeapBlockSize = 1024 * 1024 * 64;
+
+    // Without VK_EXT_memory_budget, VMA estimates the budget from the heap sizes
+    if (mMemoryBudgetSupported)
+    {
+        allocatorCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+    }
+
     if (vmaCreateAllocator(&allocatorCreateInfo, &mAllocator) != VK_SUCCESS)
     {
         return false;
     }
 
-    mStagingBufferPool = std::make_unique<BufferPool>(*this, CO_BUFFER_TYPE_STORAGE, true);
+    mStagingBufferPool  = std::make_unique<BufferPool>(*this, CO_BUFFER_TYPE_STORAGE, true);
+    mReadbackBufferPool = std::make_unique<BufferPool>(*this, 0, true);
+    mScratchBufferPool  = std::make_unique<BufferPool>(*this, CO_BUFFER_TYPE_STORAGE, false);
+    mRenderTargetPool   = std::make_unique<RenderTargetPool>(*this);
 
     vkGetPhysicalDeviceProperties(mPhysicalDevice, &mProperties);
+    vkGetPhysicalDeviceMemoryProperties(mPhysicalDevice, &mMemoryProperties);
+
+    VkPhysicalDeviceProperties2 properties{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+    properties.pNext = &mIdProperties;
+
+    VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostMemoryProperties{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT };
+    if (mHostMemoryImportSupported)
+    {
+        mIdProperties.pNext = &hostMemoryProperties;
+    }
+
+    vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties);
+    mIdProperties.pNext = nullptr;
+
+    if (mHostMemoryImportSupported)
+    {
+        mMinImportedHostPointerAlignment = hostMemoryProperties.minImportedHostPointerAlignment;
+    }
 
     return true;
 }
@@ -294,6 +457,21 @@ ContextImpl::getComputeQueue()
 }
 
 
+Coral::UploadQueue*
+ContextImpl::getUploadQueue()
+{
+    std::call_once(mUploadQueueInit, [this]
+    {
+        if (mTransferQueue)
+        {
+            mUploadQueue = UploadQueueImpl::create(*this, *mTransferQueue);
+        }
+    });
+
+    return mUploadQueue.get();
+}
+
+
 std::expected<Coral::BufferPtr, Coral::Buffer::CreateError>
 ContextImpl::createBuffer(const Coral::Buffer::CreateConfig& config)
 {
@@ -329,6 +507,13 @@ ContextImpl::createPipelineState(const Coral::PipelineState::CreateConfig& confi
 }
 
 
+std::expected<Coral::PipelineStatePtr, Coral::PipelineState::CreateError>
+ContextImpl::createComputePipelineState(const Coral::PipelineState::ComputeCreateConfig& config)
+{
+    return create<Coral::PipelineState, PipelineStateImpl, Coral::PipelineState::CreateError>(config);
+}
+
+
 std::expected<Coral::SamplerPtr, Coral::Sampler::CreateError>
 ContextImpl::createSampler(const Coral::Sampler::CreateConfig& config)
 {
@@ -339,7 +524,7 @@ ContextImpl::createSampler(const Coral::Sampler::CreateConfig& config)
 std::expected<Coral::SemaphorePtr, Coral::Semaphore::CreateError>
 ContextImpl::createSemaphore(const Coral::Semaphore::CreateConfig& config)
 {
-    return create<Coral::Semaphore, SemaphoreImpl, Coral::Semaphore::CreateError>();
+    return create<Coral::Semaphore, SemaphoreImpl, Coral::Semaphore::CreateError>(config);
 }
 
 
@@ -371,8 +556,303 @@ ContextImpl::getQueueFamilyIndex()
 }
 
 
+std::span<const uint32_t>
+ContextImpl::getQueueFamilyIndices() const
+{
+    return mQueueFamilyIndices;
+}
+
+
 BufferImplPtr
 ContextImpl::requestStagingBuffer(size_t bufferSize)
 {
     return std::static_pointer_cast<BufferImpl>(mStagingBufferPool->requestBuffer(bufferSize));
 }
+
+
+BufferImplPtr
+ContextImpl::requestReadbackBuffer(size_t bufferSize)
+{
+    return std::static_pointer_cast<BufferImpl>(mReadbackBufferPool->requestBuffer(bufferSize));
+}
+
+
+BufferImplPtr
+ContextImpl::requestScratchBuffer(size_t bufferSize)
+{
+    return std::static_pointer_cast<BufferImpl>(mScratchBufferPool->requestBuffer(bufferSize));
+}
+
+
+MipGenerator*
+ContextImpl::getMipGenerator()
+{
+    std::call_once(mMipGeneratorInit, [this]
+    {
+        if (mStorageImageWriteWithoutFormatSupported)
+        {
+            mMipGenerator = MipGenerator::create(*this);
+        }
+    });
+
+    return mMipGenerator.get();
+}
+
+
+std::expected<Coral::BufferPtr, Coral::Buffer::CreateError>
+ContextImpl::importBuffer(const Coral::Buffer::CreateConfig& config, const CoExternalMemoryHandle& handle)
+{
+    // The memory is imported from a duplicate of the file descriptor (see allocateExternalMemory). The caller's
+    // descriptor is only closed once the buffer was created, hence it stays with the caller on failure.
+    auto buffer = create<Coral::Buffer, BufferImpl, Coral::Buffer::CreateError>(config, handle);
+    if (buffer)
+    {
+        ::closeFd(handle.fd);
+    }
+    return buffer;
+}
+
+
+std::expected<Coral::ImagePtr, Coral::Image::CreateError>
+ContextImpl::importImage(const Coral::Image::CreateConfig& config, const CoExternalMemoryHandle& handle)
+{
+    // See importBuffer
+    auto image = create<Coral::Image, ImageImpl, Coral::Image::CreateError>(config, handle);
+    if (image)
+    {
+        ::closeFd(handle.fd);
+    }
+    return image;
+}
+
+
+std::expected<Coral::ImagePtr, Coral::Image::CreateError>
+ContextImpl::requestRenderTarget(const Coral::Image::CreateConfig& config)
+{
+    auto image = mRenderTargetPool->requestImage(config);
+    if (!image)
+    {
+        return std::unexpected(image.error());
+    }
+
+    return image.value();
+}
+
+
+std::expected<Coral::SemaphorePtr, Coral::Semaphore::CreateError>
+ContextImpl::importSemaphore(int fd)
+{
+    return create<Coral::Semaphore, SemaphoreImpl, Coral::Semaphore::CreateError>(fd);
+}
+
+
+bool
+ContextImpl::isImageFormatSupported(CoPixelFormat format, CoImageUsageHint usageHint)
+{
+    VkFormatProperties properties{};
+    vkGetPhysicalDeviceFormatProperties(mPhysicalDevice, convert(format), &properties);
+
+    // Every image can be sampled and used as copy source and destination
+    VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | 
+                                    VK_FORMAT_FEATURE_TRANSFER_SRC_BIT | 
+                                    VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+
+    if (usageHint == CO_IMAGE_USAGE_HINT_FRAMEBUFFER_ATTACHMENT)
+    {
+        required |= isDepthFormat(format) ? VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT 
+                                          : VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT;
+    }
+    else if (usageHint == CO_IMAGE_USAGE_HINT_STORAGE)
+    {
+        required |= VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT;
+    }
+
+    return (properties.optimalTilingFeatures & required) == required;
+}
+
+
+uint32_t
+ContextImpl::maxSampleCount(CoPixelFormat format)
+{
+    // The sample count flag bits are defined as the sample count they represent
+    return std::bit_floor(static_cast<uint32_t>(getSupportedSampleCounts(format) | VK_SAMPLE_COUNT_1_BIT));
+}
+
+
+CoMemoryBudget
+ContextImpl::getMemoryBudget()
+{
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(mAllocator, budgets.data());
+
+    CoMemoryBudget result{};
+    for (uint32_t i = 0; i < mMemoryProperties.memoryHeapCount; ++i)
+    {
+        if (mMemoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+        {
+            result.usage  += budgets[i].usage;
+            result.budget += budgets[i].budget;
+        }
+    }
+
+    return result;
+}
+
+
+VkSampleCountFlags
+ContextImpl::getSupportedSampleCounts(CoPixelFormat format)
+{
+    if (coPixelFormatIsCompressed(format))
+    {
+        return VK_SAMPLE_COUNT_1_BIT;
+    }
+
+    VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    usage |= isDepthFormat(format) ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    VkImageFormatProperties properties{};
+    if (vkGetPhysicalDeviceImageFormatProperties(mPhysicalDevice, 
+                                                 convert(format), 
+                                                 VK_IMAGE_TYPE_2D, 
+                                                 VK_IMAGE_TILING_OPTIMAL, 
+                                                 usage, 
+                                                 0, 
+                                                 &properties) != VK_SUCCESS)
+    {
+        return VK_SAMPLE_COUNT_1_BIT;
+    }
+
+    return properties.sampleCounts;
+}
+
+
+bool
+ContextImpl::isStorageImageFormatSupported(CoPixelFormat format)
+{
+    if (!mStorageImageWriteWithoutFormatSupported || coPixelFormatIsCompressed(format) || isDepthFormat(format))
+    {
+        return false;
+    }
+
+    VkFormatProperties properties{};
+    vkGetPhysicalDeviceFormatProperties(mPhysicalDevice, convert(format), &properties);
+
+    return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+}
+
+
+std::optional<uint32_t>
+ContextImpl::findMemoryTypeIndex(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties)
+{
+    for (uint32_t i = 0; i < mMemoryProperties.memoryTypeCount; ++i)
+    {
+        if ((memoryTypeBits & (1u << i)) && (mMemoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            return i;
+        }
+    }
+
+    return {};
+}
+
+
+VkDeviceMemory
+ContextImpl::allocateExternalMemory(const VkMemoryRequirements& requirements, 
+                                    VkMemoryPropertyFlags properties,
+                                    VkBuffer buffer,
+                                    VkImage image,
+                                    const CoExternalMemoryHandle* importHandle)
+{
+    if (!mExternalMemoryFdSupported)
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    auto memoryTypeIndex = findMemoryTypeIndex(requirements.memoryTypeBits, properties);
+    if (!memoryTypeIndex)
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    // Shared memory is always allocated dedicated so that the handle refers to exactly one resource at offset zero
+    VkMemoryDedicatedAllocateInfo dedicatedInfo{ VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO };
+    dedicatedInfo.buffer = buffer;
+    dedicatedInfo.image  = image;
+
+    VkExportMemoryAllocateInfo exportInfo{ VK_STRUCTURE_TYPE_EXPORT_MEMORY_ALLOCATE_INFO };
+    exportInfo.pNext       = &dedicatedInfo;
+    exportInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+    VkImportMemoryFdInfoKHR importInfo{ VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR };
+    importInfo.pNext      = &dedicatedInfo;
+    importInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+    VkMemoryAllocateInfo allocateInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocateInfo.memoryTypeIndex = *memoryTypeIndex;
+
+    if (importHandle)
+    {
+        // Opaque handles are only compatible between identical devices and drivers
+        if (std::memcmp(importHandle->deviceUUID, mIdProperties.deviceUUID, VK_UUID_SIZE) != 0 ||
+            std::memcmp(importHandle->driverUUID, mIdProperties.driverUUID, VK_UUID_SIZE) != 0 ||
+            importHandle->size < requirements.size)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        // Vulkan takes ownership of the imported file descriptor, even if creating the resource fails afterwards.
+        // Importing a duplicate leaves the caller's descriptor untouched until the resource was created.
+        importInfo.fd = ::duplicateFd(importHandle->fd);
+        if (importInfo.fd < 0)
+        {
+            return VK_NULL_HANDLE;
+        }
+
+        allocateInfo.pNext          = &importInfo;
+        allocateInfo.allocationSize = importHandle->size;
+    }
+    else
+    {
+        allocateInfo.pNext          = &exportInfo;
+        allocateInfo.allocationSize = requirements.size;
+    }
+
+    VkDeviceMemory memory{ VK_NULL_HANDLE };
+    if (vkAllocateMemory(mDevice, &allocateInfo, nullptr, &memory) != VK_SUCCESS)
+    {
+        // A failed import does not take ownership of the duplicated descriptor
+        if (importHandle)
+        {
+            ::closeFd(importInfo.fd);
+        }
+        return VK_NULL_HANDLE;
+    }
+
+    return memory;
+}
+
+
+std::optional<CoExternalMemoryHandle>
+ContextImpl::exportExternalMemory(VkDeviceMemory memory, VkDeviceSize size)
+{
+    if (!mExternalMemoryFdSupported || memory == VK_NULL_HANDLE)
+    {
+        return {};
+    }
+
+    VkMemoryGetFdInfoKHR getFdInfo{ VK_STRUCTURE_TYPE_MEMORY_GET_FD_INFO_KHR };
+    getFdInfo.memory     = memory;
+    getFdInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+    CoExternalMemoryHandle handle{};
+    if (vkGetMemoryFdKHR(mDevice, &getFdInfo, &handle.fd) != VK_SUCCESS)
+    {
+        return {};
+    }
+
+    handle.size = size;
+    std::memcpy(handle.deviceUUID, mIdProperties.deviceUUID, VK_UUID_SIZE);
+    std::memcpy(handle.driverUUID, mIdProperties.driverUUID, VK_UUID_SIZE);
+
+    return handle;
+}
@@ -9,7 +9,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <span>
+#include <vector>
 
 namespace Coral
 {
@@ -40,6 +42,8 @@ public:
                                     
     Coral::CommandQueue* getTransferQueue() override;
 
+    Coral::UploadQueue* getUploadQueue() override;
+
     std::expected<Coral::BufferPtr, Coral::Buffer::CreateError> createBuffer(const Coral::Buffer::CreateConfig& config) override;
 
     std::expected<Coral::FencePtr, Coral::Fence::CreateError> createFence(const Coral::Fence::CreateConfig& config)  override;
@@ -50,6 +54,8 @@ public:
 
     std::expected<Coral::PipelineStatePtr, Coral::PipelineState::CreateError> createPipelineState(const Coral::PipelineState::CreateConfig& config) override;
 
+    std::expected<Coral::PipelineStatePtr, Coral::PipelineState::CreateError> createComputePipelineState(const Coral::PipelineState::ComputeCreateConfig& config) override;
+
     std::expected<Coral::SamplerPtr, Coral::Sampler::CreateError> createSampler(const Coral::Sampler::CreateConfig& config) override;
 
     std::expected<Coral::SemaphorePtr, Coral::Semaphore::CreateError> createSemaphore(const Coral::Semaphore::CreateConfig& config) override;
@@ -58,6 +64,20 @@ public:
 
     std::expected<Coral::SwapchainPtr, Coral::Swapchain::CreateError> createSwapchain(const Coral::Swapchain::CreateConfig& config) override;
 
+    std::expected<Coral::BufferPtr, Coral::Buffer::CreateError> importBuffer(const Coral::Buffer::CreateConfig& config, const CoExternalMemoryHandle& handle) override;
+
+    std::expected<Coral::ImagePtr, Coral::Image::CreateError> importImage(const Coral::Image::CreateConfig& config, const CoExternalMemoryHandle& handle) override;
+
+    std::expected<Coral::SemaphorePtr, Coral::Semaphore::CreateError> importSemaphore(int fd) override;
+
+    std::expected<Coral::ImagePtr, Coral::Image::CreateError> requestRenderTarget(const Coral::Image::CreateConfig& config) override;
+
+    bool isImageFormatSupported(CoPixelFormat format, CoImageUsageHint usageHint) override;
+
+    uint32_t maxSampleCount(CoPixelFormat format) override;
+
+    CoMemoryBudget getMemoryBudget() override;
+
     VkInstance getVkInstance() { return mInstance; }
 
     VkDevice getVkDevice() { return mDevice; }
@@ -66,8 +86,16 @@ public:
 
     VmaAllocator getVmaAllocator();
 
+    /// Get the index of the queue family of the graphics and compute queues
     uint32_t getQueueFamilyIndex();
 
+    /// Get the indices of all queue families queues are created from
+    /**
+     * Contains the index of a dedicated transfer queue family after the graphics queue family if the device provides
+     * one.
+     */
+    std::span<const uint32_t> getQueueFamilyIndices() const;
+
     /// Request a staging buffer from the staging buffer pool
     /**
      * The staging buffer will have at least the requested buffer size. Staging buffers are returned to the to the pool
@@ -75,6 +103,78 @@ public:
      */
     BufferImplPtr requestStagingBuffer(size_t bufferSize);
 
+    /// Request a CPU-visible buffer for GPU -> CPU copies from the readback buffer pool
+    /**
+     * Readback buffers are allocated in host-cached memory for fast CPU reads. They are returned to the pool once the
+     * last reference to the buffer is released.
+     */
+    BufferImplPtr requestReadbackBuffer(size_t bufferSize);
+
+    /// Request a device-local storage buffer for intermediate results of internal compute passes
+    /**
+     * Scratch buffers are returned to the pool once the last reference to the buffer is released. Their content is
+     * undefined.
+     */
+    BufferImplPtr requestScratchBuffer(size_t bufferSize);
+
+    /// Get the compute pipeline for single-pass mip generation
+    /**
+     * The pipeline is created on first use. Returns nullptr if the device does not support storage image writes 
+     * without format (shaderStorageImageWriteWithoutFormat) or the pipeline creation failed.
+     */
+    MipGenerator* getMipGenerator();
+
+    /// Get the required alignment of host pointers and sizes for host memory import
+    /**
+     * Returns 0 if the device does not support importing host memory (VK_EXT_external_memory_host).
+     */
+    VkDeviceSize getMinImportedHostPointerAlignment() const { return mMinImportedHostPointerAlignment; }
+
+    /// Check if semaphores can be exported and imported as opaque file descriptors (VK_KHR_external_semaphore_fd)
+    bool isExternalSemaphoreFdSupported() const { return mExternalSemaphoreFdSupported; }
+
+    /// Check if cube map array images are supported (imageCubeArray feature)
+    bool isImageCubeArraySupported() const { return mImageCubeArraySupported; }
+
+    /// Check if indirect draws can execute more than one draw (multiDrawIndirect feature)
+    bool isMultiDrawIndirectSupported() const { return mMultiDrawIndirectSupported; }
+
+    /// Check if indirect draws can read the draw count from a buffer (drawIndirectCount feature)
+    bool isDrawIndirectCountSupported() const { return mDrawIndirectCountSupported; }
+
+    /// Check if vertex shaders can write storage buffers and storage images (vertexPipelineStoresAndAtomics feature)
+    bool isVertexPipelineStoresSupported() const { return mVertexPipelineStoresSupported; }
+
+    /// Check if fragment shaders can write storage buffers and storage images (fragmentStoresAndAtomics feature)
+    bool isFragmentStoresSupported() const { return mFragmentStoresSupported; }
+
+    /// Get the sample counts supported for transient framebuffer attachments with the pixel format
+    VkSampleCountFlags getSupportedSampleCounts(CoPixelFormat format);
+
+    /// Check if images of the format can be written by shaders as storage images
+    bool isStorageImageFormatSupported(CoPixelFormat format);
+
+    /// Check if the context was created without surface support. Headless contexts cannot create swapchains.
+    bool isHeadless() const { return mHeadless; }
+
+    /// Find the index of a memory type that is allowed by \p memoryTypeBits and has all requested property flags
+    std::optional<uint32_t> findMemoryTypeIndex(uint32_t memoryTypeBits, VkMemoryPropertyFlags properties);
+
+    /// Allocate dedicated device memory that can be shared via opaque file descriptors (VK_KHR_external_memory_fd)
+    /**
+     * If \p importHandle is null, the memory is allocated as exportable. Otherwise, the memory is imported from a
+     * duplicate of the handle's file descriptor, which stays owned by the caller. Exactly one of \p buffer and \p image
+     * must be valid. Returns VK_NULL_HANDLE on failure.
+     */
+    VkDeviceMemory allocateExternalMemory(const VkMemoryRequirements& requirements, 
+                                          VkMemoryPropertyFlags properties,
+                                          VkBuffer buffer,
+                                          VkImage image,
+                                          const CoExternalMemoryHandle* importHandle);
+
+    /// Export memory allocated by allocateExternalMemory as opaque file descriptor
+    std::optional<CoExternalMemoryHandle> exportExternalMemory(VkDeviceMemory memory, VkDeviceSize size);
+
 private:
     
     template<typename T, typename U, typename CreateError, typename ...InitArgs>
@@ -103,6 +203,8 @@ private:
 
     uint32_t mQueueFamilyIndex{ 0 };
 
+    std::vector<uint32_t> mQueueFamilyIndices;
+
     std::shared_ptr<CommandQueueImpl> mTransferQueue;
 
     std::shared_ptr<CommandQueueImpl> mGraphicsQueue;
@@ -113,8 +215,50 @@ private:
 
     std::unique_ptr<BufferPool> mStagingBufferPool;
 
+    std::unique_ptr<BufferPool> mReadbackBufferPool;
+
+    std::unique_ptr<BufferPool> mScratchBufferPool;
+
+    std::unique_ptr<RenderTargetPool> mRenderTargetPool;
+
+    std::unique_ptr<MipGenerator> mMipGenerator;
+
+    std::once_flag mMipGeneratorInit;
+
+    std::unique_ptr<UploadQueueImpl> mUploadQueue;
+
+    std::once_flag mUploadQueueInit;
+
     VkPhysicalDeviceProperties mProperties;
 
+    bool mHostMemoryImportSupported{ false };
+
+    VkDeviceSize mMinImportedHostPointerAlignment{ 0 };
+
+    bool mExternalMemoryFdSupported{ false };
+
+    bool mExternalSemaphoreFdSupported{ false };
+
+    bool mMemoryBudgetSupported{ false };
+
+    bool mHeadless{ false };
+
+    bool mImageCubeArraySupported{ false };
+
+    bool mStorageImageWriteWithoutFormatSupported{ false };
+
+    bool mMultiDrawIndirectSupported{ false };
+
+    bool mDrawIndirectCountSupported{ false };
+
+    bool mVertexPipelineStoresSupported{ false };
+
+    bool mFragmentStoresSupported{ false };
+
+    VkPhysicalDeviceMemoryProperties mMemoryProperties{};
+
+    VkPhysicalDeviceIDProperties mIdProperties{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES };
+
 }; // class ContextImpl
 
 } // namespace Coral::Vulkan
@@ -30,19 +30,41 @@ convert(CoClearOp clearOp)
 }
 
 
-std::optional<VkExtent2D>
-getFramebufferExtent(const Coral::Framebuffer::CreateConfig& config)
+/// Create an attachment rendering into the view, or into the first mip level and array layer if no view is given
+std::optional<FramebufferImpl::Attachment>
+createAttachment(const Coral::ImagePtr& image, const std::optional<Coral::ImageViewConfig>& view)
 {
-    if (!config.colorAttachments.empty())
+    auto imageImpl = std::static_pointer_cast<ImageImpl>(image);
+
+    FramebufferImpl::Attachment attachment{ imageImpl, view.value_or(Coral::ImageViewConfig{}) };
+    if (!view)
     {
-        return VkExtent2D{ config.colorAttachments.front().image->width(), config.colorAttachments.front().image->height() };
+        attachment.view.format = image->format();
     }
-    else if (config.depthAttachment)
+
+    // 3D images cannot be rendered to. All other images render into a single mip level and array layer.
+    if (imageImpl->type() == CO_IMAGE_TYPE_3D ||
+        attachment.view.mipLevelCount != 1 ||
+        attachment.view.arrayLayerCount != 1)
     {
-        return VkExtent2D{ config.depthAttachment->width(), config.depthAttachment->height() };
+        return {};
     }
 
-    return {};
+    attachment.imageView = imageImpl->getVkImageView(attachment.view);
+    if (attachment.imageView == VK_NULL_HANDLE)
+    {
+        return {};
+    }
+
+    return attachment;
+}
+
+
+VkExtent2D
+getAttachmentExtent(const FramebufferImpl::Attachment& attachment)
+{
+    return VkExtent2D{ std::max(attachment.image->width() >> attachment.view.baseMipLevel, 1u),
+                       std::max(attachment.image->height() >> attachment.view.baseMipLevel, 1u) };
 }
 
 } // namespace
@@ -51,68 +73,99 @@ getFramebufferExtent(const Coral::Framebuffer::CreateConfig& config)
 std::optional<Coral::Framebuffer::CreateError>
 FramebufferImpl::init(const Coral::Framebuffer::CreateConfig& config)
 {
-    auto extent = getFramebufferExtent(config);
-
-    if (!extent)
+    if (config.colorAttachments.empty() && !config.depthAttachment)
     {
         return Framebuffer::CreateError::INTERNAL_ERROR;
     }
 
-    mWidth  = extent->width;
-    mHeight = extent->height;
+    // Validate the attachments:
+    // 1. The image format must not be a depth format
+    // 2. The attachment index must be unique
+    // 3. The depth attachment format must be a depth format
+    // 4. Attachments render into a single mip level and array layer. 3D images cannot be rendered to.
+    // 5. All attachments must have the same sample count and extent
 
-    for (const auto& [image, binding] : config.colorAttachments)
+    for (const auto& [image, binding, view] : config.colorAttachments)
     {
-        mColorAttachments.emplace(binding, std::static_pointer_cast<ImageImpl>(image));
+        auto attachment = ::createAttachment(image, view);
+        if (!attachment || isDepthFormat(attachment->view.format))
+        {
+            return Framebuffer::CreateError::INVALID_COLOR_ATTACHMENT_FORMAT;
+        }
+
+        if (!mColorAttachments.emplace(binding, *attachment).second)
+        {
+            return Framebuffer::CreateError::DUPLICATE_COLOR_ATTACHMENTS;
+        }
     }
 
-    if (mColorAttachments.size() != config.colorAttachments.size())
+    if (config.depthAttachment)
     {
-        return Framebuffer::CreateError::DUPLICATE_COLOR_ATTACHMENTS;
+        mDepthAttachment = ::createAttachment(config.depthAttachment, config.depthAttachmentView);
+        if (!mDepthAttachment || !isDepthFormat(mDepthAttachment->view.format))
+        {
+            return Framebuffer::CreateError::INVALID_DEPTH_STENCIL_ATTACHMENT_FORMAT;
+        }
     }
 
-    mDepthAttachment = std::static_pointer_cast<ImageImpl>(config.depthAttachment);
+    const auto& first = !mColorAttachments.empty() ? mColorAttachments.begin()->second : *mDepthAttachment;
+    auto extent       = ::getAttachmentExtent(first);
 
-    // Validate the attachments:
-    // 1. The image format must not be a depth format
-    // 2. The attachment index must be unique
-    // 3. The depth attachment format must be a depth format
+    mWidth       = extent.width;
+    mHeight      = extent.height;
+    mSampleCount = first.image->sampleCount();
 
-    bool colorFormatsValid = std::ranges::none_of(config.colorAttachments, [](const auto& attachment)
+    auto isCompatible = [&](const Attachment& attachment)
     {
-        return isDepthFormat(attachment.image->format());
-    });
+        auto attachmentExtent = ::getAttachmentExtent(attachment);
+        return attachment.image->sampleCount() == mSampleCount &&
+               attachmentExtent.width == mWidth &&
+               attachmentExtent.height == mHeight;
+    };
 
-    if (!colorFormatsValid)
+    if (!std::ranges::all_of(mColorAttachments | std::views::values, isCompatible))
     {
         return Framebuffer::CreateError::INVALID_COLOR_ATTACHMENT_FORMAT;
     }
 
-    if (mDepthAttachment)
+    if (mDepthAttachment && !isCompatible(*mDepthAttachment))
     {
-        if (!isDepthFormat(mDepthAttachment->format()))
-        {
-            return Framebuffer::CreateError::INVALID_DEPTH_STENCIL_ATTACHMENT_FORMAT;
-        }
+        return Framebuffer::CreateError::INVALID_DEPTH_STENCIL_ATTACHMENT_FORMAT;
     }
 
     return {};
 }
 
 
-const std::map<uint32_t, ImageImplPtr>&
+const std::map<uint32_t, FramebufferImpl::Attachment>&
 FramebufferImpl::colorAttachments()
 {
     return mColorAttachments;
 }
 
-ImageImplPtr
+
+Coral::ImagePtr
+FramebufferImpl::colorAttachment(uint32_t binding) const
+{
+    auto it = mColorAttachments.find(binding);
+    return it != mColorAttachments.end() ? it->second.image : nullptr;
+}
+
+
+const std::optional<FramebufferImpl::Attachment>&
 FramebufferImpl::depthAttachment()
 {
     return mDepthAttachment;
 }
 
 
+uint32_t
+FramebufferImpl::sampleCount() const
+{
+    return mSampleCount;
+}
+
+
 uint32_t
 FramebufferImpl::width() const
 {
@@ -131,15 +184,16 @@ Coral::Framebuffer::Layout
 FramebufferImpl::layout()
 {
     Coral::Framebuffer::Layout layout{};
+    layout.sampleCount = mSampleCount;
 
     if (mDepthAttachment)
     {
-        layout.depthStencilAttachment = CoDepthStencilAttachmentInfo{ mDepthAttachment->format() };
+        layout.depthStencilAttachment = CoDepthStencilAttachmentInfo{ mDepthAttachment->view.format };
     }
 
-    for (const auto& [binding, image] : mColorAttachments)
+    for (const auto& [binding, attachment] : mColorAttachments)
     {
-        layout.colorAttachments.push_back({ image->format(), binding });
+        layout.colorAttachments.push_back({ attachment.view.format, binding });
     }
 
     return layout;
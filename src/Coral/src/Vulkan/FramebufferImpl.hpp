@@ -24,6 +24,16 @@ public:
     
     using Resource::Resource;
 
+    /// Image and the mip level and array layer of the image rendered into
+    struct Attachment
+    {
+        ImageImplPtr image;
+
+        Coral::ImageViewConfig view;
+
+        VkImageView imageView{ VK_NULL_HANDLE };
+    };
+
     std::optional<Framebuffer::CreateError> init(const Coral::Framebuffer::CreateConfig& config);
 
     uint32_t width() const override;
@@ -32,19 +42,26 @@ public:
 
     Coral::Framebuffer::Layout layout() override;
 
-    const std::map<uint32_t, ImageImplPtr>& colorAttachments();
+    Coral::ImagePtr colorAttachment(uint32_t binding) const override;
 
-    ImageImplPtr depthAttachment();
+    const std::map<uint32_t, Attachment>& colorAttachments();
+
+    const std::optional<Attachment>& depthAttachment();
+
+    /// Get the number of samples per pixel of all attachments
+    uint32_t sampleCount() const;
 
 private:
 
-    std::map<uint32_t, ImageImplPtr> mColorAttachments;
+    std::map<uint32_t, Attachment> mColorAttachments;
 
-    ImageImplPtr mDepthAttachment;
+    std::optional<Attachment> mDepthAttachment;
 
     uint32_t mWidth;
     uint32_t mHeight;
 
+    uint32_t mSampleCount{ 1 };
+
 }; // class FramebufferImpl
 
 } // namespace Coral::Vulkan
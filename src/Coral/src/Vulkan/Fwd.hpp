@@ -13,11 +13,14 @@ class ContextImpl;
 class FenceImpl;
 class FramebufferImpl;
 class ImageImpl;
+class MipGenerator;
 class PipelineStateImpl;
+class RenderTargetPool;
 class SamplerImpl;
 class SemaphoreImpl;
 class ShaderModuleImpl;
 class SwapchainImpl;
+class UploadQueueImpl;
 
 using ResourcePtr          = std::shared_ptr<Resource>;
 using BufferImplPtr        = std::shared_ptr<BufferImpl>;
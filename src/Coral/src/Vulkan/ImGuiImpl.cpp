@@ -50,7 +50,7 @@ ImGui_ImplCoral_Init(Coral::Vulkan::ContextImpl& context, const CoFramebufferLay
     vkInitInfo.RenderPass                  = VK_NULL_HANDLE;
     vkInitInfo.MinImageCount               = swapchainImageCount;
     vkInitInfo.ImageCount                  = swapchainImageCount;
-    vkInitInfo.MSAASamples                 = VK_SAMPLE_COUNT_1_BIT;
+    vkInitInfo.MSAASamples                 = Coral::Vulkan::getSampleCountFlag(signature.sampleCount);
     vkInitInfo.PipelineCache               = VK_NULL_HANDLE;
     vkInitInfo.Subpass                     = 0;
     vkInitInfo.DescriptorPoolSize          = 25;
@@ -1,6 +1,10 @@
 #include "ImageImpl.hpp"
+#include "CommandQueueImpl.hpp"
 #include "VulkanFormat.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
 #include <cstring>
 
@@ -26,15 +30,28 @@ getAspectFlags(CoPixelFormat format)
 
 
 VkImageUsageFlags
-getUsageFlags(CoPixelFormat format)
+getUsageFlags(CoPixelFormat format, bool storage, bool transient)
 {
+    // Transient attachments only live within render passes and cannot be used for anything else
+    if (transient)
+    {
+        return VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | (Coral::Vulkan::isDepthFormat(format)
+                                                          ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+                                                          : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+    }
+
     VkImageUsageFlags flags = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
 
+    if (storage)
+    {
+        flags |= VK_IMAGE_USAGE_STORAGE_BIT;
+    }
+
     if (Coral::Vulkan::isDepthFormat(format))
     {
         flags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
     }
-    else
+    else if (!coPixelFormatIsCompressed(format))
     {
         flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
     }
@@ -43,17 +60,54 @@ getUsageFlags(CoPixelFormat format)
 }
 
 
+VkImageViewType
+getViewType(CoImageType type)
+{
+    switch (type)
+    {
+        case CO_IMAGE_TYPE_2D:         return VK_IMAGE_VIEW_TYPE_2D;
+        case CO_IMAGE_TYPE_2D_ARRAY:   return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        case CO_IMAGE_TYPE_CUBE:       return VK_IMAGE_VIEW_TYPE_CUBE;
+        case CO_IMAGE_TYPE_CUBE_ARRAY: return VK_IMAGE_VIEW_TYPE_CUBE_ARRAY;
+        case CO_IMAGE_TYPE_3D:         return VK_IMAGE_VIEW_TYPE_3D;
+        default:                       std::unreachable();
+    }
+}
+
+
+bool
+isCubeType(CoImageType type)
+{
+    return type == CO_IMAGE_TYPE_CUBE || type == CO_IMAGE_TYPE_CUBE_ARRAY;
+}
+
+
 } // namespace
 
 
 ImageImpl::~ImageImpl()
 {
+    for (auto [_, view] : mViews)
+    {
+        vkDestroyImageView(context().getVkDevice(), view, nullptr);
+    }
+
+    for (auto view : mMipLevelViews)
+    {
+        vkDestroyImageView(context().getVkDevice(), view, nullptr);
+    }
+
     if (mImageView != VK_NULL_HANDLE)
     {
         vkDestroyImageView(context().getVkDevice(), mImageView, nullptr);
     }
 
-    if (mImage != VK_NULL_HANDLE && mIsOwner)
+    if (mDeviceMemory != VK_NULL_HANDLE)
+    {
+        vkDestroyImage(context().getVkDevice(), mImage, nullptr);
+        vkFreeMemory(context().getVkDevice(), mDeviceMemory, nullptr);
+    }
+    else if (mImage != VK_NULL_HANDLE && mIsOwner)
     {
         vmaDestroyImage(context().getVmaAllocator(), mImage, mAllocation);
     }
@@ -71,6 +125,7 @@ ImageImpl::init(VkImage image, CoPixelFormat format, uint32_t width, uint32_t he
     mIsOwner       = false;
 
     mCurrentLayout.resize(mMipLevelCount, VK_IMAGE_LAYOUT_UNDEFINED);
+    mOwnerQueue.resize(mMipLevelCount, nullptr);
 
     switch (usageHint)
     {
@@ -80,17 +135,21 @@ ImageImpl::init(VkImage image, CoPixelFormat format, uint32_t width, uint32_t he
         case CO_IMAGE_USAGE_HINT_SHADER_READ_ONLY:
             mPreferredImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             break;
+        case CO_IMAGE_USAGE_HINT_STORAGE:
+            // Storage images can only be accessed in the general layout, which supports sampling as well
+            mPreferredImageLayout = VK_IMAGE_LAYOUT_GENERAL;
+            break;
         default:
             std::unreachable();
     }
 
     VkImageViewCreateInfo viewCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
     viewCreateInfo.image                           = image;
-    viewCreateInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D;
+    viewCreateInfo.viewType                        = ::getViewType(mType);
     viewCreateInfo.format                          = convert(format);
     viewCreateInfo.subresourceRange.aspectMask     = getAspectFlags(format);
     viewCreateInfo.subresourceRange.baseArrayLayer = 0;
-    viewCreateInfo.subresourceRange.layerCount     = 1;
+    viewCreateInfo.subresourceRange.layerCount     = mLayerCount;
     viewCreateInfo.subresourceRange.baseMipLevel   = 0;
     viewCreateInfo.subresourceRange.levelCount     = mMipLevelCount;
 
@@ -106,55 +165,292 @@ ImageImpl::init(VkImage image, CoPixelFormat format, uint32_t width, uint32_t he
 std::optional<Coral::Image::CreateError>
 ImageImpl::init(const Coral::Image::CreateConfig& config)
 {
-    mFormat  = config.format;
-    mWidth   = config.extent.width;
-    mHeight  = config.extent.height;
-    mIsOwner = true;
+    return initImage(config, nullptr, nullptr);
+}
+
+
+std::optional<Coral::Image::CreateError>
+ImageImpl::init(const Coral::Image::CreateConfig& config, const CoExternalMemoryHandle& handle)
+{
+    return initImage(config, &handle, nullptr);
+}
+
+
+std::optional<Coral::Image::CreateError>
+ImageImpl::init(const Coral::Image::CreateConfig& config, const MemoryProvider& memoryProvider)
+{
+    return initImage(config, nullptr, &memoryProvider);
+}
+
+
+std::optional<Coral::Image::CreateError>
+ImageImpl::initImage(const Coral::Image::CreateConfig& config, 
+                     const CoExternalMemoryHandle* importHandle,
+                     const MemoryProvider* memoryProvider)
+{
+    mFormat      = config.format;
+    mWidth       = config.extent.width;
+    mHeight      = config.extent.height;
+    mDepth       = std::max(config.depth, 1u);
+    mType        = config.type;
+    mLayerCount  = config.arrayLayerCount != 0 ? config.arrayLayerCount : (::isCubeType(mType) ? 6 : 1);
+    mSampleCount = std::max(config.sampleCount, 1u);
+    mTransient   = config.transient || mSampleCount > 1;
+    mIsOwner     = true;
+    mExportable  = config.exportable && importHandle == nullptr;
+    mShared      = config.exportable || importHandle != nullptr;
+
+    // Transient images (including all multisampled images) are always framebuffer attachments
+    auto usageHint = mTransient ? CO_IMAGE_USAGE_HINT_FRAMEBUFFER_ATTACHMENT : config.usageHint;
+
+    if (!context().isImageFormatSupported(config.format, usageHint))
+    {
+        return Image::CreateError::UNSUPPORTED_FORMAT;
+    }
+
+    if (mTransient && (mType != CO_IMAGE_TYPE_2D || config.hasMipMaps || config.exportable || importHandle))
+    {
+        return Image::CreateError::UNSUPPORTED_FEATURE;
+    }
+
+    if (mSampleCount > 1)
+    {
+        if (!std::has_single_bit(mSampleCount) || (context().getSupportedSampleCounts(mFormat) & mSampleCount) == 0)
+        {
+            return Image::CreateError::UNSUPPORTED_FEATURE;
+        }
+    }
+
+    switch (mType)
+    {
+        case CO_IMAGE_TYPE_2D:
+        case CO_IMAGE_TYPE_3D:
+            if (mLayerCount != 1 || (mType == CO_IMAGE_TYPE_2D && mDepth != 1))
+            {
+                return Image::CreateError::INVALID_SIZE;
+            }
+            if (mType == CO_IMAGE_TYPE_3D && isDepthFormat(mFormat))
+            {
+                return Image::CreateError::UNSUPPORTED_FORMAT;
+            }
+            break;
+        case CO_IMAGE_TYPE_2D_ARRAY:
+            if (mDepth != 1)
+            {
+                return Image::CreateError::INVALID_SIZE;
+            }
+            break;
+        case CO_IMAGE_TYPE_CUBE:
+        case CO_IMAGE_TYPE_CUBE_ARRAY:
+            // Cube faces are square. A cube map has exactly six faces, a cube map array a multiple of six.
+            if (mDepth != 1 || mWidth != mHeight || mLayerCount % 6 != 0 || 
+                (mType == CO_IMAGE_TYPE_CUBE && mLayerCount != 6))
+            {
+                return Image::CreateError::INVALID_SIZE;
+            }
+            if (mType == CO_IMAGE_TYPE_CUBE_ARRAY && !context().isImageCubeArraySupported())
+            {
+                return Image::CreateError::UNSUPPORTED_FEATURE;
+            }
+            break;
+        default:
+            return Image::CreateError::INVALID_SIZE;
+    }
 
     if (config.hasMipMaps)
     {
-        mMipLevelCount = static_cast<uint32_t>(std::floor(std::log2(std::max(mWidth, mHeight)))) + 1;
+        mMipLevelCount = static_cast<uint32_t>(std::floor(std::log2(std::max({ mWidth, mHeight, mDepth })))) + 1;
     }
     else
     {
         mMipLevelCount = 1;
     }
 
+    mCurrentLayout.assign(mMipLevelCount, VK_IMAGE_LAYOUT_UNDEFINED);
+    mOwnerQueue.assign(mMipLevelCount, nullptr);
+
+    // Apart from storage images, storage access is only needed to generate the mip chain with a compute shader. Since
+    // storage usage can prevent framebuffer compression on some devices, it is not requested for images without mip
+    // levels.
+    mStorage = mMipLevelCount > 1 && mType != CO_IMAGE_TYPE_3D && context().isStorageImageFormatSupported(mFormat);
+
+    mUsage = getUsageFlags(config.format, mStorage || usageHint == CO_IMAGE_USAGE_HINT_STORAGE, mTransient);
+
     VkImageCreateInfo createInfo{ VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
-    createInfo.imageType     = VK_IMAGE_TYPE_2D;
-    createInfo.arrayLayers   = 1;
+    createInfo.flags         = ::isCubeType(mType) ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+    createInfo.imageType     = mType == CO_IMAGE_TYPE_3D ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
+    createInfo.arrayLayers   = mLayerCount;
     createInfo.extent.width  = mWidth;
     createInfo.extent.height = mHeight;
-    createInfo.extent.depth  = 1;
+    createInfo.extent.depth  = mDepth;
     createInfo.mipLevels     = mMipLevelCount;
     createInfo.format        = convert(config.format);
     createInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
     createInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
-    createInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+    createInfo.samples       = getSampleCountFlag(mSampleCount);
     createInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    createInfo.usage         = getUsageFlags(config.format);
+    createInfo.usage         = mUsage;
+
+    // Views may reinterpret the texels with the opposite color encoding (e.g. to write linear values into an sRGB
+    // image). Listing the view formats allows implementations to keep framebuffer compression of mutable images.
+    mViewFormat = !mTransient ? getColorEncodingCounterpart(mFormat) : std::nullopt;
 
-    VmaAllocationCreateInfo allocCreateInfo{};
-    allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    allocCreateInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+    std::array<VkFormat, 2> viewFormats{ convert(mFormat), convert(mViewFormat.value_or(mFormat)) };
 
-    VmaAllocationInfo info{};
-    if (vmaCreateImage(context().getVmaAllocator(), &createInfo, &allocCreateInfo, &mImage, &mAllocation, &info) != VK_SUCCESS)
+    VkImageFormatListCreateInfo formatListCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_FORMAT_LIST_CREATE_INFO };
+    formatListCreateInfo.viewFormatCount = static_cast<uint32_t>(viewFormats.size());
+    formatListCreateInfo.pViewFormats    = viewFormats.data();
+
+    if (mViewFormat)
     {
-        return Image::CreateError::INTERNAL_ERROR;
+        createInfo.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
+        createInfo.pNext  = &formatListCreateInfo;
+    }
+
+    if (config.exportable || importHandle)
+    {
+        // Memory shared with other processes cannot be allocated through VMA, hence the image owns its memory directly
+        auto device = context().getVkDevice();
+
+        VkExternalMemoryImageCreateInfo externalCreateInfo{ VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO };
+        externalCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_OPAQUE_FD_BIT;
+        externalCreateInfo.pNext       = createInfo.pNext;
+        createInfo.pNext = &externalCreateInfo;
+
+        if (vkCreateImage(device, &createInfo, nullptr, &mImage) != VK_SUCCESS)
+        {
+            return Image::CreateError::INTERNAL_ERROR;
+        }
+
+        VkMemoryRequirements requirements{};
+        vkGetImageMemoryRequirements(device, mImage, &requirements);
+
+        mDeviceMemory = context().allocateExternalMemory(requirements, 
+                                                         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 
+                                                         VK_NULL_HANDLE, 
+                                                         mImage, 
+                                                         importHandle);
+        if (mDeviceMemory == VK_NULL_HANDLE)
+        {
+            vkDestroyImage(device, mImage, nullptr);
+            mImage = VK_NULL_HANDLE;
+            return Image::CreateError::INTERNAL_ERROR;
+        }
+
+        mDeviceMemorySize = importHandle ? importHandle->size : requirements.size;
+
+        if (vkBindImageMemory(device, mImage, mDeviceMemory, 0) != VK_SUCCESS)
+        {
+            return Image::CreateError::INTERNAL_ERROR;
+        }
+    }
+    else if (memoryProvider)
+    {
+        // The image does not own the memory. mAllocation stays empty, hence only the image is destroyed with it.
+        auto device = context().getVkDevice();
+
+        if (vkCreateImage(device, &createInfo, nullptr, &mImage) != VK_SUCCESS)
+        {
+            return Image::CreateError::INTERNAL_ERROR;
+        }
+
+        VkMemoryRequirements requirements{};
+        vkGetImageMemoryRequirements(device, mImage, &requirements);
+
+        auto allocation = (*memoryProvider)(requirements);
+        if (allocation == VK_NULL_HANDLE)
+        {
+            return Image::CreateError::INTERNAL_ERROR;
+        }
+
+        if (vmaBindImageMemory(context().getVmaAllocator(), allocation, mImage) != VK_SUCCESS)
+        {
+            return Image::CreateError::INTERNAL_ERROR;
+        }
     }
+    else
+    {
+        VmaAllocationCreateInfo allocCreateInfo{};
+        allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        allocCreateInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+
+        // The contents of transient attachments never leave the render pass. On tile-based GPUs, lazily allocated
+        // memory is then never committed at all.
+        if (mTransient && context().findMemoryTypeIndex(~0u, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT))
+        {
+            allocCreateInfo.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+        }
 
-    if (!init(mImage, config.format, mWidth, mHeight, mMipLevelCount, config.usageHint))
+        VmaAllocationInfo info{};
+        if (vmaCreateImage(context().getVmaAllocator(), &createInfo, &allocCreateInfo, &mImage, &mAllocation, &info) != VK_SUCCESS)
+        {
+            return Image::CreateError::INTERNAL_ERROR;
+        }
+    }
+
+    if (!init(mImage, config.format, mWidth, mHeight, mMipLevelCount, usageHint))
     {
         return Image::CreateError::INTERNAL_ERROR;
     }
 
     mIsOwner = true;
 
+    // The exporting side hands the image over in its preferred layout, owned by VK_QUEUE_FAMILY_EXTERNAL
+    if (importHandle)
+    {
+        mCurrentLayout.assign(mMipLevelCount, mPreferredImageLayout);
+    }
+
+    if (mStorage)
+    {
+        // Single mip level views used as storage images. 2D images use array views as well, hence all image types
+        // supporting storage access can be accessed the same way by the mip generation shader.
+        VkImageViewCreateInfo viewCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+        viewCreateInfo.image                           = mImage;
+        viewCreateInfo.viewType                        = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewCreateInfo.format                          = convert(mFormat);
+        viewCreateInfo.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewCreateInfo.subresourceRange.baseArrayLayer = 0;
+        viewCreateInfo.subresourceRange.layerCount     = mLayerCount;
+        viewCreateInfo.subresourceRange.levelCount     = 1;
+
+        for (uint32_t level = 0; level < mMipLevelCount; ++level)
+        {
+            viewCreateInfo.subresourceRange.baseMipLevel = level;
+
+            VkImageView view{ VK_NULL_HANDLE };
+            if (vkCreateImageView(context().getVkDevice(), &viewCreateInfo, nullptr, &view) != VK_SUCCESS)
+            {
+                return Image::CreateError::INTERNAL_ERROR;
+            }
+
+            mMipLevelViews.push_back(view);
+        }
+    }
+
     return {};
 }
 
 
+std::optional<CoExternalMemoryHandle>
+ImageImpl::exportMemory()
+{
+    if (!mExportable)
+    {
+        return {};
+    }
+
+    return context().exportExternalMemory(mDeviceMemory, mDeviceMemorySize);
+}
+
+
+bool
+ImageImpl::isShared() const
+{
+    return mShared;
+}
+
+
 VkImage
 ImageImpl::getVkImage()
 {
@@ -169,6 +465,113 @@ ImageImpl::getVkImageView()
 }
 
 
+VkImageView
+ImageImpl::getVkImageView(const Coral::ImageViewConfig& config)
+{
+    if (!isValidView(config))
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    auto viewType = getViewType(config);
+
+    // The default view covers the whole image
+    if (config.format == mFormat &&
+        config.baseMipLevel == 0 && config.mipLevelCount == mMipLevelCount &&
+        config.baseArrayLayer == 0 && config.arrayLayerCount == mLayerCount &&
+        viewType == ::getViewType(mType))
+    {
+        return mImageView;
+    }
+
+    std::lock_guard lock(mViewsProtection);
+
+    if (auto iter = mViews.find(config); iter != mViews.end())
+    {
+        return iter->second;
+    }
+
+    VkImageViewCreateInfo viewCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
+    viewCreateInfo.image                           = mImage;
+    viewCreateInfo.viewType                        = viewType;
+    viewCreateInfo.format                          = convert(config.format);
+    viewCreateInfo.subresourceRange.aspectMask     = getAspectFlags(mFormat);
+    viewCreateInfo.subresourceRange.baseArrayLayer = config.baseArrayLayer;
+    viewCreateInfo.subresourceRange.layerCount     = config.arrayLayerCount;
+    viewCreateInfo.subresourceRange.baseMipLevel   = config.baseMipLevel;
+    viewCreateInfo.subresourceRange.levelCount     = config.mipLevelCount;
+
+    // sRGB formats usually do not support storage access. Views in such a format must not inherit the storage usage.
+    VkImageViewUsageCreateInfo usageCreateInfo{ VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO };
+    usageCreateInfo.usage = mUsage & ~VK_IMAGE_USAGE_STORAGE_BIT;
+
+    if ((mUsage & VK_IMAGE_USAGE_STORAGE_BIT) &&
+        !context().isImageFormatSupported(config.format, CO_IMAGE_USAGE_HINT_STORAGE))
+    {
+        viewCreateInfo.pNext = &usageCreateInfo;
+    }
+
+    VkImageView view{ VK_NULL_HANDLE };
+    if (vkCreateImageView(context().getVkDevice(), &viewCreateInfo, nullptr, &view) != VK_SUCCESS)
+    {
+        return VK_NULL_HANDLE;
+    }
+
+    mViews.emplace(config, view);
+
+    return view;
+}
+
+
+bool
+ImageImpl::createView(const Coral::ImageViewConfig& config)
+{
+    return getVkImageView(config) != VK_NULL_HANDLE;
+}
+
+
+bool
+ImageImpl::isValidView(const Coral::ImageViewConfig& config) const
+{
+    if (config.mipLevelCount == 0 || config.arrayLayerCount == 0 ||
+        config.baseMipLevel >= mMipLevelCount || config.mipLevelCount > mMipLevelCount - config.baseMipLevel ||
+        config.baseArrayLayer >= mLayerCount || config.arrayLayerCount > mLayerCount - config.baseArrayLayer)
+    {
+        return false;
+    }
+
+    return config.format == mFormat || config.format == mViewFormat;
+}
+
+
+VkImageViewType
+ImageImpl::getViewType(const Coral::ImageViewConfig& config) const
+{
+    if (mType == CO_IMAGE_TYPE_3D)
+    {
+        return VK_IMAGE_VIEW_TYPE_3D;
+    }
+
+    if (config.arrayLayerCount == 1)
+    {
+        return VK_IMAGE_VIEW_TYPE_2D;
+    }
+
+    // Six faces of a cube map are viewed as cube, multiples of six faces of a cube map array as cube map array
+    if (::isCubeType(mType) && config.arrayLayerCount == 6)
+    {
+        return VK_IMAGE_VIEW_TYPE_CUBE;
+    }
+
+    if (mType == CO_IMAGE_TYPE_CUBE_ARRAY && config.arrayLayerCount % 6 == 0)
+    {
+        return VK_IMAGE_VIEW_TYPE_CUBE_ARRAY;
+    }
+
+    return VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+}
+
+
 uint32_t
 ImageImpl::width() const
 {
@@ -183,6 +586,27 @@ ImageImpl::height() const
 }
 
 
+uint32_t
+ImageImpl::depth() const
+{
+    return mDepth;
+}
+
+
+uint32_t
+ImageImpl::layerCount() const
+{
+    return mLayerCount;
+}
+
+
+CoImageType
+ImageImpl::type() const
+{
+    return mType;
+}
+
+
 CoPixelFormat
 ImageImpl::format() const
 {
@@ -197,6 +621,20 @@ ImageImpl::getMipLevels() const
 }
 
 
+uint32_t
+ImageImpl::sampleCount() const
+{
+    return mSampleCount;
+}
+
+
+bool
+ImageImpl::isTransient() const
+{
+    return mTransient;
+}
+
+
 bool
 ImageImpl::presentable() const
 {
@@ -204,6 +642,28 @@ ImageImpl::presentable() const
 }
 
 
+bool
+ImageImpl::isStorageSupported() const
+{
+    return mStorage;
+}
+
+
+bool
+ImageImpl::isStorageImage() const
+{
+    // Only images with the storage usage hint are created with storage usage and kept in the general layout
+    return mPreferredImageLayout == VK_IMAGE_LAYOUT_GENERAL && (mUsage & VK_IMAGE_USAGE_STORAGE_BIT) != 0;
+}
+
+
+VkImageView
+ImageImpl::getMipLevelView(uint32_t mipLevel)
+{
+    return mipLevel < mMipLevelViews.size() ? mMipLevelViews[mipLevel] : VK_NULL_HANDLE;
+}
+
+
 VkImageLayout
 ImageImpl::getPreferredImageLayout()
 {
@@ -211,49 +671,112 @@ ImageImpl::getPreferredImageLayout()
 }
 
 
+VkImageMemoryBarrier2
+ImageImpl::createLayoutBarrier(uint32_t firstMipLevel, 
+                               uint32_t levelCount, 
+                               VkImageLayout oldLayout, 
+                               VkImageLayout newLayout) const
+{
+    VkImageMemoryBarrier2 barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2 };
+    barrier.oldLayout           = oldLayout;
+    barrier.newLayout           = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image               = mImage;
+
+    if (isDepthFormat(mFormat))
+    { 
+        barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+    else
+    {
+        barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+    if (isStencilFormat(mFormat))
+    {
+        barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+
+    barrier.subresourceRange.baseMipLevel   = firstMipLevel;
+    barrier.subresourceRange.levelCount     = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = mLayerCount;
+
+    return barrier;
+}
+
+
 void
-ImageImpl::cmdTransitionImageLayout(VkCommandBuffer commandBuffer, ImageImpl& image, VkImageLayout layout, 
-                                    uint32_t firstMipLevel, uint32_t levelCount, VkAccessFlagBits srcAccessMask,
-                                    VkAccessFlags dstAccessMask, VkPipelineStageFlags srcStageFlags, 
-                                    VkPipelineStageFlags dstStageFlags)
-{
-    auto& context = image.context();
-    std::vector<VkImageMemoryBarrier> barriers;
-    barriers.reserve(levelCount);
-    for (size_t i = 0; i < levelCount; ++i)
-    {
-        auto level = firstMipLevel + i;
-        VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
-        barrier.oldLayout           = image.mCurrentLayout[level];
-        barrier.newLayout           = layout;
-        barrier.srcQueueFamilyIndex = context.getQueueFamilyIndex();
-        barrier.dstQueueFamilyIndex = context.getQueueFamilyIndex();
-        barrier.image               = image.getVkImage();
-
-        image.mCurrentLayout[level] = layout;
-
-        if (isDepthFormat(image.mFormat))
-        { 
-            barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_DEPTH_BIT;
+ImageImpl::submitLayouts(std::span<const VkImageLayout> exitLayouts,
+                         CommandQueueImpl& queue,
+                         std::vector<VkImageMemoryBarrier2>& barriers,
+                         OwnershipReleaseBarriers& releaseBarriers)
+{
+    std::lock_guard lock(mLayoutProtection);
+
+    auto firstBarrier     = barriers.size();
+    auto queueFamilyIndex = queue.getQueueFamilyIndex();
+
+    for (uint32_t level = 0; level < std::min<size_t>(exitLayouts.size(), mMipLevelCount); ++level)
+    {
+        if (exitLayouts[level] == VK_IMAGE_LAYOUT_MAX_ENUM)
+        {
+            continue;
         }
-        else
+
+        auto owner = mOwnerQueue[level];
+        if (mShared && mCurrentLayout[level] != VK_IMAGE_LAYOUT_UNDEFINED)
         {
-            barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_COLOR_BIT;
+            // Shared images are owned by VK_QUEUE_FAMILY_EXTERNAL between submissions (see isShared). Acquire the mip
+            // level in the preferred layout it was released in, which preserves the content written by other
+            // processes.
+            auto& acquire = barriers.emplace_back(
+                createLayoutBarrier(level, 1, mPreferredImageLayout, mPreferredImageLayout));
+            acquire.srcQueueFamilyIndex = VK_QUEUE_FAMILY_EXTERNAL;
+            acquire.dstQueueFamilyIndex = queueFamilyIndex;
+            acquire.dstStageMask        = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            acquire.dstAccessMask       = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
         }
-        if (isStencilFormat(image.mFormat))
+        else if (owner && owner->getQueueFamilyIndex() != queueFamilyIndex)
         {
-            barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+            // The mip level was last used by a queue of another queue family. The ownership is released by that queue
+            // and acquired by the submitting one. Both barriers perform the same layout transition.
+            auto barrier = createLayoutBarrier(level, 1, mCurrentLayout[level], mPreferredImageLayout);
+            barrier.srcQueueFamilyIndex = owner->getQueueFamilyIndex();
+            barrier.dstQueueFamilyIndex = queueFamilyIndex;
+
+            auto& release = releaseBarriers[owner].emplace_back(barrier);
+            release.srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            release.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+            auto& acquire = barriers.emplace_back(barrier);
+            acquire.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+            acquire.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+        }
+        else if (mCurrentLayout[level] != mPreferredImageLayout)
+        {
+            // Prior commands left the mip level in a different layout. Extend the barrier of the previous mip level if
+            // it transitions from the same layout.
+            auto* previous = barriers.size() > firstBarrier ? &barriers.back() : nullptr;
+            if (previous && previous->oldLayout == mCurrentLayout[level] &&
+                previous->srcQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED &&
+                previous->subresourceRange.baseMipLevel + previous->subresourceRange.levelCount == level)
+            {
+                previous->subresourceRange.levelCount++;
+            }
+            else
+            {
+                auto& barrier = barriers.emplace_back(
+                    createLayoutBarrier(level, 1, mCurrentLayout[level], mPreferredImageLayout));
+                barrier.srcStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                barrier.srcAccessMask = VK_ACCESS_2_MEMORY_WRITE_BIT;
+                barrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+                barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+            }
         }
 
-        barrier.subresourceRange.baseMipLevel   = level;
-        barrier.subresourceRange.levelCount     = 1;
-        barrier.subresourceRange.layerCount     = 1;
-        barrier.subresourceRange.baseArrayLayer = 0;
-        barrier.srcAccessMask                   = srcAccessMask;
-        barrier.dstAccessMask                   = dstAccessMask;
-
-        barriers.push_back(barrier);
+        // The command buffer releases shared images to VK_QUEUE_FAMILY_EXTERNAL when it ends
+        mCurrentLayout[level] = exitLayouts[level];
+        mOwnerQueue[level]    = mShared ? nullptr : &queue;
     }
-
-    vkCmdPipelineBarrier(commandBuffer, srcStageFlags, dstStageFlags, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
 }
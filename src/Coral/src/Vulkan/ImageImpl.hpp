@@ -7,8 +7,19 @@
 #include "Resource.hpp"
 #include "Vulkan.hpp"
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
 namespace Coral::Vulkan
 {
+
+/// Barriers releasing the ownership of image mip levels, grouped by the queue that must execute them
+using OwnershipReleaseBarriers = std::unordered_map<CommandQueueImpl*, std::vector<VkImageMemoryBarrier2>>;
+
 /*!
  * Implemntaion of the Image interface using the Vulkan backend
  *
@@ -22,11 +33,11 @@ namespace Coral::Vulkan
  * the preferred image layout is VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, whereas for images that are mostly used as 
  * attachments the preferred image layout is VK_IMAGE_LAYOUT_SHADER_ATTACHMENT_OPTIMAL.
  *
- * The ImageImpl class attempts to keep track of the current image layout in an attempt to reduce programmer errors
- * when dealing with layout transitions manually. As a result, the developer must be cautious and try to avoid mixing 
- * updates, descriptor usage or render attachment in order to prevent data races. Sequential use should be okay. Since
- * layout transitions happen during command buffer execution, recorded transitions commands should always be executed,
- * otherwise the CPU representation is out of sync with the GPU representation of the current memory layout.
+ * Layout transitions are tracked by each command buffer for the images it uses (see CommandBufferImpl). Command
+ * buffers expect the mip levels they use to be in the preferred layout when they start executing and transition them
+ * back when they end. The image itself only keeps track of the layout each mip level is left in by the submitted
+ * command buffers. Mip levels that are not in their preferred layout (e.g. of new or presented images) are transitioned
+ * when a command buffer using them is submitted.
  */
 class ImageImpl : public Coral::Image
                 , public Resource
@@ -42,48 +53,164 @@ public:
 
     std::optional<Coral::Image::CreateError> init(const Coral::Image::CreateConfig& config);
 
+    /// Create the image with memory imported from an opaque file descriptor (VK_KHR_external_memory_fd)
+    std::optional<Coral::Image::CreateError> init(const Coral::Image::CreateConfig& config, const CoExternalMemoryHandle& handle);
+
+    /// Callback returning the memory to bind an image with the given requirements to, or VK_NULL_HANDLE on failure
+    using MemoryProvider = std::function<VmaAllocation(const VkMemoryRequirements&)>;
+
+    /// Create the image bound to memory owned by the caller (see RenderTargetPool). The memory must outlive the image.
+    std::optional<Coral::Image::CreateError> init(const Coral::Image::CreateConfig& config, const MemoryProvider& memoryProvider);
+
     uint32_t width() const override;
 
     uint32_t height() const override;
 
+    uint32_t depth() const override;
+
+    uint32_t layerCount() const override;
+
+    CoImageType type() const override;
+
     CoPixelFormat format() const override;
 
     uint32_t getMipLevels() const override;
 
+    uint32_t sampleCount() const override;
+
+    bool isTransient() const override;
+
     VkImage getVkImage();
 
     VkImageView getVkImageView();
 
+    /// Get the cached view of a range of mip levels and array layers. Returns VK_NULL_HANDLE if the view is invalid.
+    VkImageView getVkImageView(const Coral::ImageViewConfig& config);
+
+    bool createView(const Coral::ImageViewConfig& config) override;
+
+    /// Check if the range of the view lies within the image and the view format is compatible with the image format
+    bool isValidView(const Coral::ImageViewConfig& config) const;
+
     bool presentable() const override;
 
+    std::optional<CoExternalMemoryHandle> exportMemory() override;
+
+    /// Check if the image memory is shared with other processes, i.e. the image is exportable or imported
+    /**
+     * Shared images are owned by VK_QUEUE_FAMILY_EXTERNAL in their preferred layout between submissions. Each command
+     * buffer acquires the mip levels it uses from the external queue family before it starts and releases them back
+     * when it ends, hence other processes can access the image in between.
+     */
+    bool isShared() const;
+
     VkImageLayout getPreferredImageLayout();
 
-    static void cmdTransitionImageLayout(VkCommandBuffer buffer, ImageImpl& image, VkImageLayout layout, uint32_t mipLevel, uint32_t levelCount, 
-                                         VkAccessFlagBits srcAccessMask,
-                                         VkAccessFlags dstAccessMask,
-                                         VkPipelineStageFlags srcStageFlags,
-                                         VkPipelineStageFlags dstStageFlags);
+    /// Check if the image can be written as storage image, i.e. its mip chain can be generated with a compute shader
+    bool isStorageSupported() const;
+
+    /// Check if the image can be bound to storage image descriptors, i.e. it uses CO_IMAGE_USAGE_HINT_STORAGE
+    bool isStorageImage() const;
+
+    /// Get the view of a single mip level including all array layers
+    /**
+     * The view type is always an array type. Returns VK_NULL_HANDLE if the image does not support storage access.
+     */
+    VkImageView getMipLevelView(uint32_t mipLevel);
+
+    /// Create a barrier for a layout transition of the mip levels including all array layers
+    /**
+     * The stage and access masks of the barrier are left empty.
+     */
+    VkImageMemoryBarrier2 createLayoutBarrier(uint32_t firstMipLevel, 
+                                              uint32_t levelCount, 
+                                              VkImageLayout oldLayout, 
+                                              VkImageLayout newLayout) const;
+
+    /// Update the layouts of the mip levels when a command buffer using the image is submitted
+    /**
+     * \p exitLayouts holds the layout the command buffer leaves each mip level in, or VK_IMAGE_LAYOUT_MAX_ENUM for mip
+     * levels the command buffer does not use. Barriers transitioning the used mip levels from their current layout
+     * into the preferred layout expected by the command buffer are appended to \p barriers. Barriers acquiring shared
+     * images from VK_QUEUE_FAMILY_EXTERNAL are appended as well. Must be called in submission order.
+     *
+     * Mip levels last used by a queue of another queue family than \p queue are transferred to the queue family of the
+     * submitting queue. The matching release barriers are appended to \p releaseBarriers under the queue that last
+     * used the mip level. They must be executed by that queue before the command buffer starts, which orders them
+     * after all prior work of the queue accessing the mip level.
+     */
+    void submitLayouts(std::span<const VkImageLayout> exitLayouts,
+                       CommandQueueImpl& queue,
+                       std::vector<VkImageMemoryBarrier2>& barriers,
+                       OwnershipReleaseBarriers& releaseBarriers);
 
 private:
 
+    VkImageViewType getViewType(const Coral::ImageViewConfig& config) const;
+
+    std::optional<Coral::Image::CreateError> initImage(const Coral::Image::CreateConfig& config, 
+                                                       const CoExternalMemoryHandle* importHandle,
+                                                       const MemoryProvider* memoryProvider);
+
     VkImage mImage{ VK_NULL_HANDLE };
 
     VkImageView mImageView{ VK_NULL_HANDLE };
 
+    /// Views of the individual mip levels of images supporting storage access
+    std::vector<VkImageView> mMipLevelViews;
+
+    /// Views of subresource ranges created on request
+    std::map<Coral::ImageViewConfig, VkImageView> mViews;
+
+    std::mutex mViewsProtection;
+
+    /// Format with the opposite color encoding views can use, if the format has one
+    std::optional<CoPixelFormat> mViewFormat;
+
     VmaAllocation mAllocation{ VK_NULL_HANDLE };
 
+    /// Device memory of images not allocated through VMA (e.g. shared memory)
+    VkDeviceMemory mDeviceMemory{ VK_NULL_HANDLE };
+
+    VkDeviceSize mDeviceMemorySize{ 0 };
+
+    bool mExportable{ false };
+
+    bool mShared{ false };
+
+    bool mStorage{ false };
+
+    VkImageUsageFlags mUsage{ 0 };
+
     uint32_t mWidth{ 0 };
 
     uint32_t mHeight{ 0 };
 
+    uint32_t mDepth{ 1 };
+
+    uint32_t mLayerCount{ 1 };
+
+    CoImageType mType{ CO_IMAGE_TYPE_2D };
+
     CoPixelFormat mFormat{ };
 
     uint32_t mMipLevelCount{ 1 };
 
+    uint32_t mSampleCount{ 1 };
+
+    bool mTransient{ false };
+
     VkImageLayout mPreferredImageLayout;
     
+    /// Layout of each mip level after execution of all submitted command buffers. Layout transitions always affect
+    /// all array layers of a mip level.
     std::vector<VkImageLayout> mCurrentLayout;
 
+    /// Queue that last used each mip level, nullptr for mip levels not used by any submission yet
+    std::vector<CommandQueueImpl*> mOwnerQueue;
+
+    std::mutex mLayoutProtection;
+
     bool mIsOwner{ false };
 
 }; // class ImageImpl
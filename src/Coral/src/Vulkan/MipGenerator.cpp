@@ -0,0 +1,144 @@
+#include "MipGenerator.hpp"
+
+#include "ContextImpl.hpp"
+
+#include "Shaders/DownsampleMips_spv.hpp"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+using namespace Coral::Vulkan;
+
+
+std::unique_ptr<MipGenerator>
+MipGenerator::create(ContextImpl& context)
+{
+    auto generator = std::make_unique<MipGenerator>(context);
+
+    if (!generator->init())
+    {
+        return nullptr;
+    }
+
+    return generator;
+}
+
+
+MipGenerator::MipGenerator(ContextImpl& context)
+    : mContext(context)
+{
+}
+
+
+MipGenerator::~MipGenerator()
+{
+    auto device = mContext.getVkDevice();
+
+    if (mPipeline != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(device, mPipeline, nullptr);
+    }
+
+    if (mPipelineLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineLayout(device, mPipelineLayout, nullptr);
+    }
+
+    if (mDescriptorSetLayout != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorSetLayout(device, mDescriptorSetLayout, nullptr);
+    }
+}
+
+
+bool
+MipGenerator::init()
+{
+    auto device = mContext.getVkDevice();
+
+    //-------------------------------------------------------------
+    // Descriptor Set Layout
+    //-------------------------------------------------------------
+
+    std::array<VkDescriptorSetLayoutBinding, 4> bindings{};
+    bindings[0].binding         = SOURCE_BINDING;
+    bindings[0].descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    bindings[0].descriptorCount = 1;
+    bindings[1].binding         = DESTINATION_BINDING;
+    bindings[1].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    bindings[1].descriptorCount = MaxMipLevels;
+    bindings[2].binding         = TILE_RESULTS_BINDING;
+    bindings[2].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[2].descriptorCount = 1;
+    bindings[3].binding         = TILE_COUNTERS_BINDING;
+    bindings[3].descriptorType  = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    bindings[3].descriptorCount = 1;
+
+    for (auto& binding : bindings)
+    {
+        binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{ VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    descriptorSetLayoutCreateInfo.pBindings    = bindings.data();
+    descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    descriptorSetLayoutCreateInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+
+    if (vkCreateDescriptorSetLayout(device, &descriptorSetLayoutCreateInfo, nullptr, &mDescriptorSetLayout) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    //-------------------------------------------------------------
+    // Pipeline Layout
+    //-------------------------------------------------------------
+
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.size       = sizeof(Parameters);
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    pipelineLayoutCreateInfo.setLayoutCount         = 1;
+    pipelineLayoutCreateInfo.pSetLayouts            = &mDescriptorSetLayout;
+    pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+    pipelineLayoutCreateInfo.pPushConstantRanges    = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr, &mPipelineLayout) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    //-------------------------------------------------------------
+    // Create Compute Pipeline
+    //-------------------------------------------------------------
+
+    // The embedded SPIR-V is a byte array without alignment guarantees
+    const auto& spirv = Coral::Shaders::DownsampleMips_spv;
+    std::vector<uint32_t> code(spirv.size() / sizeof(uint32_t));
+    std::memcpy(code.data(), spirv.data(), code.size() * sizeof(uint32_t));
+
+    VkShaderModuleCreateInfo shaderModuleCreateInfo{ VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+    shaderModuleCreateInfo.codeSize = code.size() * sizeof(uint32_t);
+    shaderModuleCreateInfo.pCode    = code.data();
+
+    VkShaderModule shaderModule{ VK_NULL_HANDLE };
+    if (vkCreateShaderModule(device, &shaderModuleCreateInfo, nullptr, &shaderModule) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    VkComputePipelineCreateInfo createInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    createInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    createInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    createInfo.stage.module = shaderModule;
+    createInfo.stage.pName  = "main";
+    createInfo.layout       = mPipelineLayout;
+
+    auto result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, &mPipeline);
+
+    // The shader module is not needed after pipeline creation
+    vkDestroyShaderModule(device, shaderModule, nullptr);
+
+    return result == VK_SUCCESS;
+}
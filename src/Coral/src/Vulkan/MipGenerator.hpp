@@ -0,0 +1,85 @@
+#ifndef CORAL_VULKAN_MIPGENERATOR_HPP
+#define CORAL_VULKAN_MIPGENERATOR_HPP
+
+#include "Fwd.hpp"
+#include "Vulkan.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace Coral::Vulkan
+{
+
+/*!
+ * Compute pipeline generating the mip chain of an image with a single dispatch
+ *
+ * The downsampler follows the single-pass approach of AMD FidelityFX SPD: Each work group reduces a tile of 64x64
+ * texels of the first mip level down to a single texel of mip level 6 in group shared memory. The last work group of
+ * each array layer to finish (determined by an atomic counter per layer) reduces the tile results down to mip level 12.
+ * Hence, no barriers are required between the mip levels.
+ *
+ * The pipeline is shared by all command buffers of a context. Descriptors are pushed with VK_KHR_push_descriptor.
+ */
+class MipGenerator
+{
+public:
+
+    /// Maximum number of mip levels (excluding the first mip level) generated by a single dispatch
+    static constexpr uint32_t MaxMipLevels = 12;
+
+    /// Extent of the texel tile of the first mip level that is reduced by a single work group
+    static constexpr uint32_t TileSize = 64;
+
+    /// Maximum extent of the first mip level. The last work group reduces a single tile of mip level 6, hence at most
+    /// TileSize x TileSize tiles are supported.
+    static constexpr uint32_t MaxExtent = TileSize * TileSize;
+
+    /// Descriptor bindings of the pipeline
+    enum Binding : uint32_t
+    {
+        /// Sampled image view of the first mip level
+        SOURCE_BINDING        = 0,
+        /// Array of MaxMipLevels storage image views of the generated mip levels
+        DESTINATION_BINDING   = 1,
+        /// Storage buffer receiving one texel per tile and layer
+        TILE_RESULTS_BINDING  = 2,
+        /// Storage buffer with one zero-initialized counter per layer
+        TILE_COUNTERS_BINDING = 3,
+    };
+
+    /// Push constants of the pipeline
+    struct Parameters
+    {
+        uint32_t extent[2];
+        uint32_t tileCount[2];
+        uint32_t mipLevelCount;
+        uint32_t reduction;
+    };
+
+    static std::unique_ptr<MipGenerator> create(ContextImpl& context);
+
+    MipGenerator(ContextImpl& context);
+
+    ~MipGenerator();
+
+    VkPipeline getVkPipeline() { return mPipeline; }
+
+    VkPipelineLayout getVkPipelineLayout() { return mPipelineLayout; }
+
+private:
+
+    bool init();
+
+    ContextImpl& mContext;
+
+    VkDescriptorSetLayout mDescriptorSetLayout{ VK_NULL_HANDLE };
+
+    VkPipelineLayout mPipelineLayout{ VK_NULL_HANDLE };
+
+    VkPipeline mPipeline{ VK_NULL_HANDLE };
+
+}; // class MipGenerator
+
+} // namespace Coral::Vulkan
+
+#endif // !CORAL_VULKAN_MIPGENERATOR_HPP
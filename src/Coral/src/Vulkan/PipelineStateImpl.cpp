@@ -22,6 +22,7 @@ convert(CoShaderStage shaderStage)
     {
         case CO_SHADER_STAGE_VERTEX:   return VK_SHADER_STAGE_VERTEX_BIT;
         case CO_SHADER_STAGE_FRAGMENT: return VK_SHADER_STAGE_FRAGMENT_BIT;
+        case CO_SHADER_STAGE_COMPUTE:  return VK_SHADER_STAGE_COMPUTE_BIT;
         default: assert(false);        return VK_SHADER_STAGE_ALL_GRAPHICS;
     }
 }
@@ -124,6 +125,37 @@ template<>
 VkDescriptorType
 toVkDescriptorType<Coral::UniformBlockDefinition>() { return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; }
 
+template<>
+VkDescriptorType
+toVkDescriptorType<Coral::StorageBufferDefinition>() { return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; }
+
+template<>
+VkDescriptorType
+toVkDescriptorType<Coral::StorageImageDefinition>() { return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE; }
+
+
+bool
+isShaderWrite(const Coral::DescriptorDefinition& descriptor)
+{
+    return std::visit(Coral::Visitor{
+        [](auto) { return false; },
+        [](Coral::StorageBufferDefinition storageBuffer) { return !storageBuffer.readOnly; },
+        [](Coral::StorageImageDefinition storageImage) { return !storageImage.readOnly; }
+    }, descriptor.definition);
+}
+
+
+bool
+isShaderWriteSupported(Coral::Vulkan::ContextImpl& context, CoShaderStage stage)
+{
+    switch (stage)
+    {
+        case CO_SHADER_STAGE_VERTEX:   return context.isVertexPipelineStoresSupported();
+        case CO_SHADER_STAGE_FRAGMENT: return context.isFragmentStoresSupported();
+        default:                       return true;
+    }
+}
+
 } // namespace
 
 
@@ -219,10 +251,10 @@ PipelineStateImpl::init(const Coral::PipelineState::CreateConfig& config)
     // Multisample State
     //-------------------------------------------------------------
 
-    // TODO: Implement Multi sampling
+    // The pipeline rasterizes with the sample count of the framebuffer attachments
     VkPipelineMultisampleStateCreateInfo multiSamplingCreateInfo{ VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO };
     multiSamplingCreateInfo.sampleShadingEnable   = VK_FALSE;
-    multiSamplingCreateInfo.rasterizationSamples  = VK_SAMPLE_COUNT_1_BIT;
+    multiSamplingCreateInfo.rasterizationSamples  = getSampleCountFlag(config.framebufferLayout.sampleCount);
     multiSamplingCreateInfo.minSampleShading      = 1.f;
     multiSamplingCreateInfo.pSampleMask           = nullptr;
     multiSamplingCreateInfo.alphaToCoverageEnable = VK_FALSE;
@@ -322,6 +354,79 @@ PipelineStateImpl::init(const Coral::PipelineState::CreateConfig& config)
     renderingCreateInfo.depthAttachmentFormat   = depthStencilFormat;
     renderingCreateInfo.stencilAttachmentFormat = depthStencilFormat;
 
+    //-------------------------------------------------------------
+    // Pipeline Layout 
+    //-------------------------------------------------------------
+
+    if (auto error = initLayout(config.shaderModules))
+    {
+        return error;
+    }
+
+    //-------------------------------------------------------------
+    // Create Graphics Pipeline
+    //-------------------------------------------------------------
+
+    VkGraphicsPipelineCreateInfo createInfo{ VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
+    createInfo.stageCount        = static_cast<uint32_t>(shaderStages.size());
+    createInfo.pStages           = shaderStages.data();
+    createInfo.pDynamicState     = &dynamicStateCreateInfo;
+    createInfo.pVertexInputState = &vertexInputCreateInfo;
+
+    createInfo.pRasterizationState = &rasterizationCreateInfo;
+    createInfo.pDepthStencilState  = &depthStencilCreateInfo;
+    createInfo.pViewportState      = &viewportCreateInfo;
+    createInfo.pMultisampleState   = &multiSamplingCreateInfo;
+    createInfo.pColorBlendState    = &colorBlendCreateInfo;
+    createInfo.pInputAssemblyState = &inputAssemblyCreateInfo;
+    createInfo.layout              = mPipelineLayout;
+    createInfo.pNext               = &renderingCreateInfo;
+
+    if (vkCreateGraphicsPipelines(context().getVkDevice(), VK_NULL_HANDLE, 1, &createInfo, nullptr, &mPipeline) != VK_SUCCESS)
+    {
+        return PipelineState::CreateError::INTERNAL_ERROR;
+    }
+
+    return {};
+}
+
+
+std::optional<Coral::PipelineState::CreateError>
+PipelineStateImpl::init(const Coral::PipelineState::ComputeCreateConfig& config)
+{
+    mBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+
+    if (!config.shaderModule || config.shaderModule->shaderStage() != CO_SHADER_STAGE_COMPUTE)
+    {
+        return Coral::PipelineState::CreateError::INVALID_SHADER_STAGE;
+    }
+
+    if (auto error = initLayout({ &config.shaderModule, 1 }))
+    {
+        return error;
+    }
+
+    auto shader = static_cast<Coral::Vulkan::ShaderModuleImpl*>(config.shaderModule.get());
+
+    VkComputePipelineCreateInfo createInfo{ VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    createInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    createInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+    createInfo.stage.module = shader->getVkShaderModule();
+    createInfo.stage.pName  = shader->entryPoint().c_str();
+    createInfo.layout       = mPipelineLayout;
+
+    if (vkCreateComputePipelines(context().getVkDevice(), VK_NULL_HANDLE, 1, &createInfo, nullptr, &mPipeline) != VK_SUCCESS)
+    {
+        return PipelineState::CreateError::INTERNAL_ERROR;
+    }
+
+    return {};
+}
+
+
+std::optional<Coral::PipelineState::CreateError>
+PipelineStateImpl::initLayout(std::span<const Coral::ShaderModulePtr> shaderModules)
+{
     //-------------------------------------------------------------
     // Descriptor Set Layout
     //-------------------------------------------------------------
@@ -329,12 +434,23 @@ PipelineStateImpl::init(const Coral::PipelineState::CreateConfig& config)
     std::vector<VkDescriptorSetLayoutBinding> bindings;
 
     std::unordered_map<uint32_t, size_t> visited;
-    for (auto shader : config.shaderModules)
+    for (const auto& shader : shaderModules)
     {
         auto stage = ::convert(shader->shaderStage());
 
         for (const auto& info : shader->descriptorLayout())
         {
+            if (::isShaderWrite(info))
+            {
+                // Vertex and fragment shaders can only write storage resources if the device enabled the feature
+                if (!::isShaderWriteSupported(context(), shader->shaderStage()))
+                {
+                    return PipelineState::CreateError::UNSUPPORTED_FEATURE;
+                }
+
+                mWritesStorageDescriptors = true;
+            }
+
             if (!visited.emplace(info.binding, bindings.size()).second)
             {
                 bindings[visited[info.binding]].stageFlags |= stage;
@@ -346,6 +462,8 @@ PipelineStateImpl::init(const Coral::PipelineState::CreateConfig& config)
             binding.descriptorCount = 1;
             binding.stageFlags      = stage;
             binding.descriptorType  = std::visit([](auto a) { return toVkDescriptorType<decltype(a)>(); }, info.definition);
+
+            mDescriptorTypes[info.binding] = binding.descriptorType;
         }
     }
 
@@ -354,14 +472,13 @@ PipelineStateImpl::init(const Coral::PipelineState::CreateConfig& config)
     descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>(bindings.size());
     descriptorSetLayoutCreateInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
 
-    VkDescriptorSetLayout layout{ VK_NULL_HANDLE };
     if (vkCreateDescriptorSetLayout(context().getVkDevice(), &descriptorSetLayoutCreateInfo, nullptr, &mDescriptorSetLayout) != VK_SUCCESS)
     {
         return PipelineState::CreateError::INTERNAL_ERROR;
     }
 
     //-------------------------------------------------------------
-    // Pipeline Layout 
+    // Pipeline Layout
     //-------------------------------------------------------------
 
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{ VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
@@ -373,30 +490,6 @@ PipelineStateImpl::init(const Coral::PipelineState::CreateConfig& config)
         return PipelineState::CreateError::INTERNAL_ERROR;
     }
 
-    //-------------------------------------------------------------
-    // Create Graphics Pipeline
-    //-------------------------------------------------------------
-
-    VkGraphicsPipelineCreateInfo createInfo{ VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
-    createInfo.stageCount        = static_cast<uint32_t>(shaderStages.size());
-    createInfo.pStages           = shaderStages.data();
-    createInfo.pDynamicState     = &dynamicStateCreateInfo;
-    createInfo.pVertexInputState = &vertexInputCreateInfo;
-
-    createInfo.pRasterizationState = &rasterizationCreateInfo;
-    createInfo.pDepthStencilState  = &depthStencilCreateInfo;
-    createInfo.pViewportState      = &viewportCreateInfo;
-    createInfo.pMultisampleState   = &multiSamplingCreateInfo;
-    createInfo.pColorBlendState    = &colorBlendCreateInfo;
-    createInfo.pInputAssemblyState = &inputAssemblyCreateInfo;
-    createInfo.layout              = mPipelineLayout;
-    createInfo.pNext               = &renderingCreateInfo;
-
-    if (vkCreateGraphicsPipelines(context().getVkDevice(), VK_NULL_HANDLE, 1, &createInfo, nullptr, &mPipeline) != VK_SUCCESS)
-    {
-        return PipelineState::CreateError::INTERNAL_ERROR;
-    }
-
     return {};
 }
 
@@ -421,3 +514,22 @@ PipelineStateImpl::getVkPipelineLayout()
     return mPipelineLayout;
 }
 
+
+std::optional<VkDescriptorType>
+PipelineStateImpl::getVkDescriptorType(uint32_t binding) const
+{
+    auto iter = mDescriptorTypes.find(binding);
+    if (iter == mDescriptorTypes.end())
+    {
+        return {};
+    }
+
+    return iter->second;
+}
+
+
+bool
+PipelineStateImpl::writesStorageDescriptors() const
+{
+    return mWritesStorageDescriptors;
+}
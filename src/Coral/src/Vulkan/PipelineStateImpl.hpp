@@ -9,6 +9,7 @@
 
 #include <optional>
 #include <span>
+#include <unordered_map>
 #include <vector>
 
 namespace Coral::Vulkan
@@ -29,16 +30,29 @@ public:
 
     std::optional<PipelineState::CreateError> init(const PipelineState::CreateConfig& config);
 
+    std::optional<PipelineState::CreateError> init(const PipelineState::ComputeCreateConfig& config);
+
     VkPipeline getVkPipeline();
 
     std::span<VkDescriptorSetLayout> getVkDescriptorSetLayouts();
 
     VkPipelineLayout getVkPipelineLayout();
 
-    VkPipelineBindPoint getVkPipelineBindingPoint() { return VK_PIPELINE_BIND_POINT_GRAPHICS; }
+    VkPipelineBindPoint getVkPipelineBindingPoint() { return mBindPoint; }
+
+    /// Get the descriptor type the shaders of the pipeline declare at the binding
+    std::optional<VkDescriptorType> getVkDescriptorType(uint32_t binding) const;
+
+    /// Check if any shader of the pipeline writes to a storage buffer or storage image
+    bool writesStorageDescriptors() const;
 
 private:
 
+    /// Create the descriptor set layout and pipeline layout for the descriptors declared by the shader modules
+    std::optional<PipelineState::CreateError> initLayout(std::span<const ShaderModulePtr> shaderModules);
+
+    VkPipelineBindPoint mBindPoint{ VK_PIPELINE_BIND_POINT_GRAPHICS };
+
     VkPipelineLayout mPipelineLayout{ VK_NULL_HANDLE };
 
     VkPipeline mPipeline{ VK_NULL_HANDLE };
@@ -55,6 +69,10 @@ private:
 
     std::optional<CoStencilTestMode> mStencilTestMode;
 
+    std::unordered_map<uint32_t, VkDescriptorType> mDescriptorTypes;
+
+    bool mWritesStorageDescriptors{ false };
+
 }; // class PipelineStateImpl
 
 } // namespace Coral::Vulkan
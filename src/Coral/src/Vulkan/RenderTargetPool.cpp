@@ -0,0 +1,145 @@
+#include "RenderTargetPool.hpp"
+
+#include "ContextImpl.hpp"
+#include "ImageImpl.hpp"
+
+#include <algorithm>
+
+using namespace Coral::Vulkan;
+
+namespace
+{
+
+bool
+isSameConfig(const Coral::Image::CreateConfig& lhs, const Coral::Image::CreateConfig& rhs)
+{
+    return lhs.extent.width == rhs.extent.width &&
+           lhs.extent.height == rhs.extent.height &&
+           lhs.hasMipMaps == rhs.hasMipMaps &&
+           lhs.format == rhs.format &&
+           lhs.usageHint == rhs.usageHint &&
+           lhs.type == rhs.type &&
+           std::max(lhs.depth, 1u) == std::max(rhs.depth, 1u) &&
+           lhs.arrayLayerCount == rhs.arrayLayerCount &&
+           std::max(lhs.sampleCount, 1u) == std::max(rhs.sampleCount, 1u) &&
+           lhs.transient == rhs.transient;
+}
+
+
+bool
+isIdle(const ImageImplPtr& image)
+{
+    // The pool holds the last reference to the image
+    return !image || image.use_count() == 1;
+}
+
+} // namespace
+
+
+RenderTargetPool::RenderTargetPool(ContextImpl& context)
+    : mContext(context)
+{
+}
+
+
+RenderTargetPool::~RenderTargetPool()
+{
+    for (auto& block : mMemoryBlocks)
+    {
+        // The image must be destroyed before the memory it is bound to
+        block.image.reset();
+        vmaFreeMemory(mContext.getVmaAllocator(), block.allocation);
+    }
+}
+
+
+std::expected<ImageImplPtr, Coral::Image::CreateError>
+RenderTargetPool::requestImage(const Coral::Image::CreateConfig& config)
+{
+    if (config.exportable)
+    {
+        return std::unexpected(Coral::Image::CreateError::UNSUPPORTED_FEATURE);
+    }
+
+    std::lock_guard lock(mMemoryBlocksProtection);
+
+    for (auto& block : mMemoryBlocks)
+    {
+        if (block.image && ::isIdle(block.image) && ::isSameConfig(block.config, config))
+        {
+            return block.image;
+        }
+    }
+
+    bool transient = config.transient || config.sampleCount > 1;
+
+    MemoryBlock* block = nullptr;
+    auto provideMemory = [&](const VkMemoryRequirements& requirements) -> VmaAllocation
+    {
+        block = acquireMemoryBlock(requirements, transient);
+        return block ? block->allocation : VK_NULL_HANDLE;
+    };
+
+    auto image = std::make_shared<ImageImpl>(mContext);
+    if (auto error = image->init(config, provideMemory))
+    {
+        return std::unexpected(*error);
+    }
+
+    block->image  = image;
+    block->config = config;
+
+    return image;
+}
+
+
+RenderTargetPool::MemoryBlock*
+RenderTargetPool::acquireMemoryBlock(const VkMemoryRequirements& requirements, bool transient)
+{
+    // Find the smallest idle memory block that fits the requirements. Blocks are allocated with a single image each,
+    // hence their offset satisfies any alignment.
+    MemoryBlock* block = nullptr;
+    for (auto& candidate : mMemoryBlocks)
+    {
+        if (::isIdle(candidate.image) &&
+            candidate.size >= requirements.size &&
+            (requirements.memoryTypeBits & (1u << candidate.memoryTypeIndex)) != 0 &&
+            (block == nullptr || candidate.size < block->size))
+        {
+            block = &candidate;
+        }
+    }
+
+    if (block)
+    {
+        // Destroying the idle image releases the memory block for the new image
+        block->image.reset();
+        return block;
+    }
+
+    // Each memory block gets its own VkDeviceMemory object so it can be released on its own. The allocation is not
+    // tied to a single image via VkMemoryDedicatedAllocateInfo, hence other images can be bound to it later.
+    VmaAllocationCreateInfo allocCreateInfo{};
+    allocCreateInfo.flags          = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT | VMA_ALLOCATION_CREATE_CAN_ALIAS_BIT;
+    allocCreateInfo.requiredFlags  = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    allocCreateInfo.memoryTypeBits = requirements.memoryTypeBits;
+
+    if (transient && mContext.findMemoryTypeIndex(requirements.memoryTypeBits, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT))
+    {
+        allocCreateInfo.usage = VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED;
+    }
+
+    VmaAllocation allocation{ VK_NULL_HANDLE };
+    VmaAllocationInfo info{};
+    if (vmaAllocateMemory(mContext.getVmaAllocator(), &requirements, &allocCreateInfo, &allocation, &info) != VK_SUCCESS)
+    {
+        return nullptr;
+    }
+
+    auto& newBlock = mMemoryBlocks.emplace_back();
+    newBlock.allocation      = allocation;
+    newBlock.size            = info.size;
+    newBlock.memoryTypeIndex = info.memoryType;
+
+    return &newBlock;
+}
@@ -0,0 +1,73 @@
+#ifndef CORAL_VULKAN_RENDERTARGETPOOL_HPP
+#define CORAL_VULKAN_RENDERTARGETPOOL_HPP
+
+#include "Image.hpp"
+
+#include "Fwd.hpp"
+#include "Vulkan.hpp"
+
+#include <expected>
+#include <list>
+#include <mutex>
+
+namespace Coral::Vulkan
+{
+
+/*!
+ * Pool of images for intermediate render targets
+ *
+ * Render targets are handed out for a given image configuration and return to the pool once the last reference to the
+ * image is released. Since command buffers retain the images they use until their execution finished, a render target
+ * is not recycled before all submissions using it completed.
+ *
+ * Each render target is bound to a memory block owned by the pool. A request that cannot be served by an idle render
+ * target of the same configuration creates a new image in the memory of an idle render target of a different
+ * configuration if it fits. Hence, targets whose lifetimes do not overlap (e.g. the intermediate images of a resized
+ * post-processing chain) alias the same memory instead of accumulating new allocations.
+ */
+class RenderTargetPool
+{
+public:
+
+    RenderTargetPool(ContextImpl& context);
+
+    ~RenderTargetPool();
+
+    /*!
+     * \brief Request an image matching the configuration from the pool
+     *
+     * The content of the image is undefined. Exportable images cannot be requested from the pool.
+     */
+    std::expected<ImageImplPtr, Coral::Image::CreateError> requestImage(const Coral::Image::CreateConfig& config);
+
+private:
+
+    struct MemoryBlock
+    {
+        VmaAllocation allocation{ VK_NULL_HANDLE };
+
+        VkDeviceSize size{ 0 };
+
+        uint32_t memoryTypeIndex{ 0 };
+
+        /// The image bound to the memory block, nullptr if the block is unused
+        ImageImplPtr image;
+
+        /// The configuration the image was created with
+        Coral::Image::CreateConfig config{};
+    };
+
+    /// Get an unused memory block fitting the requirements or allocate a new one
+    MemoryBlock* acquireMemoryBlock(const VkMemoryRequirements& requirements, bool transient);
+
+    ContextImpl& mContext;
+
+    std::list<MemoryBlock> mMemoryBlocks;
+
+    std::mutex mMemoryBlocksProtection;
+
+}; // class RenderTargetPool
+
+} // namespace Coral::Vulkan
+
+#endif // !CORAL_VULKAN_RENDERTARGETPOOL_HPP
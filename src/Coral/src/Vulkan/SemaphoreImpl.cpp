@@ -13,10 +13,20 @@ SemaphoreImpl::~SemaphoreImpl()
 
 
 std::optional<Coral::Semaphore::CreateError>
-SemaphoreImpl::init()
+SemaphoreImpl::init(const Coral::Semaphore::CreateConfig& config)
 {
+    if (config.exportable && !context().isExternalSemaphoreFdSupported())
+    {
+        return Coral::Semaphore::CreateError::INTERNAL_ERROR;
+    }
+
+    mExportable = config.exportable;
+
+    VkExportSemaphoreCreateInfo exportCreateInfo{ VK_STRUCTURE_TYPE_EXPORT_SEMAPHORE_CREATE_INFO };
+    exportCreateInfo.handleTypes = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+
     VkSemaphoreTypeCreateInfo timelineCreateInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
-    timelineCreateInfo.pNext            = NULL;
+    timelineCreateInfo.pNext            = mExportable ? &exportCreateInfo : nullptr;
     timelineCreateInfo.semaphoreType    = VK_SEMAPHORE_TYPE_BINARY;
     timelineCreateInfo.initialValue        = 0;
 
@@ -32,6 +42,56 @@ SemaphoreImpl::init()
 }
 
 
+std::optional<Coral::Semaphore::CreateError>
+SemaphoreImpl::init(int fd)
+{
+    if (!context().isExternalSemaphoreFdSupported())
+    {
+        return Coral::Semaphore::CreateError::INTERNAL_ERROR;
+    }
+
+    if (auto error = init(Coral::Semaphore::CreateConfig{}))
+    {
+        return error;
+    }
+
+    // Permanently import the payload. Vulkan takes ownership of the file descriptor on success.
+    VkImportSemaphoreFdInfoKHR importInfo{ VK_STRUCTURE_TYPE_IMPORT_SEMAPHORE_FD_INFO_KHR };
+    importInfo.semaphore  = mSemaphore;
+    importInfo.handleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+    importInfo.fd         = fd;
+
+    if (vkImportSemaphoreFdKHR(context().getVkDevice(), &importInfo) != VK_SUCCESS)
+    {
+        return Coral::Semaphore::CreateError::INTERNAL_ERROR;
+    }
+
+    return {};
+}
+
+
+std::optional<int>
+SemaphoreImpl::exportFd()
+{
+    if (!mExportable)
+    {
+        return {};
+    }
+
+    VkSemaphoreGetFdInfoKHR getFdInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_GET_FD_INFO_KHR };
+    getFdInfo.semaphore  = mSemaphore;
+    getFdInfo.handleType = VK_EXTERNAL_SEMAPHORE_HANDLE_TYPE_OPAQUE_FD_BIT;
+
+    int fd{ -1 };
+    if (vkGetSemaphoreFdKHR(context().getVkDevice(), &getFdInfo, &fd) != VK_SUCCESS)
+    {
+        return {};
+    }
+
+    return fd;
+}
+
+
 
 VkSemaphore
 SemaphoreImpl::getVkSemaphore()
@@ -22,7 +22,12 @@ public:
 
     virtual ~SemaphoreImpl();
 
-    std::optional<Coral::Semaphore::CreateError> init();
+    std::optional<Coral::Semaphore::CreateError> init(const Coral::Semaphore::CreateConfig& config);
+
+    /// Create the semaphore with the payload imported from an opaque file descriptor (VK_KHR_external_semaphore_fd)
+    std::optional<Coral::Semaphore::CreateError> init(int fd);
+
+    std::optional<int> exportFd() override;
 
     VkSemaphore getVkSemaphore();
 
@@ -32,6 +37,8 @@ private:
 
     VkSemaphore mSemaphore{ VK_NULL_HANDLE };
 
+    bool mExportable{ false };
+
 }; // class SemaphoreImpl
 
 } // namespace Coral::Vulkan
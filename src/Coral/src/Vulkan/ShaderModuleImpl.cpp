@@ -35,6 +35,25 @@ convert(SpvReflectFormat format)
 }
 
 
+bool
+isReadOnly(const SpvReflectDescriptorBinding& binding)
+{
+    if ((binding.decoration_flags | binding.block.decoration_flags) & SPV_REFLECT_DECORATION_NON_WRITABLE)
+    {
+        return true;
+    }
+
+    // `readonly` buffer blocks are decorated per member
+    auto isNonWritable = [](const SpvReflectBlockVariable& member)
+    {
+        return (member.decoration_flags & SPV_REFLECT_DECORATION_NON_WRITABLE) != 0;
+    };
+
+    std::span members{ binding.block.members, binding.block.member_count };
+    return !members.empty() && std::ranges::all_of(members, isNonWritable);
+}
+
+
 void
 insertUniformBlockBindingRecursive(const SpvReflectBlockVariable& variable, const std::string& parentName, Coral::UniformBlockDefinition& result)
 {
@@ -192,6 +211,17 @@ ShaderModuleImpl::reflect(std::span<const std::byte> spirvCode)
         return false;
     }
 
+    if (mShaderStage == CO_SHADER_STAGE_COMPUTE)
+    {
+        auto entryPoint = spvReflectGetEntryPoint(&module, mEntryPoint.c_str());
+        if (entryPoint == nullptr)
+        {
+            return false;
+        }
+
+        mWorkgroupSize = { entryPoint->local_size.x, entryPoint->local_size.y, entryPoint->local_size.z };
+    }
+
     std::vector<SpvReflectDescriptorSet*> sets;
     {
         uint32_t count{ 0 };
@@ -230,6 +260,14 @@ ShaderModuleImpl::reflect(std::span<const std::byte> spirvCode)
                     descriptorBinding.name       = binding->name;
                     descriptorBinding.definition = Coral::CombinedTextureSamplerDefinition{};
                     break;
+                case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                    descriptorBinding.name       = binding->type_description->type_name;
+                    descriptorBinding.definition = Coral::StorageBufferDefinition{ ::isReadOnly(*binding) };
+                    break;
+                case SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                    descriptorBinding.name       = binding->name;
+                    descriptorBinding.definition = Coral::StorageImageDefinition{ ::isReadOnly(*binding) };
+                    break;
                 default:
                     assert(false);
             }
@@ -246,6 +284,12 @@ ShaderModuleImpl::reflect(std::span<const std::byte> spirvCode)
 
     for (auto variable : inputVariables)
     {
+        // Built-in inputs (e.g. gl_VertexIndex or gl_GlobalInvocationID) are not provided through vertex attributes
+        if (variable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN)
+        {
+            continue;
+        }
+
         auto format = convert(variable->format);
         if (!format)
         {
@@ -338,6 +382,13 @@ ShaderModuleImpl::descriptorLayout() const
 }
 
 
+CoExtent3D
+ShaderModuleImpl::workgroupSize() const
+{
+    return mWorkgroupSize;
+}
+
+
 VkShaderModule
 ShaderModuleImpl::getVkShaderModule()
 {
@@ -43,6 +43,8 @@ public:
 
     const DescriptorLayout& descriptorLayout() const override;
 
+    CoExtent3D workgroupSize() const override;
+
     VkShaderModule getVkShaderModule();
 
 private:
@@ -61,6 +63,8 @@ private:
 
     CoShaderStage mShaderStage{ CO_SHADER_STAGE_VERTEX };
 
+    CoExtent3D mWorkgroupSize{ 0, 0, 0 };
+
     VkShaderModule mShaderModule{ VK_NULL_HANDLE };
 
 }; // class ShaderModuleImpl
@@ -142,6 +142,12 @@ SwapchainImpl::initSwapchain(const Coral::Swapchain::CreateConfig& config)
     createInfo.preTransform     = surfaceCapabilites.currentTransform;
     createInfo.compositeAlpha   = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 
+    // Allow reading back swapchain images (e.g. for screenshots or frame capture) if the surface supports it
+    if (surfaceCapabilites.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+    {
+        createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    }
+
     // Create the swapchain
     if (vkCreateSwapchainKHR(context().getVkDevice(), &createInfo, nullptr, &mSwapchain) != VK_SUCCESS)
     {
@@ -232,6 +238,11 @@ SwapchainImpl::initSwapchain(const Coral::Swapchain::CreateConfig& config)
 std::optional<Coral::Swapchain::CreateError>
 SwapchainImpl::init(const Coral::Swapchain::CreateConfig& config)
 {
+    if (context().isHeadless())
+    {
+        return Coral::Swapchain::CreateError::INTERNAL_ERROR;
+    }
+
     mSurface = Coral::Vulkan::createVkSurface(context().getVkInstance(), config.nativeWindowHandle);
 
     if (mSurface == VK_NULL_HANDLE)
@@ -329,15 +340,13 @@ SwapchainImpl::acquireNextSwapchainImage(SemaphorePtr signalSemaphore, Coral::Fe
 
     commandBuffer->begin();
 
-    ImageImpl::cmdTransitionImageLayout(commandBufferImpl->getVkCommandBuffer(),
-                                        *image,
-                                        image->getPreferredImageLayout(),
-                                        /*firstMipLevel*/ 0,
-                                        /*levelCount*/ 1,
-                                        /*srcAccessMask*/ VK_ACCESS_NONE,
-                                        /*dstAccessMask*/ VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                                        /*srcStageFlags*/ VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                                        /*dstStageFlags*/ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    // The image is transitioned from the layout left by the last presentation when the command buffer is submitted
+    commandBufferImpl->useImage(image, 
+                                /*firstMipLevel*/ 0, 
+                                /*levelCount*/ 1, 
+                                image->getPreferredImageLayout(), 
+                                VK_PIPELINE_STAGE_2_NONE, 
+                                VK_ACCESS_2_NONE);
 
     commandBuffer->end();
 
@@ -395,15 +404,7 @@ SwapchainImpl::present(CommandQueueImpl& commandQueue, const std::vector<Semapho
     // presenting the image.
     commandBuffer->begin();
 
-    ImageImpl::cmdTransitionImageLayout(commandBuffer->getVkCommandBuffer(),
-                                        *swapchainImage,
-                                        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-                                        /*firstMipLevel*/ 0,
-                                        /*levelCount*/ 1,
-                                        /*srcAccessMask*/ VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-                                        /*dstAccessMask*/ VK_ACCESS_NONE,
-                                        /*srcStageFlags*/ VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                                        /*dstStageFlags*/ VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    commandBuffer->setFinalImageLayout(swapchainImage, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
 
     commandBuffer->end();
 
@@ -431,7 +432,7 @@ SwapchainImpl::present(CommandQueueImpl& commandQueue, const std::vector<Semapho
     presentInfo.pSwapchains        = &mSwapchain;
     presentInfo.swapchainCount     = 1;
 
-    vkQueuePresentKHR(commandQueue.getVkQueue(), &presentInfo);
+    commandQueue.present(presentInfo);
 }
 
 
@@ -0,0 +1,284 @@
+#include "UploadQueueImpl.hpp"
+
+#include "CommandBufferImpl.hpp"
+#include "CommandQueueImpl.hpp"
+#include "ContextImpl.hpp"
+
+using namespace Coral::Vulkan;
+
+
+std::unique_ptr<UploadQueueImpl>
+UploadQueueImpl::create(ContextImpl& context, CommandQueueImpl& transferQueue)
+{
+    auto queue = std::make_unique<UploadQueueImpl>(context, transferQueue);
+
+    if (!queue->init())
+    {
+        return nullptr;
+    }
+
+    return queue;
+}
+
+
+UploadQueueImpl::UploadQueueImpl(ContextImpl& context, CommandQueueImpl& transferQueue)
+    : mContext(context)
+    , mTransferQueue(transferQueue)
+{
+}
+
+
+UploadQueueImpl::~UploadQueueImpl()
+{
+    auto device = mContext.getVkDevice();
+
+    // Recorded uploads that were never submitted are discarded
+    if (mSemaphore != VK_NULL_HANDLE && mBatchValue > 1)
+    {
+        CoUploadToken value = mBatchValue - 1;
+
+        VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores    = &mSemaphore;
+        waitInfo.pValues        = &value;
+        vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+    }
+
+    // The command buffers are freed to the command pool
+    mBatch.reset();
+    mSubmittedBatches.clear();
+
+    if (mCommandPool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(device, mCommandPool, nullptr);
+    }
+
+    if (mSemaphore != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(device, mSemaphore, nullptr);
+    }
+}
+
+
+bool
+UploadQueueImpl::init()
+{
+    auto device = mContext.getVkDevice();
+
+    VkCommandPoolCreateInfo poolCreateInfo{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolCreateInfo.queueFamilyIndex = mTransferQueue.getQueueFamilyIndex();
+    poolCreateInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    if (vkCreateCommandPool(device, &poolCreateInfo, nullptr, &mCommandPool) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    VkSemaphoreTypeCreateInfo typeCreateInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+    typeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeCreateInfo.initialValue  = 0;
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    semaphoreCreateInfo.pNext = &typeCreateInfo;
+
+    return vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &mSemaphore) == VK_SUCCESS;
+}
+
+
+std::optional<CoUploadToken>
+UploadQueueImpl::updateBufferData(const Coral::UpdateBufferDataInfo& info)
+{
+    std::lock_guard lock(mProtection);
+
+    auto batch = acquireBatch();
+    if (!batch || !batch->cmdUpdateBufferData(info))
+    {
+        return {};
+    }
+
+    auto token = mBatchValue;
+
+    mBatchSize += info.data.size();
+    if (mBatchSize >= MaxBatchSize && !submitBatch())
+    {
+        return {};
+    }
+
+    return token;
+}
+
+
+std::optional<CoUploadToken>
+UploadQueueImpl::updateImageData(const Coral::UpdateImageDataInfo& info)
+{
+    std::lock_guard lock(mProtection);
+
+    auto batch = acquireBatch();
+    if (!batch || !batch->cmdUpdateImageData(info))
+    {
+        return {};
+    }
+
+    auto token = mBatchValue;
+
+    mBatchSize += info.data.size();
+    if (mBatchSize >= MaxBatchSize && !submitBatch())
+    {
+        return {};
+    }
+
+    return token;
+}
+
+
+bool
+UploadQueueImpl::flush()
+{
+    std::lock_guard lock(mProtection);
+    return !mBatch || submitBatch();
+}
+
+
+bool
+UploadQueueImpl::flush(CoUploadToken token)
+{
+    std::lock_guard lock(mProtection);
+
+    // Tokens of previous batches were submitted already
+    if (!mBatch || token < mBatchValue)
+    {
+        return true;
+    }
+
+    return submitBatch();
+}
+
+
+bool
+UploadQueueImpl::isComplete(CoUploadToken token)
+{
+    uint64_t value{ 0 };
+    if (vkGetSemaphoreCounterValue(mContext.getVkDevice(), mSemaphore, &value) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    return value >= token && !isFailed(token);
+}
+
+
+bool
+UploadQueueImpl::isFailed(CoUploadToken token)
+{
+    std::lock_guard lock(mFailedBatchesProtection);
+    return mFailedBatches.contains(token);
+}
+
+
+Coral::UploadQueue::WaitResult
+UploadQueueImpl::wait(CoUploadToken token, uint64_t timeout)
+{
+    if (!flush(token))
+    {
+        return isFailed(token) ? WaitResult::FAILED : WaitResult::INTERNAL_ERROR;
+    }
+
+    VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores    = &mSemaphore;
+    waitInfo.pValues        = &token;
+
+    auto result = vkWaitSemaphores(mContext.getVkDevice(), &waitInfo, timeout);
+    if (result == VK_SUCCESS)
+    {
+        return isFailed(token) ? WaitResult::FAILED : WaitResult::SUCCESS;
+    }
+    else if (result == VK_TIMEOUT)
+    {
+        return WaitResult::TIMEOUT;
+    }
+    return WaitResult::INTERNAL_ERROR;
+}
+
+
+CommandBufferImpl*
+UploadQueueImpl::acquireBatch()
+{
+    if (mBatch)
+    {
+        return mBatch.get();
+    }
+
+    // Reuse the command buffer of the oldest batch if it finished execution
+    if (!mSubmittedBatches.empty() && isComplete(mSubmittedBatches.front().value))
+    {
+        mBatch = std::move(mSubmittedBatches.front().commandBuffer);
+        mSubmittedBatches.pop_front();
+    }
+    else
+    {
+        Coral::CommandBuffer::CreateConfig config{};
+        config.name             = "Coral Upload Queue";
+        config.retainReferences = true;
+
+        auto commandBuffer = std::make_shared<CommandBufferImpl>(mTransferQueue);
+        if (!commandBuffer->init(config, mCommandPool))
+        {
+            return nullptr;
+        }
+
+        mBatch = commandBuffer;
+    }
+
+    if (!mBatch->begin())
+    {
+        mBatch.reset();
+        return nullptr;
+    }
+
+    return mBatch.get();
+}
+
+
+bool
+UploadQueueImpl::submitBatch()
+{
+    auto batch = std::move(mBatch);
+    auto value = mBatchValue++;
+    mBatchSize = 0;
+
+    Coral::CommandBufferSubmitInfo info{};
+    info.commandBuffers = { batch };
+
+    CommandQueueImpl::TimelineSemaphoreValue signal{ mSemaphore, value };
+
+    if (!batch->end() || !mTransferQueue.submit(info, nullptr, signal))
+    {
+        // Record the failure before the token value is signaled, so that the token is never reported as complete
+        {
+            std::lock_guard lock(mFailedBatchesProtection);
+            mFailedBatches.insert(value);
+        }
+
+        // The token value must be signaled anyway, otherwise waiting for the token never returns. Timeline values
+        // must increase, hence the previous batch must be signaled before.
+        auto device   = mContext.getVkDevice();
+        auto previous = value - 1;
+
+        VkSemaphoreWaitInfo waitInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO };
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores    = &mSemaphore;
+        waitInfo.pValues        = &previous;
+        vkWaitSemaphores(device, &waitInfo, UINT64_MAX);
+
+        VkSemaphoreSignalInfo signalInfo{ VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO };
+        signalInfo.semaphore = mSemaphore;
+        signalInfo.value     = value;
+        vkSignalSemaphore(device, &signalInfo);
+        return false;
+    }
+
+    mSubmittedBatches.push_back({ value, std::move(batch) });
+
+    return true;
+}
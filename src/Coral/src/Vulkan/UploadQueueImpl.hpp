@@ -0,0 +1,108 @@
+#ifndef CORAL_VULKAN_UPLOADQUEUEIMPL_HPP
+#define CORAL_VULKAN_UPLOADQUEUEIMPL_HPP
+
+#include "UploadQueue.hpp"
+
+#include "Fwd.hpp"
+#include "Vulkan.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace Coral::Vulkan
+{
+
+/*!
+ * Implementation of the UploadQueue interface using the Vulkan backend
+ *
+ * Uploads of all threads are recorded into a single command buffer of the transfer queue (the batch). Each batch is
+ * identified by a value of a timeline semaphore, which is signaled once the batch finished execution. Hence, the upload
+ * tokens are the values of their batches and waiting for a token waits for all previous batches as well.
+ *
+ * The command buffers are allocated from a command pool owned by the upload queue, since recording from different
+ * threads would otherwise violate the external synchronization of the per-thread pools of the transfer queue.
+ */
+class UploadQueueImpl : public Coral::UploadQueue
+{
+public:
+
+    /// Maximum number of bytes staged by a batch before it is submitted automatically
+    static constexpr size_t MaxBatchSize = 32 * 1024 * 1024;
+
+    static std::unique_ptr<UploadQueueImpl> create(ContextImpl& context, CommandQueueImpl& transferQueue);
+
+    UploadQueueImpl(ContextImpl& context, CommandQueueImpl& transferQueue);
+
+    ~UploadQueueImpl();
+
+    std::optional<CoUploadToken> updateBufferData(const Coral::UpdateBufferDataInfo& info) override;
+
+    std::optional<CoUploadToken> updateImageData(const Coral::UpdateImageDataInfo& info) override;
+
+    bool flush() override;
+
+    bool isComplete(CoUploadToken token) override;
+
+    bool isFailed(CoUploadToken token) override;
+
+    WaitResult wait(CoUploadToken token, uint64_t timeout) override;
+
+    /// Submit the batch of the token if it was not submitted yet
+    bool flush(CoUploadToken token);
+
+    /// Get the timeline semaphore signaled with the token values of the finished batches
+    VkSemaphore getVkSemaphore() { return mSemaphore; }
+
+private:
+
+    bool init();
+
+    /// Get the command buffer of the current batch and begin it if no upload was recorded to the batch yet
+    CommandBufferImpl* acquireBatch();
+
+    /// Submit the current batch. Must be called with the lock held.
+    bool submitBatch();
+
+    ContextImpl& mContext;
+
+    CommandQueueImpl& mTransferQueue;
+
+    VkCommandPool mCommandPool{ VK_NULL_HANDLE };
+
+    VkSemaphore mSemaphore{ VK_NULL_HANDLE };
+
+    /// The command buffer recording the current batch, nullptr if no upload was recorded since the last submission
+    std::shared_ptr<CommandBufferImpl> mBatch;
+
+    /// The token value of the current batch
+    CoUploadToken mBatchValue{ 1 };
+
+    /// Number of bytes staged by the current batch
+    size_t mBatchSize{ 0 };
+
+    struct SubmittedBatch
+    {
+        CoUploadToken value{ 0 };
+
+        std::shared_ptr<CommandBufferImpl> commandBuffer;
+    };
+
+    /// Submitted batches in submission order. Their command buffers are reused once the batch finished execution.
+    std::deque<SubmittedBatch> mSubmittedBatches;
+
+    std::mutex mProtection;
+
+    /// Token values of the batches that failed to be submitted. Their semaphore values are signaled nevertheless.
+    std::unordered_set<CoUploadToken> mFailedBatches;
+
+    /// Protects mFailedBatches, which is queried without holding mProtection
+    mutable std::mutex mFailedBatchesProtection;
+
+}; // class UploadQueueImpl
+
+} // namespace Coral::Vulkan
+
+#endif // !CORAL_VULKAN_UPLOADQUEUEIMPL_HPP
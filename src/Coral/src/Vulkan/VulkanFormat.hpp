@@ -4,7 +4,10 @@
 #include "Vulkan.hpp"
 
 #include <Coral/Buffer.h>
+#include <Coral/CommandBuffer.h>
 
+#include <algorithm>
+#include <optional>
 #include <utility>
 
 namespace Coral::Vulkan
@@ -63,6 +66,27 @@ convert(CoPixelFormat format)
         case CO_PIXEL_FORMAT_RGB8_SRGB:        return VK_FORMAT_R8G8B8_SRGB;
         case CO_PIXEL_FORMAT_RG8_SRGB:         return VK_FORMAT_R8G8_SRGB;
         case CO_PIXEL_FORMAT_R8_SRGB:          return VK_FORMAT_R8_SRGB;
+
+        case CO_PIXEL_FORMAT_BC1_RGBA_UNORM:   return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_BC1_RGBA_SRGB:    return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case CO_PIXEL_FORMAT_BC3_UNORM:        return VK_FORMAT_BC3_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_BC3_SRGB:         return VK_FORMAT_BC3_SRGB_BLOCK;
+        case CO_PIXEL_FORMAT_BC4_UNORM:        return VK_FORMAT_BC4_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_BC4_SNORM:        return VK_FORMAT_BC4_SNORM_BLOCK;
+        case CO_PIXEL_FORMAT_BC5_UNORM:        return VK_FORMAT_BC5_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_BC5_SNORM:        return VK_FORMAT_BC5_SNORM_BLOCK;
+        case CO_PIXEL_FORMAT_BC7_UNORM:        return VK_FORMAT_BC7_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_BC7_SRGB:         return VK_FORMAT_BC7_SRGB_BLOCK;
+
+        case CO_PIXEL_FORMAT_ETC2_RGB8_UNORM:  return VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_ETC2_RGB8_SRGB:   return VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK;
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM: return VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB:  return VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK;
+
+        case CO_PIXEL_FORMAT_ASTC_4x4_UNORM:   return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_ASTC_4x4_SRGB:    return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+        case CO_PIXEL_FORMAT_ASTC_8x8_UNORM:   return VK_FORMAT_ASTC_8x8_UNORM_BLOCK;
+        case CO_PIXEL_FORMAT_ASTC_8x8_SRGB:    return VK_FORMAT_ASTC_8x8_SRGB_BLOCK;
     }
 
     std::unreachable();
@@ -123,6 +147,27 @@ convert(VkFormat format)
         case VK_FORMAT_R8G8_SRGB:           return CO_PIXEL_FORMAT_RG8_SRGB;
         case VK_FORMAT_R8_SRGB:             return CO_PIXEL_FORMAT_R8_SRGB;
 
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:      return CO_PIXEL_FORMAT_BC1_RGBA_UNORM;
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:       return CO_PIXEL_FORMAT_BC1_RGBA_SRGB;
+        case VK_FORMAT_BC3_UNORM_BLOCK:           return CO_PIXEL_FORMAT_BC3_UNORM;
+        case VK_FORMAT_BC3_SRGB_BLOCK:            return CO_PIXEL_FORMAT_BC3_SRGB;
+        case VK_FORMAT_BC4_UNORM_BLOCK:           return CO_PIXEL_FORMAT_BC4_UNORM;
+        case VK_FORMAT_BC4_SNORM_BLOCK:           return CO_PIXEL_FORMAT_BC4_SNORM;
+        case VK_FORMAT_BC5_UNORM_BLOCK:           return CO_PIXEL_FORMAT_BC5_UNORM;
+        case VK_FORMAT_BC5_SNORM_BLOCK:           return CO_PIXEL_FORMAT_BC5_SNORM;
+        case VK_FORMAT_BC7_UNORM_BLOCK:           return CO_PIXEL_FORMAT_BC7_UNORM;
+        case VK_FORMAT_BC7_SRGB_BLOCK:            return CO_PIXEL_FORMAT_BC7_SRGB;
+
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:   return CO_PIXEL_FORMAT_ETC2_RGB8_UNORM;
+        case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:    return CO_PIXEL_FORMAT_ETC2_RGB8_SRGB;
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK: return CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM;
+        case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:  return CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB;
+
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:      return CO_PIXEL_FORMAT_ASTC_4x4_UNORM;
+        case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:       return CO_PIXEL_FORMAT_ASTC_4x4_SRGB;
+        case VK_FORMAT_ASTC_8x8_UNORM_BLOCK:      return CO_PIXEL_FORMAT_ASTC_8x8_UNORM;
+        case VK_FORMAT_ASTC_8x8_SRGB_BLOCK:       return CO_PIXEL_FORMAT_ASTC_8x8_SRGB;
+
         default:
             std::unreachable();
     }
@@ -157,22 +202,124 @@ isStencilFormat(CoPixelFormat format)
 }
 
 
+/// Get the format interpreting the texel blocks of the format with the opposite color encoding (sRGB <-> linear)
+inline std::optional<CoPixelFormat>
+getColorEncodingCounterpart(CoPixelFormat format)
+{
+    switch (format)
+    {
+        case CO_PIXEL_FORMAT_R8_SRGB:          return CO_PIXEL_FORMAT_R8_UI;
+        case CO_PIXEL_FORMAT_RG8_SRGB:         return CO_PIXEL_FORMAT_RG8_UI;
+        case CO_PIXEL_FORMAT_RGB8_SRGB:        return CO_PIXEL_FORMAT_RGB8_UI;
+        case CO_PIXEL_FORMAT_RGBA8_SRGB:       return CO_PIXEL_FORMAT_RGBA8_UI;
+        case CO_PIXEL_FORMAT_R8_UI:            return CO_PIXEL_FORMAT_R8_SRGB;
+        case CO_PIXEL_FORMAT_RG8_UI:           return CO_PIXEL_FORMAT_RG8_SRGB;
+        case CO_PIXEL_FORMAT_RGB8_UI:          return CO_PIXEL_FORMAT_RGB8_SRGB;
+        case CO_PIXEL_FORMAT_RGBA8_UI:         return CO_PIXEL_FORMAT_RGBA8_SRGB;
+        case CO_PIXEL_FORMAT_BC1_RGBA_UNORM:   return CO_PIXEL_FORMAT_BC1_RGBA_SRGB;
+        case CO_PIXEL_FORMAT_BC1_RGBA_SRGB:    return CO_PIXEL_FORMAT_BC1_RGBA_UNORM;
+        case CO_PIXEL_FORMAT_BC3_UNORM:        return CO_PIXEL_FORMAT_BC3_SRGB;
+        case CO_PIXEL_FORMAT_BC3_SRGB:         return CO_PIXEL_FORMAT_BC3_UNORM;
+        case CO_PIXEL_FORMAT_BC7_UNORM:        return CO_PIXEL_FORMAT_BC7_SRGB;
+        case CO_PIXEL_FORMAT_BC7_SRGB:         return CO_PIXEL_FORMAT_BC7_UNORM;
+        case CO_PIXEL_FORMAT_ETC2_RGB8_UNORM:  return CO_PIXEL_FORMAT_ETC2_RGB8_SRGB;
+        case CO_PIXEL_FORMAT_ETC2_RGB8_SRGB:   return CO_PIXEL_FORMAT_ETC2_RGB8_UNORM;
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM: return CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB;
+        case CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB:  return CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM;
+        case CO_PIXEL_FORMAT_ASTC_4x4_UNORM:   return CO_PIXEL_FORMAT_ASTC_4x4_SRGB;
+        case CO_PIXEL_FORMAT_ASTC_4x4_SRGB:    return CO_PIXEL_FORMAT_ASTC_4x4_UNORM;
+        case CO_PIXEL_FORMAT_ASTC_8x8_UNORM:   return CO_PIXEL_FORMAT_ASTC_8x8_SRGB;
+        case CO_PIXEL_FORMAT_ASTC_8x8_SRGB:    return CO_PIXEL_FORMAT_ASTC_8x8_UNORM;
+        default:                               return {};
+    }
+}
+
+
+/// Get the sample count flag for a number of samples per texel. Zero is treated as one.
+inline VkSampleCountFlagBits
+getSampleCountFlag(uint32_t sampleCount)
+{
+    // The flag bits are defined as the sample count they represent
+    return static_cast<VkSampleCountFlagBits>(std::max(sampleCount, 1u));
+}
+
+
 inline VkBufferUsageFlags
-convert(CoBufferType bufferType)
+convert(CoBufferTypeFlags bufferType)
 {
-    switch (bufferType)
+    // Every buffer can be used as source and destination of copy operations
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    if (bufferType & CO_BUFFER_TYPE_VERTEX)
+    {
+        usage |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    }
+    if (bufferType & CO_BUFFER_TYPE_INDEX)
+    {
+        usage |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    }
+    if (bufferType & CO_BUFFER_TYPE_UNIFORM)
+    {
+        usage |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    }
+    if (bufferType & CO_BUFFER_TYPE_STORAGE)
+    {
+        usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
+    if (bufferType & CO_BUFFER_TYPE_INDIRECT)
+    {
+        usage |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    }
+
+    return usage;
+}
+
+
+inline VkPipelineStageFlags
+convert(CoPipelineStageFlags stages)
+{
+    if (stages & CO_PIPELINE_STAGE_ALL_COMMANDS)
+    {
+        return VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+
+    VkPipelineStageFlags flags = 0;
+
+    if (stages & CO_PIPELINE_STAGE_DRAW_INDIRECT)
+    {
+        flags |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    }
+    if (stages & CO_PIPELINE_STAGE_VERTEX_INPUT)
+    {
+        flags |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    }
+    if (stages & CO_PIPELINE_STAGE_VERTEX_SHADER)
+    {
+        flags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+    }
+    if (stages & CO_PIPELINE_STAGE_FRAGMENT_SHADER)
+    {
+        flags |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    }
+    if (stages & CO_PIPELINE_STAGE_DEPTH_STENCIL_ATTACHMENT)
+    {
+        flags |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    }
+    if (stages & CO_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT)
+    {
+        flags |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+    if (stages & CO_PIPELINE_STAGE_COMPUTE_SHADER)
+    {
+        flags |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    }
+    if (stages & CO_PIPELINE_STAGE_TRANSFER)
     {
-        case CO_BUFFER_TYPE_INDEX:
-            return VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        case CO_BUFFER_TYPE_VERTEX:
-            return VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        case CO_BUFFER_TYPE_STORAGE:
-            return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        case CO_BUFFER_TYPE_UNIFORM:
-            return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        flags |= VK_PIPELINE_STAGE_TRANSFER_BIT;
     }
 
-    std::unreachable();    
+    // Waiting with no stage would not wait at all
+    return flags != 0 ? flags : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
 }
 
 } // namespace Coral::Vulkan
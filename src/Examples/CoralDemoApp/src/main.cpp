@@ -260,7 +260,7 @@ template<> CoAttributeFormat toAttributeFormat<uint16_t>()  { return CO_ATTRIBUT
 
 template<typename T, size_t S>
 std::shared_ptr<CoBuffer_T>
-createBuffer(CoContext context, const std::array<T, S>& elements,CoBufferType type)
+createBuffer(CoContext context, const std::array<T, S>& elements, CoBufferTypeFlags type)
 {
     CoBufferCreateConfig bufferConfig{};
     bufferConfig.size       = elements.size() * sizeof(T);
@@ -0,0 +1,140 @@
+#ifndef CORAL_UTIL_KTX2TEXTURE_HPP
+#define CORAL_UTIL_KTX2TEXTURE_HPP
+
+#include <Coral/Coral.h>
+#include <Coral/Util/RAII.hpp>
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace Coral
+{
+
+/// Texture stored in the KTX2 container format
+/**
+ * The texture data is not decoded when the texture is loaded. Instead, the file is memory-mapped and each mip level is
+ * written straight from the mapping into a CPU-visible staging buffer when the upload is recorded. Zstd
+ * supercompressed levels are decompressed directly into the staging buffer. This way, loading a texture reads the
+ * file once and requires no intermediate pixel buffers.
+ *
+ * Only 2D textures with a single layer and face are supported. BasisLZ and ZLIB supercompression are not supported.
+ */
+class Ktx2Texture
+{
+public:
+
+    enum class LoadError
+    {
+        /// The file could not be opened or mapped
+        IO_ERROR,
+        /// The data is not a valid KTX2 texture
+        INVALID_DATA,
+        /// The vkFormat of the texture has no matching CoPixelFormat
+        UNSUPPORTED_FORMAT,
+        /// The texture uses a supercompression scheme other than Zstd
+        UNSUPPORTED_SUPERCOMPRESSION,
+        /// The texture is an array, a cube map or a 3D texture
+        UNSUPPORTED_TEXTURE_TYPE,
+    };
+
+    /// Load a KTX2 texture from a file
+    /**
+     * The file stays memory-mapped for the lifetime of the texture object.
+     */
+    static std::expected<Ktx2Texture, LoadError> load(const std::filesystem::path& path);
+
+    /// Load a KTX2 texture from memory
+    /**
+     * The data is not copied and must outlive the texture object.
+     */
+    static std::expected<Ktx2Texture, LoadError> load(std::span<const CoByte> data);
+
+    Ktx2Texture(Ktx2Texture&& other) noexcept;
+
+    Ktx2Texture& operator=(Ktx2Texture&& other) noexcept;
+
+    ~Ktx2Texture();
+
+    /// Get the pixel format of the texture
+    CoPixelFormat format() const { return mFormat; }
+
+    /// Get the size of the first mip level in pixels
+    CoExtent extent() const { return mExtent; }
+
+    /// Get the number of mip levels stored in the texture
+    uint32_t mipLevelCount() const { return static_cast<uint32_t>(mLevels.size()); }
+
+    /// Get a CoImageCreateConfig to create an image matching the texture
+    /**
+     * If the texture stores more than one mip level, the image is created with a full mip chain. Levels missing in
+     * the texture are not initialized by \ref cmdUpload.
+     */
+    CoImageCreateConfig imageCreateConfig() const;
+
+    /// Get the number of staging bytes required to upload the first \p levelCount mip levels
+    uint64_t stagingSize(uint32_t levelCount) const;
+
+    /// Write the first \p levelCount mip levels into the staging memory
+    /**
+     * The levels are placed at the buffer offsets of the regions returned by \ref copyRegions. Supercompressed levels
+     * are decompressed in place. Fails if the staging memory is smaller than \ref stagingSize or a level cannot be
+     * decompressed.
+     */
+    bool writeLevels(std::span<CoByte> staging, uint32_t levelCount) const;
+
+    /// Get the buffer to image copy regions of the first \p levelCount mip levels as written by \ref writeLevels
+    std::vector<CoBufferImageCopyRegion> copyRegions(uint32_t levelCount) const;
+
+    /// Record the upload of all mip levels into the image
+    /**
+     * A staging buffer is allocated, the levels are written into the mapped staging memory and a single buffer to
+     * image copy is recorded for all levels. If the image has fewer mip levels than the texture, the remaining levels
+     * are skipped.
+     *
+     * The returned staging buffer must be kept alive until the command buffer finished execution, unless the command
+     * buffer was created with \ref CoCommandBufferCreateConfig::retainReferences.
+     */
+    std::expected<BufferPtr, CoResult> cmdUpload(CoContext context, CoCommandBuffer commandBuffer, CoImage image) const;
+
+private:
+
+    struct Level
+    {
+        /// Offset of the level data in the file
+        uint64_t byteOffset;
+        /// Size of the (supercompressed) level data in the file
+        uint64_t byteLength;
+        /// Size of the level after decompression
+        uint64_t uncompressedByteLength;
+    };
+
+    class MappedFile;
+
+    Ktx2Texture() = default;
+
+    static std::expected<Ktx2Texture, LoadError> parse(std::span<const CoByte> data);
+
+    /// Get the offset of the level in the staging memory
+    uint64_t stagingOffset(uint32_t level) const;
+
+    std::unique_ptr<MappedFile> mFile;
+
+    std::span<const CoByte> mData;
+
+    CoPixelFormat mFormat{ CO_PIXEL_FORMAT_RGBA8_UI };
+
+    CoExtent mExtent{};
+
+    bool mZstdSupercompressed{ false };
+
+    std::vector<Level> mLevels;
+
+}; // class Ktx2Texture
+
+} // namespace Coral
+
+#endif // !CORAL_UTIL_KTX2TEXTURE_HPP
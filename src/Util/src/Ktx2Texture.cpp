@@ -0,0 +1,515 @@
+#include <Coral/Util/Ktx2Texture.hpp>
+
+#include <zstd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <numeric>
+#include <optional>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Coral;
+
+namespace
+{
+
+constexpr std::array<CoByte, 12> KTX2_IDENTIFIER = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+// Size of the identifier, the header and the index preceding the level index
+constexpr size_t KTX2_LEVEL_INDEX_OFFSET = 80;
+
+constexpr size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+
+constexpr uint32_t KTX2_SUPERCOMPRESSION_NONE = 0;
+
+constexpr uint32_t KTX2_SUPERCOMPRESSION_ZSTD = 2;
+
+
+template<typename T>
+T
+read(std::span<const CoByte> data, size_t offset)
+{
+    // KTX2 files are little-endian
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+
+std::optional<CoPixelFormat>
+convertVkFormat(uint32_t vkFormat)
+{
+    // The values correspond to the VkFormat enum. The mapping mirrors the conversion of the Vulkan backend.
+    switch (vkFormat)
+    {
+        case 9:   return CO_PIXEL_FORMAT_R8_UI;
+        case 10:  return CO_PIXEL_FORMAT_R8_I;
+        case 15:  return CO_PIXEL_FORMAT_R8_SRGB;
+        case 16:  return CO_PIXEL_FORMAT_RG8_UI;
+        case 17:  return CO_PIXEL_FORMAT_RG8_I;
+        case 22:  return CO_PIXEL_FORMAT_RG8_SRGB;
+        case 23:  return CO_PIXEL_FORMAT_RGB8_UI;
+        case 24:  return CO_PIXEL_FORMAT_RGB8_I;
+        case 29:  return CO_PIXEL_FORMAT_RGB8_SRGB;
+        case 37:  return CO_PIXEL_FORMAT_RGBA8_UI;
+        case 38:  return CO_PIXEL_FORMAT_RGBA8_I;
+        case 43:  return CO_PIXEL_FORMAT_RGBA8_SRGB;
+
+        case 70:  return CO_PIXEL_FORMAT_R16_UI;
+        case 71:  return CO_PIXEL_FORMAT_R16_I;
+        case 76:  return CO_PIXEL_FORMAT_R16_F;
+        case 77:  return CO_PIXEL_FORMAT_RG16_UI;
+        case 78:  return CO_PIXEL_FORMAT_RG16_I;
+        case 83:  return CO_PIXEL_FORMAT_RG16_F;
+        case 84:  return CO_PIXEL_FORMAT_RGB16_UI;
+        case 85:  return CO_PIXEL_FORMAT_RGB16_I;
+        case 90:  return CO_PIXEL_FORMAT_RGB16_F;
+        case 91:  return CO_PIXEL_FORMAT_RGBA16_UI;
+        case 92:  return CO_PIXEL_FORMAT_RGBA16_I;
+        case 97:  return CO_PIXEL_FORMAT_RGBA16_F;
+
+        case 98:  return CO_PIXEL_FORMAT_R32_UI;
+        case 99:  return CO_PIXEL_FORMAT_R32_I;
+        case 100: return CO_PIXEL_FORMAT_R32_F;
+        case 101: return CO_PIXEL_FORMAT_RG32_UI;
+        case 102: return CO_PIXEL_FORMAT_RG32_I;
+        case 103: return CO_PIXEL_FORMAT_RG32_F;
+        case 104: return CO_PIXEL_FORMAT_RGB32_UI;
+        case 105: return CO_PIXEL_FORMAT_RGB32_I;
+        case 106: return CO_PIXEL_FORMAT_RGB32_F;
+        case 107: return CO_PIXEL_FORMAT_RGBA32_UI;
+        case 108: return CO_PIXEL_FORMAT_RGBA32_I;
+        case 109: return CO_PIXEL_FORMAT_RGBA32_F;
+
+        case 124: return CO_PIXEL_FORMAT_DEPTH16;
+        case 126: return CO_PIXEL_FORMAT_DEPTH32_F;
+        case 129: return CO_PIXEL_FORMAT_DEPTH24_STENCIL8;
+
+        case 133: return CO_PIXEL_FORMAT_BC1_RGBA_UNORM;
+        case 134: return CO_PIXEL_FORMAT_BC1_RGBA_SRGB;
+        case 137: return CO_PIXEL_FORMAT_BC3_UNORM;
+        case 138: return CO_PIXEL_FORMAT_BC3_SRGB;
+        case 139: return CO_PIXEL_FORMAT_BC4_UNORM;
+        case 140: return CO_PIXEL_FORMAT_BC4_SNORM;
+        case 141: return CO_PIXEL_FORMAT_BC5_UNORM;
+        case 142: return CO_PIXEL_FORMAT_BC5_SNORM;
+        case 145: return CO_PIXEL_FORMAT_BC7_UNORM;
+        case 146: return CO_PIXEL_FORMAT_BC7_SRGB;
+
+        case 147: return CO_PIXEL_FORMAT_ETC2_RGB8_UNORM;
+        case 148: return CO_PIXEL_FORMAT_ETC2_RGB8_SRGB;
+        case 151: return CO_PIXEL_FORMAT_ETC2_RGBA8_UNORM;
+        case 152: return CO_PIXEL_FORMAT_ETC2_RGBA8_SRGB;
+
+        case 157: return CO_PIXEL_FORMAT_ASTC_4x4_UNORM;
+        case 158: return CO_PIXEL_FORMAT_ASTC_4x4_SRGB;
+        case 171: return CO_PIXEL_FORMAT_ASTC_8x8_UNORM;
+        case 172: return CO_PIXEL_FORMAT_ASTC_8x8_SRGB;
+
+        default:  return std::nullopt;
+    }
+}
+
+
+CoExtent
+mipExtent(CoExtent extent, uint32_t level)
+{
+    return { std::max(1u, extent.width >> level), std::max(1u, extent.height >> level) };
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MappedFile
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Read-only memory mapping of a file
+class Ktx2Texture::MappedFile
+{
+public:
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (mView)
+        {
+            UnmapViewOfFile(mView);
+        }
+        if (mMapping)
+        {
+            CloseHandle(mMapping);
+        }
+        if (mFile != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(mFile);
+        }
+#else
+        if (mView)
+        {
+            munmap(mView, mSize);
+        }
+#endif
+    }
+
+    bool map(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        mFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (mFile == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0)
+        {
+            return false;
+        }
+
+        mMapping = CreateFileMappingW(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mMapping)
+        {
+            return false;
+        }
+
+        mView = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+        mSize = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat status{};
+        if (fstat(fd, &status) != 0 || status.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        mSize = static_cast<size_t>(status.st_size);
+        mView = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // The mapping keeps a reference to the file
+        close(fd);
+
+        if (mView == MAP_FAILED)
+        {
+            mView = nullptr;
+            return false;
+        }
+
+        // The levels are read once from front to back
+        madvise(mView, mSize, MADV_SEQUENTIAL);
+#endif
+        return mView != nullptr;
+    }
+
+    std::span<const CoByte> data() const
+    {
+        return { static_cast<const CoByte*>(mView), mSize };
+    }
+
+private:
+
+#ifdef _WIN32
+    HANDLE mFile{ INVALID_HANDLE_VALUE };
+
+    HANDLE mMapping{ nullptr };
+#endif
+
+    void* mView{ nullptr };
+
+    size_t mSize{ 0 };
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Ktx2Texture
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Ktx2Texture::Ktx2Texture(Ktx2Texture&& other) noexcept = default;
+
+
+Ktx2Texture&
+Ktx2Texture::operator=(Ktx2Texture&& other) noexcept = default;
+
+
+Ktx2Texture::~Ktx2Texture() = default;
+
+
+std::expected<Ktx2Texture, Ktx2Texture::LoadError>
+Ktx2Texture::load(const std::filesystem::path& path)
+{
+    auto file = std::make_unique<MappedFile>();
+    if (!file->map(path))
+    {
+        return std::unexpected(LoadError::IO_ERROR);
+    }
+
+    auto texture = parse(file->data());
+    if (texture)
+    {
+        texture->mFile = std::move(file);
+    }
+
+    return texture;
+}
+
+
+std::expected<Ktx2Texture, Ktx2Texture::LoadError>
+Ktx2Texture::load(std::span<const CoByte> data)
+{
+    return parse(data);
+}
+
+
+std::expected<Ktx2Texture, Ktx2Texture::LoadError>
+Ktx2Texture::parse(std::span<const CoByte> data)
+{
+    if (data.size() < KTX2_LEVEL_INDEX_OFFSET ||
+        !std::equal(KTX2_IDENTIFIER.begin(), KTX2_IDENTIFIER.end(), data.begin()))
+    {
+        return std::unexpected(LoadError::INVALID_DATA);
+    }
+
+    auto vkFormat               = read<uint32_t>(data, 12);
+    auto pixelWidth             = read<uint32_t>(data, 20);
+    auto pixelHeight            = read<uint32_t>(data, 24);
+    auto pixelDepth             = read<uint32_t>(data, 28);
+    auto layerCount             = read<uint32_t>(data, 32);
+    auto faceCount              = read<uint32_t>(data, 36);
+    auto levelCount             = read<uint32_t>(data, 40);
+    auto supercompressionScheme = read<uint32_t>(data, 44);
+
+    if (pixelWidth == 0 || faceCount == 0)
+    {
+        return std::unexpected(LoadError::INVALID_DATA);
+    }
+
+    if (pixelDepth > 0 || layerCount > 1 || faceCount > 1)
+    {
+        return std::unexpected(LoadError::UNSUPPORTED_TEXTURE_TYPE);
+    }
+
+    if (supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE &&
+        supercompressionScheme != KTX2_SUPERCOMPRESSION_ZSTD)
+    {
+        return std::unexpected(LoadError::UNSUPPORTED_SUPERCOMPRESSION);
+    }
+
+    auto format = convertVkFormat(vkFormat);
+    if (!format)
+    {
+        return std::unexpected(LoadError::UNSUPPORTED_FORMAT);
+    }
+
+    // A level count of zero indicates that only the first level is stored. The levels must not exceed the full mip
+    // chain of the texture.
+    levelCount = std::max(levelCount, 1u);
+    if (levelCount > static_cast<uint32_t>(std::bit_width(std::max(pixelWidth, pixelHeight))))
+    {
+        return std::unexpected(LoadError::INVALID_DATA);
+    }
+
+    if (data.size() < KTX2_LEVEL_INDEX_OFFSET + levelCount * KTX2_LEVEL_INDEX_ENTRY_SIZE)
+    {
+        return std::unexpected(LoadError::INVALID_DATA);
+    }
+
+    Ktx2Texture texture;
+    texture.mData                = data;
+    texture.mFormat              = *format;
+    texture.mExtent              = { pixelWidth, std::max(pixelHeight, 1u) };
+    texture.mZstdSupercompressed = supercompressionScheme == KTX2_SUPERCOMPRESSION_ZSTD;
+
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        auto offset = KTX2_LEVEL_INDEX_OFFSET + i * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+
+        Level level{};
+        level.byteOffset             = read<uint64_t>(data, offset);
+        level.byteLength             = read<uint64_t>(data, offset + 8);
+        level.uncompressedByteLength = read<uint64_t>(data, offset + 16);
+
+        auto extent = mipExtent(texture.mExtent, i);
+        auto size   = coPixelFormatGetRegionSizeInBytes(texture.mFormat, extent.width, extent.height);
+
+        if (level.byteOffset > data.size() ||
+            level.byteLength > data.size() - level.byteOffset ||
+            level.uncompressedByteLength != size ||
+            (!texture.mZstdSupercompressed && level.byteLength != size))
+        {
+            return std::unexpected(LoadError::INVALID_DATA);
+        }
+
+        texture.mLevels.push_back(level);
+    }
+
+    return texture;
+}
+
+
+CoImageCreateConfig
+Ktx2Texture::imageCreateConfig() const
+{
+    CoImageCreateConfig config{};
+    config.extent     = mExtent;
+    config.format     = mFormat;
+    config.hasMipMaps = mLevels.size() > 1;
+    config.usageHint  = CO_IMAGE_USAGE_HINT_SHADER_READ_ONLY;
+
+    return config;
+}
+
+
+uint64_t
+Ktx2Texture::stagingOffset(uint32_t level) const
+{
+    // Buffer offsets of copies must be a multiple of the texel block size and of four
+    const uint64_t alignment = std::lcm<uint64_t>(coPixelFormatGetSizeInBytes(mFormat), 4);
+
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < level; ++i)
+    {
+        offset += mLevels[i].uncompressedByteLength;
+        offset  = (offset + alignment - 1) / alignment * alignment;
+    }
+
+    return offset;
+}
+
+
+uint64_t
+Ktx2Texture::stagingSize(uint32_t levelCount) const
+{
+    levelCount = std::min(levelCount, mipLevelCount());
+    if (levelCount == 0)
+    {
+        return 0;
+    }
+
+    return stagingOffset(levelCount - 1) + mLevels[levelCount - 1].uncompressedByteLength;
+}
+
+
+bool
+Ktx2Texture::writeLevels(std::span<CoByte> staging, uint32_t levelCount) const
+{
+    levelCount = std::min(levelCount, mipLevelCount());
+    if (staging.size() < stagingSize(levelCount))
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        const auto& level = mLevels[i];
+        auto source       = mData.data() + level.byteOffset;
+        auto dest         = staging.data() + stagingOffset(i);
+
+        if (mZstdSupercompressed)
+        {
+            auto size = ZSTD_decompress(dest, level.uncompressedByteLength, source, level.byteLength);
+            if (ZSTD_isError(size) || size != level.uncompressedByteLength)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            std::memcpy(dest, source, level.byteLength);
+        }
+    }
+
+    return true;
+}
+
+
+std::vector<CoBufferImageCopyRegion>
+Ktx2Texture::copyRegions(uint32_t levelCount) const
+{
+    levelCount = std::min(levelCount, mipLevelCount());
+
+    std::vector<CoBufferImageCopyRegion> regions(levelCount);
+    for (uint32_t i = 0; i < levelCount; ++i)
+    {
+        auto extent = mipExtent(mExtent, i);
+
+        auto& region = regions[i];
+        region.bufferOffset     = stagingOffset(i);
+        region.imageSubresource = { i, 0, 1 };
+        region.imageExtent      = { extent.width, extent.height, 1 };
+    }
+
+    return regions;
+}
+
+
+std::expected<BufferPtr, CoResult>
+Ktx2Texture::cmdUpload(CoContext context, CoCommandBuffer commandBuffer, CoImage image) const
+{
+    CoExtent extent{};
+    coImageGetExtent(image, &extent);
+
+    if (coImageGetPixelFormat(image) != mFormat || extent.width != mExtent.width || extent.height != mExtent.height)
+    {
+        return std::unexpected(CO_FAILED);
+    }
+
+    auto levelCount = std::min(mipLevelCount(), coImageGetMipLevelCount(image));
+
+    CoBufferCreateConfig config{};
+    config.size       = stagingSize(levelCount);
+    config.cpuVisible = true;
+
+    CoBuffer buffer{ nullptr };
+    if (auto result = coContextCreateBuffer(context, &config, &buffer); result != CO_SUCCESS)
+    {
+        return std::unexpected(result);
+    }
+
+    BufferPtr staging(buffer);
+
+    CoByte* mapped{ nullptr };
+    if (coBufferMap(staging.get(), &mapped) != CO_SUCCESS)
+    {
+        return std::unexpected(CO_FAILED);
+    }
+
+    bool written = writeLevels({ mapped, config.size }, levelCount);
+    coBufferUnMap(staging.get());
+
+    if (!written)
+    {
+        return std::unexpected(CO_FAILED);
+    }
+
+    auto regions = copyRegions(levelCount);
+
+    CoCopyBufferToImageInfo info{};
+    info.source      = staging.get();
+    info.dest        = image;
+    info.pRegions    = regions.data();
+    info.regionCount = levelCount;
+
+    if (auto result = coCommandBufferCopyBufferToImage(commandBuffer, &info); result != CO_SUCCESS)
+    {
+        return std::unexpected(result);
+    }
+
+    return staging;
+}